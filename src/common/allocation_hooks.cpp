@@ -0,0 +1,131 @@
+// Replaces the global operator new and delete with versions that count into
+// the per-thread allocation counters. Not part of COMMON_SOURCES: link it in
+// with -DBENCHMARK_ALLOCATION_HOOKS=ON, or list it in a target, to get
+// allocation columns in BenchmarkResult.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include "common/allocation_tracker.h"
+
+namespace {
+    struct HookRegistration {
+        HookRegistration() { benchmark::mark_allocation_hooks_installed(); }
+    } registration;
+
+    void* allocate(std::size_t size, std::size_t alignment) {
+        if (size == 0) {
+            size = 1;
+        }
+        for (;;) {
+            void* pointer = nullptr;
+            if (alignment <= alignof(std::max_align_t)) {
+                pointer = std::malloc(size);
+            } else if (posix_memalign(&pointer, alignment, size) != 0) {
+                pointer = nullptr;
+            }
+            if (pointer) {
+                benchmark::record_allocation(pointer);
+                return pointer;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void* allocate_nothrow(std::size_t size, std::size_t alignment) noexcept {
+        try {
+            return allocate(size, alignment);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    void deallocate(void* pointer) noexcept {
+        benchmark::record_deallocation(pointer);
+        std::free(pointer);
+    }
+}
+
+void* operator new(std::size_t size) {
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate_nothrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate_nothrow(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
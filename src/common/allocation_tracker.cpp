@@ -0,0 +1,62 @@
+#include "common/allocation_tracker.h"
+#include <algorithm>
+#include <malloc.h>
+
+namespace benchmark {
+
+namespace {
+    // Constant-initialized, so the hooks can touch them while a thread is
+    // still starting up or already tearing down
+    thread_local ThreadAllocationCounters counters = {0, 0, 0, 0, 0};
+    bool hooks_installed = false;
+}
+
+ThreadAllocationCounters& thread_allocation_counters() {
+    return counters;
+}
+
+void record_allocation(void* pointer) {
+    uint64_t size = malloc_usable_size(pointer);
+    ++counters.allocations;
+    counters.bytes_allocated += size;
+    counters.live_bytes += size;
+    counters.peak_live_bytes = std::max(counters.peak_live_bytes, counters.live_bytes);
+}
+
+void record_deallocation(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+    uint64_t size = malloc_usable_size(pointer);
+    ++counters.deallocations;
+    // Blocks allocated on another thread are freed here; never underflow
+    counters.live_bytes -= std::min(counters.live_bytes, size);
+}
+
+bool allocation_hooks_installed() {
+    return hooks_installed;
+}
+
+void mark_allocation_hooks_installed() {
+    hooks_installed = true;
+}
+
+AllocationScope::AllocationScope()
+    : start_(counters), outer_peak_(counters.peak_live_bytes) {
+    counters.peak_live_bytes = counters.live_bytes;
+}
+
+AllocationScope::~AllocationScope() {
+    counters.peak_live_bytes = std::max(outer_peak_, counters.peak_live_bytes);
+}
+
+AllocationStats AllocationScope::stats() const {
+    AllocationStats stats;
+    stats.allocations = counters.allocations - start_.allocations;
+    stats.deallocations = counters.deallocations - start_.deallocations;
+    stats.bytes_allocated = counters.bytes_allocated - start_.bytes_allocated;
+    stats.peak_live_bytes = counters.peak_live_bytes - std::min(counters.peak_live_bytes, start_.live_bytes);
+    return stats;
+}
+
+} // namespace benchmark
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace benchmark {
+
+/**
+ * Heap activity over an AllocationScope. Bytes are malloc_usable_size of
+ * each block, so allocator rounding is included.
+ */
+struct AllocationStats {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytes_allocated = 0;
+    uint64_t peak_live_bytes = 0;   // Highest live heap above the scope's starting point
+};
+
+// Counters of the calling thread; updated by the hooks and CountingAllocator
+struct ThreadAllocationCounters {
+    uint64_t allocations;
+    uint64_t deallocations;
+    uint64_t bytes_allocated;
+    uint64_t live_bytes;
+    uint64_t peak_live_bytes;
+};
+
+ThreadAllocationCounters& thread_allocation_counters();
+
+void record_allocation(void* pointer);
+void record_deallocation(void* pointer);
+
+// True when allocation_hooks.cpp, which replaces the global operator new and
+// delete, is linked into the binary. Without it only CountingAllocator
+// containers are counted.
+bool allocation_hooks_installed();
+void mark_allocation_hooks_installed();
+
+/**
+ * Counts the calling thread's heap activity from construction until stats().
+ * Scopes nest; an inner scope does not hide its peak from the outer one.
+ */
+class AllocationScope {
+public:
+    AllocationScope();
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    AllocationStats stats() const;
+
+private:
+    ThreadAllocationCounters start_;
+    uint64_t outer_peak_;
+};
+
+/**
+ * std::allocator replacement that counts into the same thread counters,
+ * for measuring a single container without linking the global hooks.
+ * Allocates with malloc, so it is never counted twice when they are linked.
+ */
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        void* pointer = std::malloc(count * sizeof(T));
+        if (!pointer) {
+            throw std::bad_alloc();
+        }
+        record_allocation(pointer);
+        return static_cast<T*>(pointer);
+    }
+
+    void deallocate(T* pointer, size_t) {
+        record_deallocation(pointer);
+        std::free(pointer);
+    }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+} // namespace benchmark
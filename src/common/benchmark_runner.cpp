@@ -2,30 +2,161 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <algorithm>
-#include <numeric>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+#include "common/allocation_tracker.h"
+#include "common/benchmark_timing.h"
+#include "common/cache_info.h"
+#include "common/utilities.h"
 
 namespace benchmark {
 
-BenchmarkRunner::BenchmarkRunner(size_t iterations)
-    : iterations_(iterations) {
+namespace {
+    template<typename T>
+    void require_pool(const std::vector<T>& pool) {
+        if (pool.empty()) {
+            throw std::runtime_error("Rotating benchmark needs a non-empty input pool");
+        }
+    }
+    
+    // Hands out pool entries in order, wrapping around
+    template<typename T>
+    class PoolCursor {
+    public:
+        explicit PoolCursor(const std::vector<T>& pool) : pool_(pool) {}
+        
+        const T& next() {
+            const T& item = pool_[index_];
+            index_ = index_ + 1 == pool_.size() ? 0 : index_ + 1;
+            return item;
+        }
+        
+    private:
+        const std::vector<T>& pool_;
+        size_t index_ = 0;
+    };
+    
+    const double BYTES_PER_MB = 1e6;
+    const size_t MAX_BATCH = size_t(1) << 24;
+    
+    template<typename Func>
+    uint64_t time_batch_ns(Func& operation, size_t batch) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < batch; ++i) {
+            run_and_keep(operation);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+    
+    // Standard error of the mean over the mean, from running sums; 1 until there is a spread to measure
+    double relative_standard_error(size_t count, double sum, double sum_squares) {
+        if (count < 2 || sum <= 0.0) {
+            return 1.0;
+        }
+        double n = static_cast<double>(count);
+        double mean = sum / n;
+        double variance = std::max(0.0, (sum_squares - sum * mean) / (n - 1));
+        return std::sqrt(variance / n) / mean;
+    }
+    
+    std::vector<int> allowed_cpus() {
+        std::vector<int> cpus;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+        return cpus;
+    }
+    
+    // 1, 2, 4 ... below max_threads, then max_threads itself. 0 means one
+    // thread per CPU this process may run on, as that is where workers are pinned.
+    std::vector<size_t> scaling_thread_counts(size_t max_threads) {
+        if (max_threads == 0) {
+            max_threads = allowed_cpus().size();
+        }
+        if (max_threads == 0) {
+            max_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        std::vector<size_t> counts;
+        for (size_t threads = 1; threads < max_threads; threads *= 2) {
+            counts.push_back(threads);
+        }
+        counts.push_back(max_threads);
+        return counts;
+    }
+    
+    // Best effort: a restricted container may refuse, and the run goes on unpinned
+    void pin_current_thread(int cpu) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+    
+    // Operation column of the printed tables: the longest name plus a gap,
+    // and never narrower than the 25 columns the rules were laid out for
+    template<typename Result>
+    size_t operation_width(const std::vector<Result>& results) {
+        size_t width = 25;
+        for (const auto& result : results) {
+            width = std::max(width, result.operation_name.size() + 2);
+        }
+        return width;
+    }
+}
+
+size_t logical_size(const FileMetadata& metadata) {
+    size_t size = metadata.name.size() + metadata.path.size() +
+                  sizeof(metadata.size) + sizeof(metadata.created_at) +
+                  sizeof(metadata.last_modified) + sizeof(metadata.permissions) +
+                  metadata.owner.size() + metadata.group.size();
+    for (const auto& tag : metadata.tags) {
+        size += tag.size();
+    }
+    return size;
+}
+
+size_t logical_size(const FileBlock& block) {
+    return block.block_id.size() + sizeof(block.offset) + block.data.size() + sizeof(block.checksum);
+}
+
+size_t logical_size(const std::vector<FileMetadata>& batch) {
+    size_t size = 0;
+    for (const auto& metadata : batch) {
+        size += logical_size(metadata);
+    }
+    return size;
+}
+
+BenchmarkRunner::BenchmarkRunner(size_t iterations) {
+    options_.samples = iterations;
+}
+
+BenchmarkRunner::BenchmarkRunner(const TimingOptions& options)
+    : options_(options) {
 }
 
 BenchmarkResult BenchmarkRunner::benchmark_metadata_serialization(
     SerializerInterface& serializer,
     const FileMetadata& metadata) {
     
-    // Estimate the data size (this is approximate)
-    size_t data_size = metadata.name.size() + metadata.path.size() +
-                       sizeof(metadata.size) + sizeof(metadata.created_at) +
-                       sizeof(metadata.last_modified) +
-                       std::accumulate(metadata.tags.begin(), metadata.tags.end(), 0,
-                                     [](size_t sum, const std::string& tag) {
-                                         return sum + tag.size();
-                                     }) +
-                       sizeof(metadata.permissions) +
-                       metadata.owner.size() + metadata.group.size();
+    size_t data_size = logical_size(metadata);
     
     // First serialize once to get the serialized size
     std::vector<uint8_t> serialized_data = serializer.serialize_metadata(metadata);
@@ -44,11 +175,14 @@ BenchmarkResult BenchmarkRunner::benchmark_metadata_deserialization(
     SerializerInterface& serializer,
     const std::vector<uint8_t>& serialized_data) {
     
+    // Decode once, untimed, to account the logical bytes produced
+    size_t data_size = logical_size(serializer.deserialize_metadata(serialized_data));
+    
     // Run the benchmark
     return benchmark_operation(
         serializer.format_name(),
         "metadata_deserialization",
-        0,  // Input size is the serialized data
+        data_size,
         serialized_data.size(),
         [&]() { return serializer.deserialize_metadata(serialized_data); }
     );
@@ -58,11 +192,7 @@ BenchmarkResult BenchmarkRunner::benchmark_block_serialization(
     SerializerInterface& serializer,
     const FileBlock& block) {
     
-    // Estimate the data size
-    size_t data_size = block.block_id.size() +
-                       sizeof(block.offset) +
-                       block.data.size() +
-                       sizeof(block.checksum);
+    size_t data_size = logical_size(block);
     
     // First serialize once to get the serialized size
     std::vector<uint8_t> serialized_data = serializer.serialize_block(block);
@@ -81,84 +211,649 @@ BenchmarkResult BenchmarkRunner::benchmark_block_deserialization(
     SerializerInterface& serializer,
     const std::vector<uint8_t>& serialized_data) {
     
+    // Decode once, untimed, to account the logical bytes produced
+    size_t data_size = logical_size(serializer.deserialize_block(serialized_data));
+    
     // Run the benchmark
     return benchmark_operation(
         serializer.format_name(),
         "block_deserialization",
-        0,  // Input size is the serialized data
+        data_size,
         serialized_data.size(),
         [&]() { return serializer.deserialize_block(serialized_data); }
     );
 }
 
+BenchmarkResult BenchmarkRunner::benchmark_block_decode(
+    SerializerInterface& serializer,
+    const std::vector<uint8_t>& serialized_data,
+    const DecodeOptions& options) {
+    
+    size_t data_size = logical_size(serializer.deserialize_block(serialized_data));
+    
+    // Run the benchmark
+    return benchmark_operation(
+        serializer.format_name(),
+        std::string("block_decode_") + verification_mode_name(options.verification),
+        data_size,
+        serialized_data.size(),
+        [&]() {
+            DecodedBlock decoded = serializer.decode_block(serialized_data, options);
+            return decoded.block().data.size();
+        }
+    );
+}
+
+BenchmarkResult BenchmarkRunner::benchmark_metadata_batch_serialization(
+    SerializerInterface& serializer,
+    const std::vector<FileMetadata>& batch) {
+    
+    size_t data_size = logical_size(batch);
+    
+    // First serialize once to get the serialized size
+    std::vector<uint8_t> serialized_data = serializer.serialize_metadata_batch(batch);
+    
+    // Run the benchmark
+    return benchmark_operation(
+        serializer.format_name(),
+        "metadata_batch_serialization",
+        data_size,
+        serialized_data.size(),
+        [&]() { return serializer.serialize_metadata_batch(batch); },
+        batch.size()
+    );
+}
+
+BenchmarkResult BenchmarkRunner::benchmark_metadata_batch_deserialization(
+    SerializerInterface& serializer,
+    const std::vector<uint8_t>& serialized_data) {
+    
+    std::vector<FileMetadata> decoded = serializer.deserialize_metadata_batch(serialized_data);
+    
+    // Run the benchmark
+    return benchmark_operation(
+        serializer.format_name(),
+        "metadata_batch_deserialization",
+        logical_size(decoded),
+        serialized_data.size(),
+        [&]() { return serializer.deserialize_metadata_batch(serialized_data); },
+        decoded.size()
+    );
+}
+
+BenchmarkResult BenchmarkRunner::benchmark_metadata_field_read(
+    SerializerInterface& serializer,
+    const std::vector<uint8_t>& serialized_data) {
+    
+    // Formats without random access have to decode everything to reach one field
+    return benchmark_operation(
+        serializer.format_name(),
+        "metadata_field_read",
+        sizeof(uint64_t),
+        serialized_data.size(),
+        [&]() { return serializer.deserialize_metadata(serialized_data).size; }
+    );
+}
+
+BenchmarkResult BenchmarkRunner::benchmark_metadata_all_fields_read(
+    SerializerInterface& serializer,
+    const std::vector<uint8_t>& serialized_data) {
+    
+    return benchmark_operation(
+        serializer.format_name(),
+        "metadata_all_fields_read",
+        logical_size(serializer.deserialize_metadata(serialized_data)),
+        serialized_data.size(),
+        [&]() { return serializer.deserialize_metadata(serialized_data); }
+    );
+}
+
+BenchmarkResult BenchmarkRunner::benchmark_metadata_serialization_rotating(
+    SerializerInterface& serializer,
+    const std::vector<FileMetadata>& pool) {
+    
+    require_pool(pool);
+    size_t data_size = 0;
+    size_t serialized_size = 0;
+    for (const auto& metadata : pool) {
+        data_size += logical_size(metadata);
+        serialized_size += serializer.serialize_metadata(metadata).size();
+    }
+    
+    PoolCursor<FileMetadata> cursor(pool);
+    return benchmark_operation(
+        serializer.format_name(),
+        "metadata_serialization",
+        data_size / pool.size(),
+        serialized_size / pool.size(),
+        [&]() { return serializer.serialize_metadata(cursor.next()); }
+    );
+}
+
+BenchmarkResult BenchmarkRunner::benchmark_metadata_deserialization_rotating(
+    SerializerInterface& serializer,
+    const std::vector<std::vector<uint8_t>>& pool) {
+    
+    require_pool(pool);
+    size_t data_size = 0;
+    size_t serialized_size = 0;
+    for (const auto& serialized_data : pool) {
+        data_size += logical_size(serializer.deserialize_metadata(serialized_data));
+        serialized_size += serialized_data.size();
+    }
+    
+    PoolCursor<std::vector<uint8_t>> cursor(pool);
+    return benchmark_operation(
+        serializer.format_name(),
+        "metadata_deserialization",
+        data_size / pool.size(),
+        serialized_size / pool.size(),
+        [&]() { return serializer.deserialize_metadata(cursor.next()); }
+    );
+}
+
+BenchmarkResult BenchmarkRunner::benchmark_block_serialization_rotating(
+    SerializerInterface& serializer,
+    const std::vector<FileBlock>& pool) {
+    
+    require_pool(pool);
+    size_t data_size = 0;
+    size_t serialized_size = 0;
+    for (const auto& block : pool) {
+        data_size += logical_size(block);
+        serialized_size += serializer.serialize_block(block).size();
+    }
+    
+    PoolCursor<FileBlock> cursor(pool);
+    return benchmark_operation(
+        serializer.format_name(),
+        "block_serialization",
+        data_size / pool.size(),
+        serialized_size / pool.size(),
+        [&]() { return serializer.serialize_block(cursor.next()); }
+    );
+}
+
+BenchmarkResult BenchmarkRunner::benchmark_block_deserialization_rotating(
+    SerializerInterface& serializer,
+    const std::vector<std::vector<uint8_t>>& pool) {
+    
+    require_pool(pool);
+    size_t data_size = 0;
+    size_t serialized_size = 0;
+    for (const auto& serialized_data : pool) {
+        data_size += logical_size(serializer.deserialize_block(serialized_data));
+        serialized_size += serialized_data.size();
+    }
+    
+    PoolCursor<std::vector<uint8_t>> cursor(pool);
+    return benchmark_operation(
+        serializer.format_name(),
+        "block_deserialization",
+        data_size / pool.size(),
+        serialized_size / pool.size(),
+        [&]() { return serializer.deserialize_block(cursor.next()); }
+    );
+}
+
+BenchmarkResult BenchmarkRunner::benchmark_custom_operation(
+    const std::string& format_name,
+    const std::string& operation_name,
+    size_t data_size_bytes,
+    size_t serialized_size_bytes,
+    const std::function<void()>& operation) {
+    
+    return benchmark_operation(
+        format_name,
+        operation_name,
+        data_size_bytes,
+        serialized_size_bytes,
+        operation
+    );
+}
+
+template<typename Func>
+size_t BenchmarkRunner::calibrate_batch(Func& operation) const {
+    if (options_.min_sample_ns == 0) {
+        return 1;
+    }
+    size_t batch = 1;
+    for (;;) {
+        uint64_t elapsed = time_batch_ns(operation, batch);
+        if (elapsed >= options_.min_sample_ns || batch >= MAX_BATCH) {
+            return batch;
+        }
+        // Once a batch takes long enough to time, jump to the estimate (with
+        // 10% headroom); below that the clock is too coarse to trust, so double
+        size_t next = batch * 2;
+        if (elapsed >= 1000) {
+            double estimate = static_cast<double>(batch) * options_.min_sample_ns / elapsed * 1.1;
+            next = std::max(next, static_cast<size_t>(estimate));
+        }
+        batch = std::min(next, MAX_BATCH);
+    }
+}
+
 template<typename Func>
 BenchmarkResult BenchmarkRunner::benchmark_operation(
     const std::string& format_name,
     const std::string& operation_name,
     size_t data_size_bytes,
     size_t serialized_size_bytes,
-    Func&& operation) {
+    Func&& operation,
+    size_t records) {
     
     // Run the operation once to warm up
-    operation();
+    run_and_keep(operation);
+    size_t batch = options_.flush_cache ? 1 : calibrate_batch(operation);
     
-    // Measure the execution time
+    // Each sample is the per-operation average over one batch
     std::vector<double> durations;
-    durations.reserve(iterations_);
+    durations.reserve(options_.samples);
+    LatencyHistogram histogram;
+    double sum_ns = 0.0;
+    double sum_squares_ns = 0.0;
+    double rse = 1.0;
+    auto deadline = std::chrono::high_resolution_clock::now() +
+                    std::chrono::duration<double>(options_.max_seconds);
     
-    for (size_t i = 0; i < iterations_; ++i) {
-        auto start = std::chrono::high_resolution_clock::now();
-        operation();
-        auto end = std::chrono::high_resolution_clock::now();
-        
-        auto duration = std::chrono::duration<double, std::milli>(end - start).count();
-        durations.push_back(duration);
+    std::unique_ptr<PerfCounterGroup> counters;
+    if (options_.hardware_counters) {
+        counters.reset(new PerfCounterGroup());
+        counters->start();
     }
     
-    // Calculate average duration (excluding outliers)
-    std::sort(durations.begin(), durations.end());
-    size_t outliers_to_remove = iterations_ / 10; // Remove 10% from each end
-    
-    double total_duration = 0.0;
-    for (size_t i = outliers_to_remove; i < iterations_ - outliers_to_remove; ++i) {
-        total_duration += durations[i];
+    for (size_t i = 0; ; ++i) {
+        // At least one sample, then max_seconds bounds the run whatever target_rse is
+        if (i > 0 && std::chrono::high_resolution_clock::now() >= deadline) {
+            break;
+        }
+        if (i >= options_.samples &&
+            (options_.target_rse <= 0.0 || rse <= options_.target_rse || i >= options_.max_samples)) {
+            break;
+        }
+        
+        if (options_.flush_cache) {
+            // The eviction walk stays out of the counters as well as the clock
+            if (counters) {
+                counters->stop();
+            }
+            evict_caches();
+            if (counters) {
+                counters->resume();
+            }
+        }
+        double per_operation_ns = static_cast<double>(time_batch_ns(operation, batch)) / batch;
+        durations.push_back(per_operation_ns / 1e6);
+        histogram.record(static_cast<uint64_t>(std::llround(per_operation_ns)));
+        sum_ns += per_operation_ns;
+        sum_squares_ns += per_operation_ns * per_operation_ns;
+        rse = relative_standard_error(durations.size(), sum_ns, sum_squares_ns);
     }
     
-    double avg_duration = total_duration / (iterations_ - 2 * outliers_to_remove);
+    PerfCounterValues counter_values;
+    if (counters) {
+        counters->stop();
+        counter_values = counters->read(static_cast<uint64_t>(durations.size()) * batch);
+    }
     
-    // Create and return the benchmark result
+    // Create and return the benchmark result; the headline figure stays the
+    // 10%-trimmed mean, with the tails reported alongside it
     BenchmarkResult result;
     result.format_name = format_name;
     result.operation_name = operation_name;
     result.data_size_bytes = data_size_bytes;
-    result.duration_ms = avg_duration;
+    result.latency = summarize_latencies(durations, histogram);
+    result.duration_ms = result.latency.trimmed_mean_ms;
     result.serialized_size_bytes = serialized_size_bytes;
+    result.histogram = std::move(histogram);
+    result.records = records;
+    result.batch_size = batch;
+    result.relative_standard_error = durations.size() < 2 ? 0.0 : rse;
+    result.counters = counter_values;
+    
+    if (allocation_hooks_installed()) {
+        AllocationScope scope;
+        run_and_keep(operation);
+        AllocationStats allocations = scope.stats();
+        result.allocations_measured = true;
+        result.allocations_per_op = allocations.allocations;
+        result.bytes_allocated_per_op = allocations.bytes_allocated;
+        result.peak_live_bytes = allocations.peak_live_bytes;
+    }
+    
+    // Rates follow the headline duration
+    if (result.duration_ms > 0.0) {
+        double ops_per_sec = 1000.0 / result.duration_ms;
+        result.ops_per_sec = ops_per_sec;
+        result.records_per_sec = ops_per_sec * static_cast<double>(records);
+        result.logical_mb_per_sec = ops_per_sec * static_cast<double>(data_size_bytes) / BYTES_PER_MB;
+        result.wire_mb_per_sec = ops_per_sec * static_cast<double>(serialized_size_bytes) / BYTES_PER_MB;
+    }
     
     return result;
 }
 
+ScalingResult BenchmarkRunner::benchmark_metadata_serialization_scaling(
+    const SerializerFactory& factory,
+    const FileMetadata& metadata,
+    size_t max_threads) {
+    
+    size_t serialized_size = factory()->serialize_metadata(metadata).size();
+    return benchmark_scaling(
+        factory, "metadata_serialization", logical_size(metadata), serialized_size,
+        [&metadata](SerializerInterface& serializer) -> std::function<void()> {
+            return [&serializer, &metadata]() { do_not_optimize(serializer.serialize_metadata(metadata)); };
+        },
+        max_threads);
+}
+
+ScalingResult BenchmarkRunner::benchmark_metadata_deserialization_scaling(
+    const SerializerFactory& factory,
+    const std::vector<uint8_t>& serialized_data,
+    size_t max_threads) {
+    
+    size_t data_size = logical_size(factory()->deserialize_metadata(serialized_data));
+    return benchmark_scaling(
+        factory, "metadata_deserialization", data_size, serialized_data.size(),
+        [&serialized_data](SerializerInterface& serializer) -> std::function<void()> {
+            return [&serializer, &serialized_data]() {
+                do_not_optimize(serializer.deserialize_metadata(serialized_data));
+            };
+        },
+        max_threads);
+}
+
+ScalingResult BenchmarkRunner::benchmark_block_serialization_scaling(
+    const SerializerFactory& factory,
+    const FileBlock& block,
+    size_t max_threads) {
+    
+    size_t serialized_size = factory()->serialize_block(block).size();
+    return benchmark_scaling(
+        factory, "block_serialization", logical_size(block), serialized_size,
+        [&block](SerializerInterface& serializer) -> std::function<void()> {
+            return [&serializer, &block]() { do_not_optimize(serializer.serialize_block(block)); };
+        },
+        max_threads);
+}
+
+ScalingResult BenchmarkRunner::benchmark_block_deserialization_scaling(
+    const SerializerFactory& factory,
+    const std::vector<uint8_t>& serialized_data,
+    size_t max_threads) {
+    
+    size_t data_size = logical_size(factory()->deserialize_block(serialized_data));
+    return benchmark_scaling(
+        factory, "block_deserialization", data_size, serialized_data.size(),
+        [&serialized_data](SerializerInterface& serializer) -> std::function<void()> {
+            return [&serializer, &serialized_data]() {
+                do_not_optimize(serializer.deserialize_block(serialized_data));
+            };
+        },
+        max_threads);
+}
+
+ScalingResult BenchmarkRunner::benchmark_scaling(
+    const SerializerFactory& factory,
+    const std::string& operation_name,
+    size_t data_size_bytes,
+    size_t serialized_size_bytes,
+    const std::function<std::function<void()>(SerializerInterface&)>& make_operation,
+    size_t max_threads) {
+    
+    ScalingResult result;
+    result.format_name = factory()->format_name();
+    result.operation_name = operation_name;
+    result.data_size_bytes = data_size_bytes;
+    result.serialized_size_bytes = serialized_size_bytes;
+    
+    for (size_t threads : scaling_thread_counts(max_threads)) {
+        ScalingPoint point = measure_scaling_point(factory, make_operation, threads,
+                                                   data_size_bytes, serialized_size_bytes);
+        if (!result.points.empty() && result.points.front().ops_per_sec > 0.0) {
+            point.speedup = point.ops_per_sec / result.points.front().ops_per_sec;
+        } else {
+            point.speedup = 1.0;
+        }
+        point.efficiency = point.speedup / static_cast<double>(threads);
+        result.points.push_back(std::move(point));
+    }
+    return result;
+}
+
+ScalingPoint BenchmarkRunner::measure_scaling_point(
+    const SerializerFactory& factory,
+    const std::function<std::function<void()>(SerializerInterface&)>& make_operation,
+    size_t threads,
+    size_t data_size_bytes,
+    size_t serialized_size_bytes) const {
+    
+    struct Worker {
+        std::vector<double> samples_ms;
+        LatencyHistogram histogram;
+        uint64_t operations = 0;
+        double seconds = 0.0;
+        std::exception_ptr error;
+    };
+    std::vector<Worker> workers(threads);
+    std::vector<int> cpus = allowed_cpus();
+    std::atomic<size_t> ready(0);
+    std::atomic<bool> start(false);
+    std::atomic<bool> stop(false);
+    
+    auto work = [&](size_t index) {
+        Worker& worker = workers[index];
+        if (!cpus.empty()) {
+            pin_current_thread(cpus[index % cpus.size()]);
+        }
+        
+        // Serializers are created on their own thread, so their allocations are too
+        std::unique_ptr<SerializerInterface> serializer;
+        std::function<void()> operation;
+        size_t batch = 1;
+        try {
+            serializer = factory();
+            operation = make_operation(*serializer);
+            run_and_keep(operation);
+            // Calibrated before the barrier, so no thread spends the window calibrating
+            batch = calibrate_batch(operation);
+        } catch (...) {
+            worker.error = std::current_exception();
+        }
+        ++ready;
+        while (!start.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        if (worker.error) {
+            return;
+        }
+        
+        try {
+            // At least one sample, even if the window closes before this thread is scheduled
+            auto begin = std::chrono::high_resolution_clock::now();
+            do {
+                double per_operation_ns = static_cast<double>(time_batch_ns(operation, batch)) / batch;
+                worker.samples_ms.push_back(per_operation_ns / 1e6);
+                worker.histogram.record(static_cast<uint64_t>(std::llround(per_operation_ns)));
+                worker.operations += batch;
+            } while (!stop.load(std::memory_order_relaxed));
+            worker.seconds = std::chrono::duration<double>(
+                std::chrono::high_resolution_clock::now() - begin).count();
+        } catch (...) {
+            worker.error = std::current_exception();
+        }
+    };
+    
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        pool.emplace_back(work, i);
+    }
+    while (ready.load() < threads) {
+        std::this_thread::yield();
+    }
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::duration<double>(options_.scaling_seconds));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    
+    ScalingPoint point;
+    point.threads = threads;
+    std::vector<double> all_samples_ms;
+    LatencyHistogram merged;
+    for (const auto& worker : workers) {
+        if (worker.error) {
+            std::rethrow_exception(worker.error);
+        }
+        if (worker.seconds > 0.0) {
+            point.ops_per_sec += static_cast<double>(worker.operations) / worker.seconds;
+        }
+        point.operations += worker.operations;
+        // Bootstrap intervals are skipped: with many threads they would cost more than the run
+        point.per_thread.push_back(summarize_latencies(worker.samples_ms, worker.histogram, 0.95, 0));
+        all_samples_ms.insert(all_samples_ms.end(), worker.samples_ms.begin(), worker.samples_ms.end());
+        merged.merge(worker.histogram);
+    }
+    point.latency = summarize_latencies(all_samples_ms, merged, 0.95, 0);
+    point.logical_mb_per_sec = point.ops_per_sec * static_cast<double>(data_size_bytes) / BYTES_PER_MB;
+    point.wire_mb_per_sec = point.ops_per_sec * static_cast<double>(serialized_size_bytes) / BYTES_PER_MB;
+    return point;
+}
+
+BenchmarkResult BenchmarkRunner::benchmark_memcpy_baseline(size_t size_bytes) {
+    std::vector<uint8_t> source(size_bytes, 0xA5);
+    std::vector<uint8_t> destination(size_bytes);
+    
+    return benchmark_operation(
+        "memcpy",
+        "memcpy",
+        size_bytes,
+        size_bytes,
+        [&]() {
+            if (size_bytes > 0) {
+                std::memcpy(destination.data(), source.data(), size_bytes);
+            }
+            // Nothing reads destination, so make the copy observable
+            do_not_optimize(destination.data());
+            clobber_memory();
+        }
+    );
+}
+
+void BenchmarkRunner::add_memcpy_baselines(std::vector<BenchmarkResult>& results) {
+    std::map<size_t, double> baseline_mb_per_sec;
+    size_t measured = results.size();
+    
+    for (size_t i = 0; i < measured; ++i) {
+        if (results[i].format_name == "memcpy") {
+            continue;
+        }
+        size_t size = results[i].serialized_size_bytes;
+        auto baseline = baseline_mb_per_sec.find(size);
+        if (baseline == baseline_mb_per_sec.end()) {
+            BenchmarkResult row = benchmark_memcpy_baseline(size);
+            baseline = baseline_mb_per_sec.emplace(size, row.wire_mb_per_sec).first;
+            results.push_back(std::move(row));
+        }
+        if (baseline->second > 0.0) {
+            results[i].memcpy_fraction = results[i].wire_mb_per_sec / baseline->second;
+        }
+    }
+}
+
 void BenchmarkRunner::print_results(const std::vector<BenchmarkResult>& results) {
+    int operation_column = static_cast<int>(operation_width(results));
+    
     // Print header
     std::cout << std::left
               << std::setw(15) << "Format"
-              << std::setw(25) << "Operation"
+              << std::setw(operation_column) << "Operation"
               << std::setw(15) << "Data Size (B)"
               << std::setw(15) << "Serialized (B)"
-              << std::setw(15) << "Duration (ms)"
+              << std::setw(15) << "Duration (us)"
+              << std::setw(23) << "95% CI (us)"
+              << std::setw(12) << "Min (us)"
+              << std::setw(12) << "p50 (us)"
+              << std::setw(12) << "p90 (us)"
+              << std::setw(12) << "p99 (us)"
+              << std::setw(12) << "p99.9 (us)"
+              << std::setw(12) << "Max (us)"
+              << std::setw(12) << "StdDev (us)"
+              << std::setw(13) << "Ops/s"
+              << std::setw(13) << "MB/s"
+              << std::setw(13) << "Wire MB/s"
+              << std::setw(10) << "% memcpy"
+              << std::setw(11) << "Allocs/op"
+              << std::setw(12) << "Alloc B/op"
               << std::endl;
     
-    std::cout << std::string(85, '-') << std::endl;
+    std::cout << std::string(239 + operation_column, '-') << std::endl;
     
-    // Print results
+    // Print results; latencies in microseconds so sub-microsecond calls keep
+    // three significant digits
     for (const auto& result : results) {
+        std::ostringstream ci;
+        ci << std::fixed << std::setprecision(3)
+           << result.latency.ci_low_ms * 1e3 << "-" << result.latency.ci_high_ms * 1e3;
+        
+        std::ostringstream fraction;
+        if (result.memcpy_fraction > 0.0) {
+            fraction << std::fixed << std::setprecision(1) << result.memcpy_fraction * 100.0;
+        } else {
+            fraction << "-";
+        }
+        
+        std::string allocations = result.allocations_measured ? std::to_string(result.allocations_per_op) : "-";
+        std::string allocated_bytes = result.allocations_measured ? std::to_string(result.bytes_allocated_per_op) : "-";
+        
+        // Batched percentiles are of batch averages, not single calls
+        auto percentile = [&result](double value_ms) {
+            std::ostringstream text;
+            text << std::fixed << std::setprecision(3) << value_ms * 1e3 << (result.batch_size > 1 ? "*" : "");
+            return text.str();
+        };
+        
         std::cout << std::left
                   << std::setw(15) << result.format_name
-                  << std::setw(25) << result.operation_name
+                  << std::setw(operation_column) << result.operation_name
                   << std::setw(15) << result.data_size_bytes
                   << std::setw(15) << result.serialized_size_bytes
-                  << std::setw(15) << std::fixed << std::setprecision(3) << result.duration_ms
+                  << std::setw(15) << std::fixed << std::setprecision(3) << result.duration_ms * 1e3
+                  << std::setw(23) << ci.str()
+                  << std::setw(12) << percentile(result.latency.min_ms)
+                  << std::setw(12) << percentile(result.latency.p50_ms)
+                  << std::setw(12) << percentile(result.latency.p90_ms)
+                  << std::setw(12) << percentile(result.latency.p99_ms)
+                  << std::setw(12) << percentile(result.latency.p999_ms)
+                  << std::setw(12) << percentile(result.latency.max_ms)
+                  << std::setw(12) << result.latency.stddev_ms * 1e3
+                  << std::setprecision(0)
+                  << std::setw(13) << result.ops_per_sec
+                  << std::setprecision(1)
+                  << std::setw(13) << result.logical_mb_per_sec
+                  << std::setw(13) << result.wire_mb_per_sec
+                  << std::setw(10) << fraction.str()
+                  << std::setw(11) << allocations
+                  << std::setw(12) << allocated_bytes
                   << std::endl;
     }
+    
+    bool any_batched = false;
+    bool any_counters = false;
+    for (const auto& result : results) {
+        any_batched = any_batched || result.batch_size > 1;
+        any_counters = any_counters || result.counters.any();
+    }
+    if (any_batched) {
+        std::cout << "* Percentiles of batch averages (min_sample_ns batching), not of single calls" << std::endl;
+    }
+    if (any_counters) {
+        std::cout << std::endl << "Per-operation CPU counters:" << std::endl;
+        print_counter_results(results);
+    }
 }
 
 void BenchmarkRunner::export_results_csv(
@@ -170,18 +865,348 @@ void BenchmarkRunner::export_results_csv(
         std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
         return;
     }
+    export_results_csv(results, file);
+}
+
+void BenchmarkRunner::export_results_csv(
+    const std::vector<BenchmarkResult>& results,
+    std::ostream& out) {
     
     // Write header
-    file << "Format,Operation,DataSizeBytes,SerializedSizeBytes,DurationMs" << std::endl;
+    out << "Format,Operation,DataSizeBytes,SerializedSizeBytes,DurationMs,"
+        << "Samples,MinMs,P50Ms,P90Ms,P99Ms,P999Ms,MaxMs,MeanMs,StdDevMs,CiLowMs,CiHighMs,"
+        << "Records,OpsPerSec,RecordsPerSec,LogicalMBps,WireMBps,MemcpyFraction,BatchSize,PercentileBasis,RelStdErr,"
+        << "AllocsPerOp,AllocBytesPerOp,PeakLiveBytes,Ipc";
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        out << "," << perf_counter_name(static_cast<PerfCounter>(i)) << "PerOp";
+    }
+    out << std::endl;
     
     // Write results
     for (const auto& result : results) {
-        file << result.format_name << ","
-             << result.operation_name << ","
-             << result.data_size_bytes << ","
-             << result.serialized_size_bytes << ","
-             << std::fixed << std::setprecision(6) << result.duration_ms
-             << std::endl;
+        const LatencyStats& latency = result.latency;
+        out << result.format_name << ","
+            << result.operation_name << ","
+            << result.data_size_bytes << ","
+            << result.serialized_size_bytes << ","
+            << std::fixed << std::setprecision(6) << result.duration_ms << ","
+            << latency.samples << ","
+            << latency.min_ms << ","
+            << latency.p50_ms << ","
+            << latency.p90_ms << ","
+            << latency.p99_ms << ","
+            << latency.p999_ms << ","
+            << latency.max_ms << ","
+            << latency.mean_ms << ","
+            << latency.stddev_ms << ","
+            << latency.ci_low_ms << ","
+            << latency.ci_high_ms << ","
+            << result.records << ","
+            << result.ops_per_sec << ","
+            << result.records_per_sec << ","
+            << result.logical_mb_per_sec << ","
+            << result.wire_mb_per_sec << ","
+            << result.memcpy_fraction << ","
+            << result.batch_size << ","
+            << (result.batch_size > 1 ? "batch" : "call") << ","
+            << result.relative_standard_error << ",";
+        // Left empty, not zero, when the hooks were not linked
+        if (result.allocations_measured) {
+            out << result.allocations_per_op << ","
+                << result.bytes_allocated_per_op << ","
+                << result.peak_live_bytes;
+        } else {
+            out << ",,";
+        }
+        out << ",";
+        if (result.counters.ipc() > 0.0) {
+            out << result.counters.ipc();
+        }
+        for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+            out << ",";
+            if (result.counters.measured[i]) {
+                out << result.counters.per_op[i];
+            }
+        }
+        out << std::endl;
+    }
+}
+
+void BenchmarkRunner::export_results_json(
+    const std::vector<BenchmarkResult>& results,
+    const std::string& filename) {
+    
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
+        return;
+    }
+    export_results_json(results, file);
+}
+
+void BenchmarkRunner::export_results_json(
+    const std::vector<BenchmarkResult>& results,
+    std::ostream& out) {
+    
+    // Allocation fields are null, and counters absent, when not measured
+    auto allocation = [](uint64_t value, bool measured) {
+        return measured ? std::to_string(value) : std::string("null");
+    };
+    out << "[" << std::endl;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        const LatencyStats& latency = result.latency;
+        out << std::fixed << std::setprecision(6)
+            << "  {\"format\": \"" << json_escape(result.format_name) << "\""
+            << ", \"operation\": \"" << json_escape(result.operation_name) << "\""
+            << ", \"data_size_bytes\": " << result.data_size_bytes
+            << ", \"serialized_size_bytes\": " << result.serialized_size_bytes
+            << ", \"records\": " << result.records
+            << ", \"samples\": " << latency.samples
+            << ", \"batch_size\": " << result.batch_size
+            << ", \"percentile_basis\": \"" << (result.batch_size > 1 ? "batch" : "call") << "\""
+            << ", \"duration_ms\": " << result.duration_ms
+            << ", \"min_ms\": " << latency.min_ms
+            << ", \"p50_ms\": " << latency.p50_ms
+            << ", \"p90_ms\": " << latency.p90_ms
+            << ", \"p99_ms\": " << latency.p99_ms
+            << ", \"p999_ms\": " << latency.p999_ms
+            << ", \"max_ms\": " << latency.max_ms
+            << ", \"ci_low_ms\": " << latency.ci_low_ms
+            << ", \"ci_high_ms\": " << latency.ci_high_ms
+            << ", \"relative_standard_error\": " << result.relative_standard_error
+            << ", \"ops_per_sec\": " << result.ops_per_sec
+            << ", \"records_per_sec\": " << result.records_per_sec
+            << ", \"logical_mb_per_sec\": " << result.logical_mb_per_sec
+            << ", \"wire_mb_per_sec\": " << result.wire_mb_per_sec
+            << ", \"memcpy_fraction\": " << result.memcpy_fraction
+            << ", \"allocs_per_op\": " << allocation(result.allocations_per_op, result.allocations_measured)
+            << ", \"alloc_bytes_per_op\": " << allocation(result.bytes_allocated_per_op, result.allocations_measured)
+            << ", \"peak_live_bytes\": " << allocation(result.peak_live_bytes, result.allocations_measured);
+        if (result.counters.any()) {
+            out << ", \"counters\": {";
+            const char* separator = "";
+            for (size_t c = 0; c < PERF_COUNTER_COUNT; ++c) {
+                if (result.counters.measured[c]) {
+                    out << separator << "\"" << perf_counter_name(static_cast<PerfCounter>(c)) << "\": "
+                        << result.counters.per_op[c];
+                    separator = ", ";
+                }
+            }
+            out << "}";
+        }
+        out << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    out << "]" << std::endl;
+}
+
+void BenchmarkRunner::print_counter_results(const std::vector<BenchmarkResult>& results) {
+    int operation_column = static_cast<int>(operation_width(results));
+    std::cout << std::left
+              << std::setw(15) << "Format"
+              << std::setw(operation_column) << "Operation"
+              << std::setw(8) << "IPC";
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        std::cout << std::setw(15) << perf_counter_name(static_cast<PerfCounter>(i));
+    }
+    std::cout << std::endl;
+    std::cout << std::string(113 + operation_column, '-') << std::endl;
+    
+    for (const auto& result : results) {
+        if (!result.counters.any()) {
+            continue;
+        }
+        std::ostringstream ipc;
+        if (result.counters.ipc() > 0.0) {
+            ipc << std::fixed << std::setprecision(2) << result.counters.ipc();
+        } else {
+            ipc << "-";
+        }
+        std::cout << std::left
+                  << std::setw(15) << result.format_name
+                  << std::setw(operation_column) << result.operation_name
+                  << std::setw(8) << ipc.str();
+        for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+            std::ostringstream value;
+            if (result.counters.measured[i]) {
+                value << std::fixed << std::setprecision(1) << result.counters.per_op[i];
+            } else {
+                value << "-";
+            }
+            std::cout << std::setw(15) << value.str();
+        }
+        std::cout << std::endl;
+    }
+}
+
+void BenchmarkRunner::print_scaling_results(const std::vector<ScalingResult>& results) {
+    int operation_column = static_cast<int>(operation_width(results));
+    std::cout << std::left
+              << std::setw(15) << "Format"
+              << std::setw(operation_column) << "Operation"
+              << std::setw(9) << "Threads"
+              << std::setw(14) << "Ops/s"
+              << std::setw(12) << "MB/s"
+              << std::setw(12) << "Wire MB/s"
+              << std::setw(9) << "Speedup"
+              << std::setw(12) << "Efficiency"
+              << std::setw(11) << "p50 (us)"
+              << std::setw(11) << "p99 (us)"
+              << std::setw(11) << "p99.9 (us)"
+              << std::setw(16) << "Worst p99 (us)"
+              << std::endl;
+    
+    std::cout << std::string(132 + operation_column, '-') << std::endl;
+    
+    for (const auto& result : results) {
+        for (const auto& point : result.points) {
+            double worst_p99_ms = 0.0;
+            for (const auto& thread : point.per_thread) {
+                worst_p99_ms = std::max(worst_p99_ms, thread.p99_ms);
+            }
+            std::cout << std::left << std::fixed
+                      << std::setw(15) << result.format_name
+                      << std::setw(operation_column) << result.operation_name
+                      << std::setw(9) << point.threads
+                      << std::setprecision(0) << std::setw(14) << point.ops_per_sec
+                      << std::setprecision(1) << std::setw(12) << point.logical_mb_per_sec
+                      << std::setw(12) << point.wire_mb_per_sec
+                      << std::setprecision(2) << std::setw(9) << point.speedup
+                      << std::setw(12) << point.efficiency
+                      << std::setprecision(3)
+                      << std::setw(11) << point.latency.p50_ms * 1e3
+                      << std::setw(11) << point.latency.p99_ms * 1e3
+                      << std::setw(11) << point.latency.p999_ms * 1e3
+                      << std::setw(16) << worst_p99_ms * 1e3
+                      << std::endl;
+        }
+    }
+}
+
+void BenchmarkRunner::export_scaling_csv(
+    const std::vector<ScalingResult>& results,
+    const std::string& filename) {
+    
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
+        return;
+    }
+    export_scaling_csv(results, file);
+}
+
+void BenchmarkRunner::export_scaling_csv(
+    const std::vector<ScalingResult>& results,
+    std::ostream& out) {
+    
+    out << "Format,Operation,DataSizeBytes,SerializedSizeBytes,Threads,Operations,OpsPerSec,"
+        << "LogicalMBps,WireMBps,Speedup,Efficiency,P50Ms,P99Ms,P999Ms,MaxMs,WorstThreadP99Ms" << std::endl;
+    
+    for (const auto& result : results) {
+        for (const auto& point : result.points) {
+            double worst_p99_ms = 0.0;
+            for (const auto& thread : point.per_thread) {
+                worst_p99_ms = std::max(worst_p99_ms, thread.p99_ms);
+            }
+            out << result.format_name << ","
+                << result.operation_name << ","
+                << result.data_size_bytes << ","
+                << result.serialized_size_bytes << ","
+                << point.threads << ","
+                << point.operations << ","
+                << std::fixed << std::setprecision(6) << point.ops_per_sec << ","
+                << point.logical_mb_per_sec << ","
+                << point.wire_mb_per_sec << ","
+                << point.speedup << ","
+                << point.efficiency << ","
+                << point.latency.p50_ms << ","
+                << point.latency.p99_ms << ","
+                << point.latency.p999_ms << ","
+                << point.latency.max_ms << ","
+                << worst_p99_ms
+                << std::endl;
+        }
+    }
+}
+
+void BenchmarkRunner::export_scaling_json(
+    const std::vector<ScalingResult>& results,
+    const std::string& filename) {
+    
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
+        return;
+    }
+    export_scaling_json(results, file);
+}
+
+void BenchmarkRunner::export_scaling_json(
+    const std::vector<ScalingResult>& results,
+    std::ostream& out) {
+    
+    std::vector<std::pair<const ScalingResult*, const ScalingPoint*>> rows;
+    for (const auto& result : results) {
+        for (const auto& point : result.points) {
+            rows.emplace_back(&result, &point);
+        }
+    }
+    out << "[" << std::endl;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const ScalingResult& result = *rows[i].first;
+        const ScalingPoint& point = *rows[i].second;
+        double worst_p99_ms = 0.0;
+        for (const auto& thread : point.per_thread) {
+            worst_p99_ms = std::max(worst_p99_ms, thread.p99_ms);
+        }
+        out << std::fixed << std::setprecision(6)
+            << "  {\"format\": \"" << json_escape(result.format_name) << "\""
+            << ", \"operation\": \"" << json_escape(result.operation_name) << "\""
+            << ", \"data_size_bytes\": " << result.data_size_bytes
+            << ", \"serialized_size_bytes\": " << result.serialized_size_bytes
+            << ", \"threads\": " << point.threads
+            << ", \"operations\": " << point.operations
+            << ", \"ops_per_sec\": " << point.ops_per_sec
+            << ", \"logical_mb_per_sec\": " << point.logical_mb_per_sec
+            << ", \"wire_mb_per_sec\": " << point.wire_mb_per_sec
+            << ", \"speedup\": " << point.speedup
+            << ", \"efficiency\": " << point.efficiency
+            << ", \"p50_ms\": " << point.latency.p50_ms
+            << ", \"p99_ms\": " << point.latency.p99_ms
+            << ", \"p999_ms\": " << point.latency.p999_ms
+            << ", \"max_ms\": " << point.latency.max_ms
+            << ", \"worst_thread_p99_ms\": " << worst_p99_ms
+            << "}" << (i + 1 < rows.size() ? "," : "") << std::endl;
+    }
+    out << "]" << std::endl;
+}
+
+void BenchmarkRunner::export_histograms_csv(
+    const std::vector<BenchmarkResult>& results,
+    const std::string& filename) {
+    
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
+        return;
+    }
+    export_histograms_csv(results, file);
+}
+
+void BenchmarkRunner::export_histograms_csv(
+    const std::vector<BenchmarkResult>& results,
+    std::ostream& out) {
+    
+    out << "Format,Operation,PercentileBasis,BucketLowNs,Count" << std::endl;
+    for (const auto& result : results) {
+        for (const auto& bucket : result.histogram.nonempty_buckets()) {
+            out << result.format_name << ","
+                << result.operation_name << ","
+                << (result.batch_size > 1 ? "batch" : "call") << ","
+                << bucket.first << ","
+                << bucket.second
+                << std::endl;
+        }
     }
 }
 
@@ -1,26 +1,115 @@
 #pragma once
 
 #include <vector>
+#include <ostream>
 #include <string>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include "common/data_structures.h"
 #include "common/serializer_interface.h"
+#include "common/latency_stats.h"
+#include "common/perf_counters.h"
 
 namespace benchmark {
 
 struct BenchmarkResult {
     std::string format_name;
     std::string operation_name;
-    size_t data_size_bytes;
-    double duration_ms;
-    size_t serialized_size_bytes;
+    size_t data_size_bytes;         // Logical bytes: field content of the records handled
+    double duration_ms;             // Mean with the fastest and slowest 10% dropped
+    size_t serialized_size_bytes;   // Wire bytes: the encoded form produced or consumed
+    LatencyStats latency;           // Percentiles, spread and a 95% CI of duration_ms
+    LatencyHistogram histogram;     // Per-operation latency of every sample, in nanoseconds
+    
+    // Rates per second of duration_ms; MB is 10^6 bytes
+    size_t records = 1;             // Records handled per operation
+    double ops_per_sec = 0.0;
+    double records_per_sec = 0.0;
+    double logical_mb_per_sec = 0.0;
+    double wire_mb_per_sec = 0.0;
+    double memcpy_fraction = 0.0;   // Wire MB/s over memcpy's at the same size; 0 if not measured
+    
+    size_t batch_size = 1;          // Operations timed together per sample; above 1 the percentiles are of batch averages
+    double relative_standard_error = 0.0;  // Standard error of the mean latency over the mean
+    
+    // Heap activity of one call, measured untimed after sampling; only when
+    // the allocation hooks are linked (see allocation_tracker.h)
+    bool allocations_measured = false;
+    uint64_t allocations_per_op = 0;
+    uint64_t bytes_allocated_per_op = 0;
+    uint64_t peak_live_bytes = 0;
+    
+    PerfCounterValues counters;     // Per operation over the sampling loop, with hardware_counters set
+};
+
+/**
+ * How BenchmarkRunner turns an operation into timing samples.
+ *
+ * By default every call is timed on its own, so the histogram and
+ * percentiles describe single calls. With min_sample_ns set, operations
+ * shorter than it are run batch_size times between two clock reads, with the
+ * batch size calibrated after warm-up, and each sample is the per-operation
+ * average; that removes clock overhead from the mean, but the percentiles
+ * are then over batch averages and hide the tail (results with batch_size > 1
+ * are marked as such in the table and CSV).
+ *
+ * Sampling stops after samples samples, or earlier once max_seconds have
+ * passed (always keeping at least one sample). With target_rse set, it
+ * continues past samples until the relative standard error of the mean falls
+ * below it or max_samples is reached, still within max_seconds.
+ */
+struct TimingOptions {
+    size_t samples = 100;           // Samples taken (the minimum when target_rse is set)
+    uint64_t min_sample_ns = 0;     // e.g. 20000 to batch short calls; 0 times every call on its own
+    double target_rse = 0.0;        // e.g. 0.01 for 1%; 0 takes exactly samples
+    size_t max_samples = 100000;
+    double max_seconds = 5.0;       // Sampling time limit of one benchmark
+    double scaling_seconds = 0.5;   // Measurement window per thread count in scaling runs
+    bool hardware_counters = false; // Count CPU events around the sampling loop, where permitted
+    bool flush_cache = false;       // Evict every cache level before each timed call (no batching)
+};
+
+/**
+ * One thread count of a scaling run
+ */
+struct ScalingPoint {
+    size_t threads = 0;
+    uint64_t operations = 0;            // Completed across all threads in the window
+    double ops_per_sec = 0.0;           // Aggregate over all threads
+    double logical_mb_per_sec = 0.0;
+    double wire_mb_per_sec = 0.0;
+    double speedup = 0.0;               // ops_per_sec over the single-thread point's
+    double efficiency = 0.0;            // speedup / threads; 1.0 is linear scaling
+    LatencyStats latency;               // All threads' samples merged
+    std::vector<LatencyStats> per_thread;
+};
+
+/**
+ * An operation run at 1, 2, 4 ... N threads, each thread with its own
+ * serializer instance and pinned to its own CPU
+ */
+struct ScalingResult {
+    std::string format_name;
+    std::string operation_name;
+    size_t data_size_bytes = 0;
+    size_t serialized_size_bytes = 0;
+    std::vector<ScalingPoint> points;
 };
 
+// Logical size: the bytes of field content a record carries, independent of format
+size_t logical_size(const FileMetadata& metadata);
+size_t logical_size(const FileBlock& block);
+size_t logical_size(const std::vector<FileMetadata>& batch);
+
 class BenchmarkRunner {
 public:
     // Constructor
     BenchmarkRunner(size_t iterations = 100);
+    explicit BenchmarkRunner(const TimingOptions& options);
+    
+    const TimingOptions& timing_options() const { return options_; }
+    void set_timing_options(const TimingOptions& options) { options_ = options; }
     
     // Run serialization benchmark for metadata
     BenchmarkResult benchmark_metadata_serialization(
@@ -42,6 +131,99 @@ public:
         SerializerInterface& serializer,
         const std::vector<uint8_t>& serialized_data);
     
+    // Run block decode benchmark under a verification policy. Deferred decodes
+    // include the first access, so they pay for the check they postponed.
+    BenchmarkResult benchmark_block_decode(
+        SerializerInterface& serializer,
+        const std::vector<uint8_t>& serialized_data,
+        const DecodeOptions& options);
+    
+    // Run serialization benchmark for a batch of metadata records
+    BenchmarkResult benchmark_metadata_batch_serialization(
+        SerializerInterface& serializer,
+        const std::vector<FileMetadata>& batch);
+    
+    // Run deserialization benchmark for a batch of metadata records
+    BenchmarkResult benchmark_metadata_batch_deserialization(
+        SerializerInterface& serializer,
+        const std::vector<uint8_t>& serialized_data);
+    
+    // Run field access benchmark: decode metadata and read a single field
+    BenchmarkResult benchmark_metadata_field_read(
+        SerializerInterface& serializer,
+        const std::vector<uint8_t>& serialized_data);
+    
+    // Run field access benchmark: decode metadata and read every field
+    BenchmarkResult benchmark_metadata_all_fields_read(
+        SerializerInterface& serializer,
+        const std::vector<uint8_t>& serialized_data);
+    
+    // Rotating benchmarks: call i takes input i % pool size, so the pool, not
+    // one hot record, is the working set. Sizes are per-call averages over the pool.
+    BenchmarkResult benchmark_metadata_serialization_rotating(
+        SerializerInterface& serializer,
+        const std::vector<FileMetadata>& pool);
+    
+    BenchmarkResult benchmark_metadata_deserialization_rotating(
+        SerializerInterface& serializer,
+        const std::vector<std::vector<uint8_t>>& pool);
+    
+    BenchmarkResult benchmark_block_serialization_rotating(
+        SerializerInterface& serializer,
+        const std::vector<FileBlock>& pool);
+    
+    BenchmarkResult benchmark_block_deserialization_rotating(
+        SerializerInterface& serializer,
+        const std::vector<std::vector<uint8_t>>& pool);
+    
+    // Run a benchmark for an arbitrary operation (e.g. format-specific readers)
+    BenchmarkResult benchmark_custom_operation(
+        const std::string& format_name,
+        const std::string& operation_name,
+        size_t data_size_bytes,
+        size_t serialized_size_bytes,
+        const std::function<void()>& operation);
+    
+    // Scaling runs: every thread count from 1 doubling up to max_threads (0
+    // means one per CPU in the process's affinity mask; always included),
+    // each measured for scaling_seconds with all threads running at once
+    ScalingResult benchmark_metadata_serialization_scaling(
+        const SerializerFactory& factory,
+        const FileMetadata& metadata,
+        size_t max_threads = 0);
+    
+    ScalingResult benchmark_metadata_deserialization_scaling(
+        const SerializerFactory& factory,
+        const std::vector<uint8_t>& serialized_data,
+        size_t max_threads = 0);
+    
+    ScalingResult benchmark_block_serialization_scaling(
+        const SerializerFactory& factory,
+        const FileBlock& block,
+        size_t max_threads = 0);
+    
+    ScalingResult benchmark_block_deserialization_scaling(
+        const SerializerFactory& factory,
+        const std::vector<uint8_t>& serialized_data,
+        size_t max_threads = 0);
+    
+    // Scaling run of an arbitrary operation; make_operation is called on each
+    // worker with that worker's serializer and returns the call to time
+    ScalingResult benchmark_scaling(
+        const SerializerFactory& factory,
+        const std::string& operation_name,
+        size_t data_size_bytes,
+        size_t serialized_size_bytes,
+        const std::function<std::function<void()>(SerializerInterface&)>& make_operation,
+        size_t max_threads = 0);
+    
+    // Copy size_bytes between two buffers: the bandwidth ceiling for a pass over that many bytes
+    BenchmarkResult benchmark_memcpy_baseline(size_t size_bytes);
+    
+    // Run a memcpy baseline for each distinct wire size in results, append
+    // those rows, and set memcpy_fraction on every other result
+    void add_memcpy_baselines(std::vector<BenchmarkResult>& results);
+    
     // Print benchmark results
     static void print_results(const std::vector<BenchmarkResult>& results);
     
@@ -49,9 +231,61 @@ public:
     static void export_results_csv(
         const std::vector<BenchmarkResult>& results,
         const std::string& filename);
+    static void export_results_csv(
+        const std::vector<BenchmarkResult>& results,
+        std::ostream& out);
+    
+    // Export results as a JSON array with one object per result
+    static void export_results_json(
+        const std::vector<BenchmarkResult>& results,
+        const std::string& filename);
+    static void export_results_json(
+        const std::vector<BenchmarkResult>& results,
+        std::ostream& out);
+    
+    // Print per-operation CPU counters of the results that have them
+    static void print_counter_results(const std::vector<BenchmarkResult>& results);
+    
+    // Print one row per thread count with throughput, efficiency and latency
+    static void print_scaling_results(const std::vector<ScalingResult>& results);
+    
+    // Export scaling results to CSV, one row per thread count
+    static void export_scaling_csv(
+        const std::vector<ScalingResult>& results,
+        const std::string& filename);
+    static void export_scaling_csv(
+        const std::vector<ScalingResult>& results,
+        std::ostream& out);
+    
+    // Export scaling results as a JSON array, one object per thread count
+    static void export_scaling_json(
+        const std::vector<ScalingResult>& results,
+        const std::string& filename);
+    static void export_scaling_json(
+        const std::vector<ScalingResult>& results,
+        std::ostream& out);
+    
+    // Export every non-empty histogram bucket to CSV, one row per bucket
+    static void export_histograms_csv(
+        const std::vector<BenchmarkResult>& results,
+        const std::string& filename);
+    static void export_histograms_csv(
+        const std::vector<BenchmarkResult>& results,
+        std::ostream& out);
 
 private:
-    size_t iterations_;
+    TimingOptions options_;
+    
+    // Operations per sample so one sample lasts at least min_sample_ns
+    template<typename Func>
+    size_t calibrate_batch(Func& operation) const;
+    
+    ScalingPoint measure_scaling_point(
+        const SerializerFactory& factory,
+        const std::function<std::function<void()>(SerializerInterface&)>& make_operation,
+        size_t threads,
+        size_t data_size_bytes,
+        size_t serialized_size_bytes) const;
     
     // Generic benchmark function template
     template<typename Func>
@@ -60,7 +294,8 @@ private:
         const std::string& operation_name,
         size_t data_size_bytes,
         size_t serialized_size_bytes,
-        Func&& operation);
+        Func&& operation,
+        size_t records = 1);
 };
 
 } // namespace benchmark
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace benchmark {
+
+// Forces value to be materialized, so the computation producing it cannot be
+// elided, without copying it or otherwise adding work to the timed region
+template<typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Tells the compiler all memory may have been read and written, so stores
+// made by the timed code (e.g. into a buffer nobody reads) must happen
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+// Calls operation and keeps its result, or its side effects when it returns void
+template<typename Func>
+inline void run_and_keep(Func& operation) {
+    if constexpr (std::is_void<decltype(operation())>::value) {
+        operation();
+        clobber_memory();
+    } else {
+        do_not_optimize(operation());
+    }
+}
+
+} // namespace benchmark
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace benchmark {
+
+/**
+ * Little-endian byte helpers shared by the binary formats.
+ * Loads and stores go through memcpy, so they are safe on unaligned buffers.
+ */
+template<typename T>
+inline T load_le(const uint8_t* p) {
+    static_assert(std::is_integral<T>::value, "load_le requires an integral type");
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if (sizeof(T) == 2) value = static_cast<T>(__builtin_bswap16(static_cast<uint16_t>(value)));
+    if (sizeof(T) == 4) value = static_cast<T>(__builtin_bswap32(static_cast<uint32_t>(value)));
+    if (sizeof(T) == 8) value = static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(value)));
+#endif
+    return value;
+}
+
+template<typename T>
+inline void store_le(uint8_t* p, T value) {
+    static_assert(std::is_integral<T>::value, "store_le requires an integral type");
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if (sizeof(T) == 2) value = static_cast<T>(__builtin_bswap16(static_cast<uint16_t>(value)));
+    if (sizeof(T) == 4) value = static_cast<T>(__builtin_bswap32(static_cast<uint32_t>(value)));
+    if (sizeof(T) == 8) value = static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(value)));
+#endif
+    std::memcpy(p, &value, sizeof(T));
+}
+
+template<typename T>
+inline void append_le(std::vector<uint8_t>& out, T value) {
+    size_t pos = out.size();
+    out.resize(pos + sizeof(T));
+    store_le<T>(out.data() + pos, value);
+}
+
+inline void append_bytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+/**
+ * LEB128 varints; signed values go through zigzag so small negatives stay short.
+ */
+const size_t MAX_VARINT_SIZE = 10;
+
+inline uint64_t zigzag_encode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline size_t varint_size(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+// Writes the varint at p and returns the position just past it
+inline uint8_t* write_varint(uint8_t* p, uint64_t value) {
+    while (value >= 0x80) {
+        *p++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *p++ = static_cast<uint8_t>(value);
+    return p;
+}
+
+inline void append_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * Bounds-checked cursor over a serialized buffer.
+ * Every read throws std::runtime_error instead of running past the end.
+ */
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size)
+        : pos_(data), end_(data + size) {}
+
+    explicit ByteReader(const std::vector<uint8_t>& data)
+        : ByteReader(data.data(), data.size()) {}
+
+    size_t remaining() const { return static_cast<size_t>(end_ - pos_); }
+    bool at_end() const { return pos_ == end_; }
+
+    template<typename T>
+    T read_le() {
+        require(sizeof(T));
+        T value = load_le<T>(pos_);
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    uint64_t read_varint() {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            require(1);
+            uint8_t byte = *pos_++;
+            // The tenth byte holds bit 63 only; anything above it would be dropped
+            if (shift == 63 && (byte & 0x7F) > 1) {
+                break;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Malformed varint in serialized data");
+    }
+
+    int64_t read_zigzag() {
+        return zigzag_decode(read_varint());
+    }
+
+    // Returns a pointer into the underlying buffer and advances past it
+    const uint8_t* read_bytes(size_t size) {
+        require(size);
+        const uint8_t* start = pos_;
+        pos_ += size;
+        return start;
+    }
+
+    std::string read_string(size_t size) {
+        const uint8_t* start = read_bytes(size);
+        return std::string(reinterpret_cast<const char*>(start), size);
+    }
+
+private:
+    const uint8_t* pos_;
+    const uint8_t* end_;
+
+    void require(size_t size) const {
+        if (size > remaining()) {
+            throw std::runtime_error("Unexpected end of serialized data");
+        }
+    }
+};
+
+} // namespace benchmark
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "common/cache_info.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <unistd.h>
+#include "common/benchmark_timing.h"
+
+namespace benchmark {
+
+namespace {
+    const size_t CACHE_LINE = 64;
+    const size_t MAX_EVICTION_BYTES = size_t(512) << 20;
+
+    void read_cache_size(int name, size_t& size) {
+        long value = sysconf(name);
+        if (value > 0) {
+            size = static_cast<size_t>(value);
+        }
+    }
+}
+
+CacheSizes detect_cache_sizes() {
+    CacheSizes sizes;
+    read_cache_size(_SC_LEVEL1_DCACHE_SIZE, sizes.l1d);
+    read_cache_size(_SC_LEVEL2_CACHE_SIZE, sizes.l2);
+    read_cache_size(_SC_LEVEL3_CACHE_SIZE, sizes.llc);
+    read_cache_size(_SC_LEVEL4_CACHE_SIZE, sizes.llc);
+    sizes.llc = std::max(sizes.llc, sizes.l2);
+    return sizes;
+}
+
+void evict_caches() {
+    thread_local std::vector<uint8_t> buffer(std::min(2 * detect_cache_sizes().llc, MAX_EVICTION_BYTES));
+    for (size_t i = 0; i < buffer.size(); i += CACHE_LINE) {
+        ++buffer[i];
+    }
+    clobber_memory();
+}
+
+} // namespace benchmark
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+namespace benchmark {
+
+/**
+ * Data cache capacities of the machine, in bytes
+ */
+struct CacheSizes {
+    size_t l1d = 32 * 1024;
+    size_t l2 = 1024 * 1024;
+    size_t llc = 32 * 1024 * 1024;   // Largest level reported
+};
+
+// From sysconf, keeping the defaults above for levels it does not report
+CacheSizes detect_cache_sizes();
+
+// Writes one byte per cache line of a buffer twice the LLC (capped at
+// 512 MiB), pushing earlier data out of every level. The buffer is
+// allocated on first use and kept per thread.
+void evict_caches();
+
+} // namespace benchmark
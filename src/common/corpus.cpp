@@ -0,0 +1,128 @@
+#include "common/corpus.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include "common/binary_encoding.h"
+
+namespace benchmark {
+
+namespace {
+    const uint32_t CORPUS_MAGIC = 0x31505243; // "CRP1"
+
+    void append_string(std::vector<uint8_t>& out, const std::string& value) {
+        append_varint(out, value.size());
+        append_bytes(out, value.data(), value.size());
+    }
+
+    std::string read_string(ByteReader& reader) {
+        return reader.read_string(reader.read_varint());
+    }
+}
+
+std::vector<uint8_t> encode_corpus(const Corpus& corpus) {
+    std::vector<uint8_t> out;
+    append_le<uint32_t>(out, CORPUS_MAGIC);
+
+    append_varint(out, corpus.metadata.size());
+    for (const auto& metadata : corpus.metadata) {
+        append_string(out, metadata.name);
+        append_string(out, metadata.path);
+        append_varint(out, metadata.size);
+        append_varint(out, zigzag_encode(metadata.created_at));
+        append_varint(out, zigzag_encode(metadata.last_modified));
+        append_varint(out, metadata.tags.size());
+        for (const auto& tag : metadata.tags) {
+            append_string(out, tag);
+        }
+        append_varint(out, metadata.permissions);
+        append_string(out, metadata.owner);
+        append_string(out, metadata.group);
+    }
+
+    append_varint(out, corpus.blocks.size());
+    for (const auto& block : corpus.blocks) {
+        append_string(out, block.block_id);
+        append_varint(out, block.offset);
+        out.push_back(static_cast<uint8_t>(block.checksum_algorithm));
+        append_le<uint64_t>(out, block.checksum);
+        append_varint(out, block.data.size());
+        append_bytes(out, block.data.data(), block.data.size());
+    }
+
+    return out;
+}
+
+Corpus decode_corpus(const std::vector<uint8_t>& data) {
+    return decode_corpus(data.data(), data.size());
+}
+
+Corpus decode_corpus(const uint8_t* data, size_t size) {
+    ByteReader reader(data, size);
+    if (reader.read_le<uint32_t>() != CORPUS_MAGIC) {
+        throw std::runtime_error("Invalid corpus magic");
+    }
+
+    Corpus corpus;
+    uint64_t metadata_count = reader.read_varint();
+    // Every record takes at least one byte per field, so a corrupt count
+    // cannot trigger a huge reservation
+    corpus.metadata.reserve(std::min<uint64_t>(metadata_count, reader.remaining()));
+    for (uint64_t i = 0; i < metadata_count; ++i) {
+        FileMetadata metadata;
+        metadata.name = read_string(reader);
+        metadata.path = read_string(reader);
+        metadata.size = reader.read_varint();
+        metadata.created_at = static_cast<time_t>(reader.read_zigzag());
+        metadata.last_modified = static_cast<time_t>(reader.read_zigzag());
+        uint64_t tag_count = reader.read_varint();
+        for (uint64_t t = 0; t < tag_count; ++t) {
+            metadata.tags.push_back(read_string(reader));
+        }
+        metadata.permissions = static_cast<uint32_t>(reader.read_varint());
+        metadata.owner = read_string(reader);
+        metadata.group = read_string(reader);
+        corpus.metadata.push_back(std::move(metadata));
+    }
+
+    uint64_t block_count = reader.read_varint();
+    corpus.blocks.reserve(std::min<uint64_t>(block_count, reader.remaining()));
+    for (uint64_t i = 0; i < block_count; ++i) {
+        FileBlock block;
+        block.block_id = read_string(reader);
+        block.offset = reader.read_varint();
+        block.checksum_algorithm = checksum_algorithm_from_value(reader.read_le<uint8_t>());
+        block.checksum = reader.read_le<uint64_t>();
+        uint64_t size = reader.read_varint();
+        const uint8_t* bytes = reader.read_bytes(size);
+        block.data.assign(bytes, bytes + size);
+        corpus.blocks.push_back(std::move(block));
+    }
+
+    if (!reader.at_end()) {
+        throw std::runtime_error("Trailing bytes after corpus");
+    }
+    return corpus;
+}
+
+void save_corpus(const Corpus& corpus, const std::string& path) {
+    std::vector<uint8_t> data = encode_corpus(corpus);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Cannot open corpus file for writing: " + path);
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        throw std::runtime_error("Failed to write corpus file: " + path);
+    }
+}
+
+Corpus load_corpus(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open corpus file: " + path);
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return decode_corpus(data);
+}
+
+} // namespace benchmark
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "common/data_structures.h"
+
+namespace benchmark {
+
+/**
+ * A set of benchmark inputs, generated or crawled, that can be saved and
+ * replayed so separate runs measure the same records.
+ */
+struct Corpus {
+    std::vector<FileMetadata> metadata;
+    std::vector<FileBlock> blocks;
+
+    bool operator==(const Corpus& other) const {
+        return metadata == other.metadata && blocks == other.blocks;
+    }
+};
+
+// Compact binary encoding: "CRP1", then varint-prefixed records
+std::vector<uint8_t> encode_corpus(const Corpus& corpus);
+
+// Throws std::runtime_error on a bad magic or truncated input
+Corpus decode_corpus(const std::vector<uint8_t>& data);
+Corpus decode_corpus(const uint8_t* data, size_t size);
+
+// File wrappers around encode_corpus/decode_corpus; throw std::runtime_error on I/O errors
+void save_corpus(const Corpus& corpus, const std::string& path);
+Corpus load_corpus(const std::string& path);
+
+} // namespace benchmark
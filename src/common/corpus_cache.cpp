@@ -0,0 +1,248 @@
+#include "common/corpus_cache.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "common/binary_encoding.h"
+#include "common/utilities.h"
+
+namespace benchmark {
+
+namespace {
+    const uint32_t CACHE_MAGIC = 0x31484343; // "CCH1"
+    const uint32_t CACHE_VERSION = 1;
+    const size_t HEADER_SIZE = 64;
+    const size_t DIRECTORY_ENTRY_SIZE = 64;
+    const size_t FORMAT_NAME_SIZE = 32;
+    const size_t TABLE_ENTRY_SIZE = 16;
+
+    size_t align8(size_t value) {
+        return (value + 7) & ~size_t(7);
+    }
+
+    void pad_to_alignment(std::vector<uint8_t>& out) {
+        out.resize(align8(out.size()), 0);
+    }
+
+    // Table of (offset, size) per record, then the encodings, each 8-byte aligned
+    std::vector<uint8_t> build_format_section(const Corpus& corpus, SerializerInterface& serializer) {
+        size_t entries = corpus.metadata.size() + corpus.blocks.size();
+        std::vector<uint8_t> section(entries * TABLE_ENTRY_SIZE, 0);
+
+        size_t entry = 0;
+        auto add = [&](const std::vector<uint8_t>& encoded) {
+            pad_to_alignment(section);
+            store_le<uint64_t>(section.data() + entry * TABLE_ENTRY_SIZE, section.size());
+            store_le<uint64_t>(section.data() + entry * TABLE_ENTRY_SIZE + 8, encoded.size());
+            append_bytes(section, encoded.data(), encoded.size());
+            ++entry;
+        };
+        for (const auto& metadata : corpus.metadata) {
+            add(serializer.serialize_metadata(metadata));
+        }
+        for (const auto& block : corpus.blocks) {
+            add(serializer.serialize_block(block));
+        }
+        pad_to_alignment(section);
+        return section;
+    }
+
+    void write_at(std::ofstream& file, uint64_t offset, const uint8_t* data, size_t size) {
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+}
+
+void CorpusCache::write(const std::string& path, const Corpus& corpus,
+                        const std::vector<SerializerInterface*>& serializers) {
+    for (SerializerInterface* serializer : serializers) {
+        if (serializer->format_name().size() >= FORMAT_NAME_SIZE) {
+            throw std::runtime_error("Format name too long for corpus cache: " + serializer->format_name());
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Cannot open corpus cache for writing: " + path);
+    }
+
+    // Sections are written first; the header and directory go in last, once
+    // every offset and hash is known. Only one format section is in memory at a time.
+    std::vector<uint8_t> directory(serializers.size() * DIRECTORY_ENTRY_SIZE, 0);
+    uint64_t position = HEADER_SIZE + directory.size();
+
+    std::vector<uint8_t> corpus_bytes = encode_corpus(corpus);
+    uint64_t corpus_offset = position;
+    uint64_t corpus_hash = xxhash64(corpus_bytes.data(), corpus_bytes.size());
+    write_at(file, corpus_offset, corpus_bytes.data(), corpus_bytes.size());
+    position = align8(corpus_offset + corpus_bytes.size());
+
+    for (size_t i = 0; i < serializers.size(); ++i) {
+        std::vector<uint8_t> section = build_format_section(corpus, *serializers[i]);
+        write_at(file, position, section.data(), section.size());
+
+        uint8_t* entry = directory.data() + i * DIRECTORY_ENTRY_SIZE;
+        std::string name = serializers[i]->format_name();
+        std::memcpy(entry, name.data(), name.size());
+        store_le<uint64_t>(entry + FORMAT_NAME_SIZE, position);
+        store_le<uint64_t>(entry + FORMAT_NAME_SIZE + 8, section.size());
+        store_le<uint64_t>(entry + FORMAT_NAME_SIZE + 16, xxhash64(section.data(), section.size()));
+        position += section.size();
+    }
+
+    uint8_t header[HEADER_SIZE] = {};
+    store_le<uint32_t>(header, CACHE_MAGIC);
+    store_le<uint32_t>(header + 4, CACHE_VERSION);
+    store_le<uint32_t>(header + 8, static_cast<uint32_t>(serializers.size()));
+    store_le<uint64_t>(header + 16, corpus.metadata.size());
+    store_le<uint64_t>(header + 24, corpus.blocks.size());
+    store_le<uint64_t>(header + 32, corpus_offset);
+    store_le<uint64_t>(header + 40, corpus_bytes.size());
+    store_le<uint64_t>(header + 48, corpus_hash);
+    write_at(file, 0, header, sizeof(header));
+    write_at(file, HEADER_SIZE, directory.data(), directory.size());
+
+    if (!file) {
+        throw std::runtime_error("Failed to write corpus cache: " + path);
+    }
+}
+
+CorpusCache::CorpusCache(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open corpus cache " + path + ": " + std::strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_SIZE) {
+        close(fd);
+        throw std::runtime_error("Corpus cache too small: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map corpus cache " + path + ": " + std::strerror(errno));
+    }
+    base_ = static_cast<const uint8_t*>(mapping);
+
+    // Past this point a throw must unmap, since the destructor will not run
+    try {
+        if (load_le<uint32_t>(base_) != CACHE_MAGIC) {
+            throw std::runtime_error("Invalid corpus cache magic: " + path);
+        }
+        if (load_le<uint32_t>(base_ + 4) != CACHE_VERSION) {
+            throw std::runtime_error("Unsupported corpus cache version: " + path);
+        }
+        uint32_t format_count = load_le<uint32_t>(base_ + 8);
+        metadata_count_ = load_le<uint64_t>(base_ + 16);
+        block_count_ = load_le<uint64_t>(base_ + 24);
+
+        auto checked_view = [this, &path](uint64_t offset, uint64_t size) {
+            if (offset > size_ || size > size_ - offset) {
+                throw std::runtime_error("Corpus cache section out of bounds: " + path);
+            }
+            return ByteView{base_ + offset, static_cast<size_t>(size)};
+        };
+        checked_view(HEADER_SIZE, static_cast<uint64_t>(format_count) * DIRECTORY_ENTRY_SIZE);
+        corpus_ = checked_view(load_le<uint64_t>(base_ + 32), load_le<uint64_t>(base_ + 40));
+        corpus_hash_ = load_le<uint64_t>(base_ + 48);
+
+        uint64_t entries = static_cast<uint64_t>(metadata_count_) + block_count_;
+        for (uint32_t i = 0; i < format_count; ++i) {
+            const uint8_t* entry = base_ + HEADER_SIZE + i * DIRECTORY_ENTRY_SIZE;
+            FormatSection format;
+            format.name.assign(reinterpret_cast<const char*>(entry),
+                               strnlen(reinterpret_cast<const char*>(entry), FORMAT_NAME_SIZE));
+            format.bytes = checked_view(load_le<uint64_t>(entry + FORMAT_NAME_SIZE),
+                                        load_le<uint64_t>(entry + FORMAT_NAME_SIZE + 8));
+            format.hash = load_le<uint64_t>(entry + FORMAT_NAME_SIZE + 16);
+            if (entries > format.bytes.size / TABLE_ENTRY_SIZE) {
+                throw std::runtime_error("Corpus cache table truncated: " + path);
+            }
+            sections_.push_back(std::move(format));
+        }
+    } catch (...) {
+        munmap(const_cast<uint8_t*>(base_), size_);
+        throw;
+    }
+
+    // Benchmarks start reading right away; let the kernel fault the file in ahead of them
+    madvise(const_cast<uint8_t*>(base_), size_, MADV_WILLNEED);
+}
+
+CorpusCache::~CorpusCache() {
+    munmap(const_cast<uint8_t*>(base_), size_);
+}
+
+Corpus CorpusCache::corpus() const {
+    return decode_corpus(corpus_.data, corpus_.size);
+}
+
+std::vector<std::string> CorpusCache::formats() const {
+    std::vector<std::string> names;
+    for (const auto& format : sections_) {
+        names.push_back(format.name);
+    }
+    return names;
+}
+
+bool CorpusCache::has_format(const std::string& format) const {
+    for (const auto& section : sections_) {
+        if (section.name == format) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const CorpusCache::FormatSection& CorpusCache::section(const std::string& format) const {
+    for (const auto& section : sections_) {
+        if (section.name == format) {
+            return section;
+        }
+    }
+    throw std::out_of_range("Format not in corpus cache: " + format);
+}
+
+ByteView CorpusCache::encoding(const std::string& format, size_t entry) const {
+    const FormatSection& format_section = section(format);
+    const uint8_t* table = format_section.bytes.data + entry * TABLE_ENTRY_SIZE;
+    uint64_t offset = load_le<uint64_t>(table);
+    uint64_t size = load_le<uint64_t>(table + 8);
+    if (offset > format_section.bytes.size || size > format_section.bytes.size - offset) {
+        throw std::runtime_error("Corpus cache entry out of bounds in format " + format);
+    }
+    return ByteView{format_section.bytes.data + offset, static_cast<size_t>(size)};
+}
+
+ByteView CorpusCache::metadata_encoding(const std::string& format, size_t index) const {
+    if (index >= metadata_count_) {
+        throw std::out_of_range("Metadata index out of range");
+    }
+    return encoding(format, index);
+}
+
+ByteView CorpusCache::block_encoding(const std::string& format, size_t index) const {
+    if (index >= block_count_) {
+        throw std::out_of_range("Block index out of range");
+    }
+    return encoding(format, metadata_count_ + index);
+}
+
+bool CorpusCache::verify() const {
+    if (xxhash64(corpus_.data, corpus_.size) != corpus_hash_) {
+        return false;
+    }
+    for (const auto& section : sections_) {
+        if (xxhash64(section.bytes.data, section.bytes.size) != section.hash) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace benchmark
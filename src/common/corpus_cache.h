@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "common/corpus.h"
+#include "common/serializer_interface.h"
+
+namespace benchmark {
+
+/**
+ * A byte range inside a mapped file; valid while the owning CorpusCache lives
+ */
+struct ByteView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    std::vector<uint8_t> to_vector() const {
+        return std::vector<uint8_t>(data, data + size);
+    }
+};
+
+/**
+ * Memory-mapped corpus file: the encoded Corpus plus, for every format it was
+ * written with, each metadata record and block already serialized.
+ *
+ * Layout (little-endian, sections 8-byte aligned):
+ *   header     (64 bytes) - "CCH1", version, format count, record counts,
+ *                            corpus section offset/size/xxHash64
+ *   directory  (64 bytes per format) - NUL-padded name, section offset/size/xxHash64
+ *   corpus     - encode_corpus() bytes
+ *   per format - (offset, size) pairs for metadata then blocks, then the
+ *                encodings, each starting on an 8-byte boundary
+ *
+ * Opening maps the file and checks the header and directory only, so startup
+ * cost does not grow with the corpus; verify() rehashes every section.
+ * All formats read their inputs from the one corpus section, so every format
+ * is benchmarked on byte-identical records.
+ */
+class CorpusCache {
+public:
+    // Serialize the corpus with each serializer and write a cache file.
+    // Throws std::runtime_error on I/O errors or a format name over 31 bytes.
+    static void write(const std::string& path, const Corpus& corpus,
+                      const std::vector<SerializerInterface*>& serializers);
+
+    // Map an existing cache file; throws std::runtime_error if it is missing or malformed
+    explicit CorpusCache(const std::string& path);
+    ~CorpusCache();
+
+    CorpusCache(const CorpusCache&) = delete;
+    CorpusCache& operator=(const CorpusCache&) = delete;
+
+    size_t metadata_count() const { return metadata_count_; }
+    size_t block_count() const { return block_count_; }
+    size_t file_size() const { return size_; }
+
+    // Decodes the records out of the mapping
+    Corpus corpus() const;
+    ByteView corpus_bytes() const { return corpus_; }
+
+    // xxHash64 of the corpus section, fixed when the file was written
+    uint64_t fingerprint() const { return corpus_hash_; }
+
+    std::vector<std::string> formats() const;
+    bool has_format(const std::string& format) const;
+
+    // Pre-serialized encodings; throw std::out_of_range for an unknown format
+    // or index and std::runtime_error if the entry points outside its section
+    ByteView metadata_encoding(const std::string& format, size_t index) const;
+    ByteView block_encoding(const std::string& format, size_t index) const;
+
+    // Rehash every section against the hashes stored at write time
+    bool verify() const;
+
+private:
+    struct FormatSection {
+        std::string name;
+        ByteView bytes;
+        uint64_t hash;
+    };
+
+    const uint8_t* base_ = nullptr;
+    size_t size_ = 0;
+    size_t metadata_count_ = 0;
+    size_t block_count_ = 0;
+    ByteView corpus_;
+    uint64_t corpus_hash_ = 0;
+    std::vector<FormatSection> sections_;
+
+    const FormatSection& section(const std::string& format) const;
+    ByteView encoding(const std::string& format, size_t entry) const;
+};
+
+} // namespace benchmark
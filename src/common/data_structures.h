@@ -60,17 +60,21 @@ struct FileBlock {
     std::string block_id;           // Unique block identifier
     uint64_t offset;                // Offset in original file
     std::vector<uint8_t> data;      // Actual block data
-    uint32_t checksum;              // Checksum for data integrity
+    uint64_t checksum;              // Checksum for data integrity
+    ChecksumAlgorithm checksum_algorithm; // Algorithm that produced checksum
     
     // Constructor with default values
     FileBlock()
         : block_id("")
         , offset(0)
         , checksum(0)
+        , checksum_algorithm(ChecksumAlgorithm::Adler32)
     {}
     
+    // False, not an exception, when checksum_algorithm is not a known algorithm
     bool validate_checksum() const {
-        return benchmark::calculate_checksum(data) == checksum;
+        return benchmark::is_checksum_algorithm(static_cast<uint64_t>(checksum_algorithm)) &&
+               benchmark::calculate_checksum(data, checksum_algorithm) == checksum;
     }
 
     // Check if two blocks are equal (for testing)
@@ -78,7 +82,8 @@ struct FileBlock {
         return block_id == other.block_id &&
                offset == other.offset &&
                data == other.data &&
-               checksum == other.checksum;
+               checksum == other.checksum &&
+               checksum_algorithm == other.checksum_algorithm;
     }
     
     // Check if two blocks are not equal
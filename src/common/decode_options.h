@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+#include "common/data_structures.h"
+
+namespace benchmark {
+
+/**
+ * How much checksum work a block decode does
+ */
+enum class VerificationMode {
+    Strict,    // Verify while decoding; a mismatch throws before the block is returned
+    Deferred,  // Decode only; verify on first access to the block
+    Trusted    // Never verify (intra-cluster traffic that is already integrity-protected)
+};
+
+struct DecodeOptions {
+    VerificationMode verification = VerificationMode::Strict;
+
+    DecodeOptions() = default;
+    DecodeOptions(VerificationMode mode) : verification(mode) {}
+};
+
+inline const char* verification_mode_name(VerificationMode mode) {
+    switch (mode) {
+        case VerificationMode::Strict:
+            return "strict";
+        case VerificationMode::Deferred:
+            return "deferred";
+        case VerificationMode::Trusted:
+            return "trusted";
+    }
+    return "unknown";
+}
+
+/**
+ * A decoded block plus the state of its checksum check.
+ * In deferred mode the check runs once, on the first call to verify() or
+ * block(); header fields can be read through unverified() without it.
+ */
+class DecodedBlock {
+public:
+    DecodedBlock(FileBlock block, VerificationMode mode)
+        : block_(std::move(block))
+        , mode_(mode)
+        , status_(mode == VerificationMode::Deferred ? Status::Pending
+                  : mode == VerificationMode::Strict ? Status::Verified
+                                                     : Status::Skipped) {}
+
+    VerificationMode mode() const { return mode_; }
+
+    // True once the checksum has been checked and matched
+    bool verified() const { return status_ == Status::Verified; }
+
+    // True while a deferred check has not run yet
+    bool pending() const { return status_ == Status::Pending; }
+
+    // Runs a pending check; throws std::runtime_error on mismatch (every time)
+    void verify() const {
+        if (status_ == Status::Pending) {
+            status_ = block_.validate_checksum() ? Status::Verified : Status::Failed;
+        }
+        if (status_ == Status::Failed) {
+            throw std::runtime_error("Checksum mismatch after deserialization");
+        }
+    }
+
+    // The block, verified first if the check is still pending
+    const FileBlock& block() const {
+        verify();
+        return block_;
+    }
+
+    // Moves the block out, verified first if the check is still pending
+    FileBlock release() {
+        verify();
+        return std::move(block_);
+    }
+
+    // The block without forcing a pending check
+    const FileBlock& unverified() const { return block_; }
+
+private:
+    enum class Status { Pending, Verified, Skipped, Failed };
+
+    FileBlock block_;
+    VerificationMode mode_;
+    mutable Status status_;
+};
+
+} // namespace benchmark
@@ -0,0 +1,140 @@
+#include "common/fast_random.h"
+#include <cmath>
+#include <cstring>
+#include "common/binary_encoding.h"
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__linux__)
+// One AVX2 clone plus the baseline build, resolved once at load time
+#define BULK_FILL_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define BULK_FILL_CLONES
+#endif
+
+namespace benchmark {
+
+namespace {
+    inline uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    // Writes blocks * 32 bytes; each lane contributes one 8-byte word per block.
+    // State is kept in locals so the compiler knows it does not alias out.
+    BULK_FILL_CLONES
+    void bulk_fill_blocks(uint64_t* s0_io, uint64_t* s1_io, uint64_t* s2_io, uint64_t* s3_io,
+                          uint8_t* out, size_t blocks) {
+        uint64_t s0[4], s1[4], s2[4], s3[4];
+        std::memcpy(s0, s0_io, sizeof(s0));
+        std::memcpy(s1, s1_io, sizeof(s1));
+        std::memcpy(s2, s2_io, sizeof(s2));
+        std::memcpy(s3, s3_io, sizeof(s3));
+
+        for (size_t b = 0; b < blocks; ++b) {
+            uint64_t result[4];
+            for (size_t lane = 0; lane < 4; ++lane) {
+                const uint64_t x5 = (s1[lane] << 2) + s1[lane];
+                const uint64_t r = rotl(x5, 7);
+                result[lane] = (r << 3) + r;
+                const uint64_t t = s1[lane] << 17;
+
+                s2[lane] ^= s0[lane];
+                s3[lane] ^= s1[lane];
+                s1[lane] ^= s2[lane];
+                s0[lane] ^= s3[lane];
+                s2[lane] ^= t;
+                s3[lane] = rotl(s3[lane], 45);
+            }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            for (size_t lane = 0; lane < 4; ++lane) {
+                result[lane] = __builtin_bswap64(result[lane]);
+            }
+#endif
+            std::memcpy(out + b * 32, result, sizeof(result));
+        }
+
+        std::memcpy(s0_io, s0, sizeof(s0));
+        std::memcpy(s1_io, s1, sizeof(s1));
+        std::memcpy(s2_io, s2, sizeof(s2));
+        std::memcpy(s3_io, s3, sizeof(s3));
+    }
+}
+
+Xoshiro256StarStar::Xoshiro256StarStar(uint64_t seed) {
+    uint64_t sm = seed;
+    for (auto& word : state_) {
+        word = splitmix64(sm);
+    }
+}
+
+void Xoshiro256StarStar::jump() {
+    static const uint64_t JUMP[] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+        0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (uint64_t word : JUMP) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (word & (uint64_t(1) << bit)) {
+                s0 ^= state_[0];
+                s1 ^= state_[1];
+                s2 ^= state_[2];
+                s3 ^= state_[3];
+            }
+            (*this)();
+        }
+    }
+
+    state_[0] = s0;
+    state_[1] = s1;
+    state_[2] = s2;
+    state_[3] = s3;
+}
+
+void Xoshiro256StarStar::fill(uint8_t* out, size_t size) {
+    for (; size >= 8; out += 8, size -= 8) {
+        store_le<uint64_t>(out, (*this)());
+    }
+    if (size > 0) {
+        uint8_t tail[8];
+        store_le<uint64_t>(tail, (*this)());
+        std::memcpy(out, tail, size);
+    }
+}
+
+BulkRandomGenerator::BulkRandomGenerator(uint64_t seed) {
+    // Lane i starts i jumps (i * 2^128 steps) into the seed's stream
+    Xoshiro256StarStar stream(seed);
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        s0_[lane] = stream.state_[0];
+        s1_[lane] = stream.state_[1];
+        s2_[lane] = stream.state_[2];
+        s3_[lane] = stream.state_[3];
+        stream.jump();
+    }
+}
+
+void BulkRandomGenerator::fill(uint8_t* out, size_t size) {
+    size_t blocks = size / 32;
+    bulk_fill_blocks(s0_, s1_, s2_, s3_, out, blocks);
+
+    size_t rest = size % 32;
+    if (rest > 0) {
+        uint8_t tail[32];
+        bulk_fill_blocks(s0_, s1_, s2_, s3_, tail, 1);
+        std::memcpy(out + blocks * 32, tail, rest);
+    }
+}
+
+ZipfDistribution::ZipfDistribution(size_t n, double exponent)
+    : cdf_(std::max<size_t>(n, 1)) {
+    double total = 0.0;
+    for (size_t k = 0; k < cdf_.size(); ++k) {
+        total += 1.0 / std::pow(static_cast<double>(k + 1), exponent);
+        cdf_[k] = total;
+    }
+    for (double& c : cdf_) {
+        c /= total;
+    }
+}
+
+} // namespace benchmark
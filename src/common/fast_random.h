@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace benchmark {
+
+/**
+ * SplitMix64, used to expand a single seed into generator state
+ */
+inline uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * xoshiro256** (Blackman & Vigna). Satisfies UniformRandomBitGenerator, so it
+ * can drive the standard distributions; one step yields 64 random bits.
+ */
+class Xoshiro256StarStar {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256StarStar(uint64_t seed = 0);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+
+        return result;
+    }
+
+    // Advance by 2^128 steps; successive jumps give non-overlapping substreams
+    void jump();
+
+    // Fill size bytes, 8 per step, little-endian regardless of host
+    void fill(uint8_t* out, size_t size);
+
+private:
+    friend class BulkRandomGenerator;
+
+    uint64_t state_[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+/**
+ * Bulk byte generator: four xoshiro256** streams (2^128 steps apart) run in
+ * lockstep, producing 32 bytes per step. The lanes are independent, so the
+ * step vectorizes; an AVX2 clone is picked at runtime where available.
+ * Output depends only on the seed and the sequence of fill() sizes.
+ */
+class BulkRandomGenerator {
+public:
+    explicit BulkRandomGenerator(uint64_t seed = 0);
+
+    void fill(uint8_t* out, size_t size);
+
+private:
+    static const size_t LANES = 4;
+
+    // Structure-of-arrays: s0_[lane] is word 0 of each lane's state
+    alignas(32) uint64_t s0_[LANES];
+    alignas(32) uint64_t s1_[LANES];
+    alignas(32) uint64_t s2_[LANES];
+    alignas(32) uint64_t s3_[LANES];
+};
+
+/**
+ * Zipf distribution over ranks 0..n-1: P(k) is proportional to 1 / (k + 1)^exponent.
+ * An exponent of 0 is uniform. Sampling is a binary search in a precomputed CDF,
+ * so it suits the small populations the data generator draws from.
+ */
+class ZipfDistribution {
+public:
+    explicit ZipfDistribution(size_t n = 1, double exponent = 0.0);
+
+    size_t size() const { return cdf_.size(); }
+
+    template <typename Generator>
+    size_t operator()(Generator& rng) const {
+        double u = std::generate_canonical<double, std::numeric_limits<double>::digits>(rng);
+        size_t rank = std::upper_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin();
+        return std::min(rank, cdf_.size() - 1);
+    }
+
+private:
+    std::vector<double> cdf_;
+};
+
+} // namespace benchmark
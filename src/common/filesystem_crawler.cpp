@@ -0,0 +1,535 @@
+#include "common/filesystem_crawler.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <grp.h>
+#include <pwd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <dirent.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#include "common/binary_encoding.h"
+
+namespace benchmark {
+
+namespace {
+    // The fields the walker needs, from statx or fstatat
+    struct EntryStat {
+        uint32_t mode;
+        uint64_t size;
+        uint32_t uid;
+        uint32_t gid;
+        int64_t created;   // Birth time where the filesystem records it, else ctime
+        int64_t modified;
+        uint64_t device;
+    };
+
+    // An empty name stats dir_fd itself
+    bool stat_entry(int dir_fd, const char* name, EntryStat& out) {
+#if defined(__linux__) && defined(STATX_BASIC_STATS)
+        struct statx stx;
+        int flags = AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT | AT_STATX_DONT_SYNC;
+        if (name[0] == '\0') {
+            flags |= AT_EMPTY_PATH;
+        }
+        if (statx(dir_fd, name, flags, STATX_BASIC_STATS | STATX_BTIME, &stx) != 0) {
+            return false;
+        }
+        out.mode = stx.stx_mode;
+        out.size = stx.stx_size;
+        out.uid = stx.stx_uid;
+        out.gid = stx.stx_gid;
+        out.created = (stx.stx_mask & STATX_BTIME) ? stx.stx_btime.tv_sec : stx.stx_ctime.tv_sec;
+        out.modified = stx.stx_mtime.tv_sec;
+        out.device = (static_cast<uint64_t>(stx.stx_dev_major) << 32) | stx.stx_dev_minor;
+#else
+        struct stat st;
+        if ((name[0] == '\0' ? fstat(dir_fd, &st) : fstatat(dir_fd, name, &st, AT_SYMLINK_NOFOLLOW)) != 0) {
+            return false;
+        }
+        out.mode = st.st_mode;
+        out.size = static_cast<uint64_t>(st.st_size);
+        out.uid = st.st_uid;
+        out.gid = st.st_gid;
+        out.created = st.st_ctime;
+        out.modified = st.st_mtime;
+        out.device = static_cast<uint64_t>(st.st_dev);
+#endif
+        return true;
+    }
+
+    // Entry types as reported by the directory listing
+    enum class EntryType { Directory, Regular, Symlink, Other, Unknown };
+
+    // Calls visit(name, type) for every entry except "." and "..";
+    // returns false if the directory could not be read
+    template<typename Visit>
+    bool list_directory(int dir_fd, Visit&& visit) {
+#if defined(__linux__)
+        // struct linux_dirent64: u64 ino, s64 off, u16 reclen @16, u8 type @18, name @19
+        alignas(8) uint8_t buffer[32 * 1024];
+        for (;;) {
+            long count = syscall(SYS_getdents64, dir_fd, buffer, sizeof(buffer));
+            if (count < 0) {
+                return false;
+            }
+            if (count == 0) {
+                return true;
+            }
+            for (long pos = 0; pos < count;) {
+                const uint8_t* entry = buffer + pos;
+                pos += load_le<uint16_t>(entry + 16);
+                const char* name = reinterpret_cast<const char*>(entry + 19);
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                    continue;
+                }
+                EntryType type = EntryType::Unknown;
+                switch (entry[18]) {
+                    case DT_DIR: type = EntryType::Directory; break;
+                    case DT_REG: type = EntryType::Regular; break;
+                    case DT_LNK: type = EntryType::Symlink; break;
+                    case DT_UNKNOWN: type = EntryType::Unknown; break;
+                    default: type = EntryType::Other; break;
+                }
+                visit(name, type);
+            }
+        }
+#else
+        int listing_fd = dup(dir_fd);
+        DIR* dir = listing_fd < 0 ? nullptr : fdopendir(listing_fd);
+        if (dir == nullptr) {
+            if (listing_fd >= 0) {
+                close(listing_fd);
+            }
+            return false;
+        }
+        while (struct dirent* entry = readdir(dir)) {
+            const char* name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                continue;
+            }
+            visit(name, EntryType::Unknown);
+        }
+        closedir(dir);
+        return true;
+#endif
+    }
+
+    // Closes a directory once no queued subdirectory still needs it to open from
+    struct DirectoryFd {
+        explicit DirectoryFd(int fd) : fd(fd) {}
+        ~DirectoryFd() { close(fd); }
+        DirectoryFd(const DirectoryFd&) = delete;
+        DirectoryFd& operator=(const DirectoryFd&) = delete;
+
+        const int fd;
+    };
+
+    // A directory to list, opened relative to its parent so that a path
+    // component swapped for a symlink after the parent was listed is not followed
+    struct PendingDirectory {
+        std::shared_ptr<const DirectoryFd> parent;
+        std::string name;
+        std::string path;
+    };
+
+    /**
+     * Directories waiting to be listed. pop() blocks while the queue is empty
+     * but another worker may still add to it, and returns false once the walk
+     * is finished or stopped.
+     */
+    class DirectoryQueue {
+    public:
+        void push(PendingDirectory directory) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!stopped_) {
+                pending_.push_back(std::move(directory));
+                ready_.notify_one();
+            }
+        }
+
+        bool pop(PendingDirectory& directory) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return stopped_ || !pending_.empty() || active_ == 0; });
+            if (stopped_ || pending_.empty()) {
+                return false;
+            }
+            // Newest first keeps the queue short on wide trees
+            directory = std::move(pending_.back());
+            pending_.pop_back();
+            ++active_;
+            return true;
+        }
+
+        // Called when a popped directory has been fully listed
+        void finish() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_ == 0 && pending_.empty()) {
+                ready_.notify_all();
+            }
+        }
+
+        void stop() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+            pending_.clear();
+            ready_.notify_all();
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::vector<PendingDirectory> pending_;
+        size_t active_ = 0;
+        bool stopped_ = false;
+    };
+
+    // Opens a directory below root one component at a time, never following
+    // a symlink; an empty relative path is root itself. Null on failure.
+    std::shared_ptr<const DirectoryFd> open_below(const std::shared_ptr<const DirectoryFd>& root,
+                                                  const std::string& relative) {
+        std::shared_ptr<const DirectoryFd> dir = root;
+        size_t start = 0;
+        while (start < relative.size()) {
+            size_t end = relative.find('/', start);
+            if (end == std::string::npos) {
+                end = relative.size();
+            }
+            std::string component = relative.substr(start, end - start);
+            int fd = openat(dir->fd, component.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+            if (fd < 0) {
+                return nullptr;
+            }
+            dir = std::make_shared<const DirectoryFd>(fd);
+            start = end + 1;
+        }
+        return dir;
+    }
+
+    std::string join_path(const std::string& dir, const char* name) {
+        std::string path = dir;
+        if (path.empty() || path.back() != '/') {
+            path += '/';
+        }
+        path += name;
+        return path;
+    }
+
+    std::string lowercase_extension(const std::string& name) {
+        size_t dot = name.rfind('.');
+        if (dot == std::string::npos || dot == 0 || dot + 1 == name.size()) {
+            return std::string();
+        }
+        std::string extension = name.substr(dot + 1);
+        for (char& c : extension) {
+            if (c >= 'A' && c <= 'Z') {
+                c = static_cast<char>(c - 'A' + 'a');
+            }
+        }
+        return extension;
+    }
+
+    // Per-worker uid/gid -> name lookups; unknown ids become their decimal form
+    class NameCache {
+    public:
+        const std::string& user(uint32_t uid) {
+            auto it = users_.find(uid);
+            if (it != users_.end()) {
+                return it->second;
+            }
+            struct passwd entry;
+            struct passwd* result = nullptr;
+            char buffer[4096];
+            std::string name = (getpwuid_r(uid, &entry, buffer, sizeof(buffer), &result) == 0 && result)
+                ? std::string(result->pw_name) : std::to_string(uid);
+            return users_.emplace(uid, std::move(name)).first->second;
+        }
+
+        const std::string& group(uint32_t gid) {
+            auto it = groups_.find(gid);
+            if (it != groups_.end()) {
+                return it->second;
+            }
+            struct group entry;
+            struct group* result = nullptr;
+            char buffer[4096];
+            std::string name = (getgrgid_r(gid, &entry, buffer, sizeof(buffer), &result) == 0 && result)
+                ? std::string(result->gr_name) : std::to_string(gid);
+            return groups_.emplace(gid, std::move(name)).first->second;
+        }
+
+    private:
+        std::unordered_map<uint32_t, std::string> users_;
+        std::unordered_map<uint32_t, std::string> groups_;
+    };
+
+    unsigned resolve_threads(unsigned threads) {
+        return threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads;
+    }
+
+    // Runs work(0) here and work(1..count-1) on new threads, then rethrows
+    // the first exception any of them threw
+    template<typename Work>
+    void run_workers(unsigned count, Work&& work) {
+        std::vector<std::exception_ptr> errors(count);
+        auto guarded = [&](unsigned i) {
+            try {
+                work(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(count - 1);
+        for (unsigned i = 1; i < count; ++i) {
+            workers.emplace_back(guarded, i);
+        }
+        guarded(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
+
+FilesystemCrawler::FilesystemCrawler(const CrawlOptions& options)
+    : options_(options) {
+}
+
+Corpus FilesystemCrawler::crawl(const std::string& root) {
+    stats_ = CrawlStats();
+
+    std::string root_path = root;
+    while (root_path.size() > 1 && root_path.back() == '/') {
+        root_path.pop_back();
+    }
+
+    // The root alone may be a symlink; nothing below it is followed
+    int root_fd = open(root_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (root_fd < 0) {
+        throw std::runtime_error("Cannot crawl " + root + ": " +
+                                 (errno == ENOTDIR ? "not a directory" : std::strerror(errno)));
+    }
+    auto root_dir = std::make_shared<const DirectoryFd>(root_fd);
+    EntryStat root_stat;
+    if (!stat_entry(root_dir->fd, "", root_stat)) {
+        throw std::runtime_error("Cannot crawl " + root + ": " + std::strerror(errno));
+    }
+
+    unsigned threads = resolve_threads(options_.threads);
+    DirectoryQueue queue;
+    std::atomic<size_t> file_budget(0);
+    std::vector<std::vector<FileMetadata>> found(threads);
+    std::vector<CrawlStats> worker_stats(threads);
+
+    queue.push(PendingDirectory{root_dir, ".", root_path});
+    run_workers(threads, [&](unsigned worker) {
+        NameCache names;
+        CrawlStats& stats = worker_stats[worker];
+        std::vector<FileMetadata>& files = found[worker];
+
+        PendingDirectory pending;
+        try {
+            while (queue.pop(pending)) {
+                int fd = openat(pending.parent->fd, pending.name.c_str(),
+                                O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                pending.parent.reset();
+                if (fd < 0) {
+                    ++stats.skipped;
+                    queue.finish();
+                    continue;
+                }
+                auto dir = std::make_shared<const DirectoryFd>(fd);
+                const std::string& dir_path = pending.path;
+                ++stats.directories;
+
+                bool listed = list_directory(dir->fd, [&](const char* name, EntryType type) {
+                    if (type == EntryType::Symlink || type == EntryType::Other) {
+                        return;
+                    }
+                    if (type == EntryType::Directory && options_.cross_devices) {
+                        queue.push(PendingDirectory{dir, name, join_path(dir_path, name)});
+                        return;
+                    }
+
+                    EntryStat entry;
+                    if (!stat_entry(dir->fd, name, entry)) {
+                        ++stats.skipped;
+                        return;
+                    }
+                    if (S_ISDIR(entry.mode)) {
+                        if (options_.cross_devices || entry.device == root_stat.device) {
+                            queue.push(PendingDirectory{dir, name, join_path(dir_path, name)});
+                        }
+                        return;
+                    }
+                    if (!S_ISREG(entry.mode)) {
+                        return;
+                    }
+                    if (options_.max_files > 0 && file_budget.fetch_add(1) >= options_.max_files) {
+                        queue.stop();
+                        return;
+                    }
+
+                    FileMetadata metadata;
+                    metadata.name = name;
+                    metadata.path = join_path(dir_path, name);
+                    metadata.size = entry.size;
+                    metadata.created_at = static_cast<time_t>(entry.created);
+                    metadata.last_modified = static_cast<time_t>(entry.modified);
+                    std::string extension = lowercase_extension(metadata.name);
+                    if (!extension.empty()) {
+                        metadata.tags.push_back(std::move(extension));
+                    }
+                    metadata.permissions = entry.mode & 07777;
+                    metadata.owner = names.user(entry.uid);
+                    metadata.group = names.group(entry.gid);
+                    files.push_back(std::move(metadata));
+                    ++stats.files;
+                });
+                if (!listed) {
+                    ++stats.skipped;
+                }
+
+                queue.finish();
+            }
+        } catch (...) {
+            // Unblocks the other workers; run_workers rethrows
+            queue.stop();
+            throw;
+        }
+    });
+
+    Corpus corpus;
+    for (size_t i = 0; i < threads; ++i) {
+        stats_.directories += worker_stats[i].directories;
+        stats_.files += worker_stats[i].files;
+        stats_.skipped += worker_stats[i].skipped;
+        corpus.metadata.insert(corpus.metadata.end(),
+                               std::make_move_iterator(found[i].begin()),
+                               std::make_move_iterator(found[i].end()));
+    }
+    std::sort(corpus.metadata.begin(), corpus.metadata.end(),
+              [](const FileMetadata& a, const FileMetadata& b) { return a.path < b.path; });
+
+    if (options_.block_size == 0) {
+        return corpus;
+    }
+
+    // Plan payload bytes per file in path order, so the cap picks the same files
+    // regardless of threads, then read files in parallel into per-file slots
+    std::vector<uint64_t> planned(corpus.metadata.size());
+    uint64_t budget = options_.max_block_bytes > 0 ? options_.max_block_bytes : UINT64_MAX;
+    for (size_t i = 0; i < planned.size() && budget > 0; ++i) {
+        planned[i] = std::min(corpus.metadata[i].size, budget);
+        budget -= planned[i];
+    }
+
+    std::vector<std::vector<FileBlock>> per_file(corpus.metadata.size());
+    std::atomic<size_t> next_file(0);
+    std::atomic<size_t> skipped(0);
+    std::atomic<uint64_t> bytes_read(0);
+    // Files are reopened relative to their directory, reached from the root fd
+    // the walk used, so a path component swapped for a symlink since the walk
+    // is not followed. Paths are sorted, so each worker mostly reuses the
+    // directory it opened for the previous file.
+    size_t root_prefix = root_path.size() + (root_path.back() == '/' ? 0 : 1);
+    run_workers(std::min<size_t>(threads, std::max<size_t>(per_file.size(), 1)), [&](unsigned) {
+        std::string parent_path;
+        std::shared_ptr<const DirectoryFd> parent;
+        for (size_t i = next_file++; i < per_file.size(); i = next_file++) {
+            if (planned[i] == 0) {
+                continue;
+            }
+            const std::string& path = corpus.metadata[i].path;
+            size_t slash = path.rfind('/');
+            std::string relative = slash > root_prefix ? path.substr(root_prefix, slash - root_prefix)
+                                                       : std::string();
+            if (!parent || relative != parent_path) {
+                parent = open_below(root_dir, relative);
+                parent_path = relative;
+            }
+            // O_NONBLOCK keeps a file replaced by a FIFO from blocking the open
+            int fd = parent ? openat(parent->fd, corpus.metadata[i].name.c_str(),
+                                     O_RDONLY | O_NOFOLLOW | O_NONBLOCK | O_CLOEXEC)
+                            : -1;
+            if (fd < 0) {
+                ++skipped;
+                continue;
+            }
+            struct stat st;
+            if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+                close(fd);
+                ++skipped;
+                continue;
+            }
+
+            char id_prefix[24];
+            std::snprintf(id_prefix, sizeof(id_prefix), "%016llx-",
+                          static_cast<unsigned long long>(
+                              xxhash64(reinterpret_cast<const uint8_t*>(path.data()), path.size())));
+
+            uint64_t offset = 0;
+            while (offset < planned[i]) {
+                FileBlock block;
+                block.data.resize(static_cast<size_t>(
+                    std::min<uint64_t>(options_.block_size, planned[i] - offset)));
+                size_t filled = 0;
+                while (filled < block.data.size()) {
+                    ssize_t n = pread(fd, block.data.data() + filled, block.data.size() - filled,
+                                      static_cast<off_t>(offset + filled));
+                    if (n < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (n <= 0) {
+                        break;
+                    }
+                    filled += static_cast<size_t>(n);
+                }
+                if (filled == 0) {
+                    break;  // The file shrank since it was stat'ed
+                }
+                block.data.resize(filled);
+                block.block_id = id_prefix + std::to_string(per_file[i].size());
+                block.offset = offset;
+                block.checksum_algorithm = options_.checksum_algorithm;
+                block.checksum = calculate_checksum(block.data, options_.checksum_algorithm);
+                bytes_read += filled;
+                offset += filled;
+                per_file[i].push_back(std::move(block));
+                if (filled < options_.block_size) {
+                    break;
+                }
+            }
+            close(fd);
+        }
+    });
+
+    stats_.skipped += skipped;
+    stats_.bytes_read = bytes_read;
+    for (auto& blocks : per_file) {
+        corpus.blocks.insert(corpus.blocks.end(),
+                             std::make_move_iterator(blocks.begin()),
+                             std::make_move_iterator(blocks.end()));
+    }
+    return corpus;
+}
+
+} // namespace benchmark
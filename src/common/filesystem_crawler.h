@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "common/corpus.h"
+#include "common/utilities.h"
+
+namespace benchmark {
+
+struct CrawlOptions {
+    unsigned threads = 0;           // Walker threads; 0 uses all cores
+    bool cross_devices = false;     // Descend into other mounted filesystems
+    size_t max_files = 0;           // Stop after this many files (0 = no limit)
+
+    // Chunk file contents into blocks of this size (0 = metadata only)
+    size_t block_size = 0;
+    uint64_t max_block_bytes = 0;   // Total payload cap across all blocks (0 = no limit)
+    ChecksumAlgorithm checksum_algorithm = ChecksumAlgorithm::Adler32;
+};
+
+struct CrawlStats {
+    size_t directories = 0;
+    size_t files = 0;
+    size_t skipped = 0;             // Entries that could not be opened or stat'ed
+    uint64_t bytes_read = 0;        // Payload bytes read into blocks
+};
+
+/**
+ * Turns a local directory tree into a Corpus, as an alternative to
+ * TestDataGenerator when benchmarks should see a real namespace.
+ *
+ * Directories are walked in parallel: each worker takes a directory from a
+ * shared queue, opens it with openat relative to its parent's fd, lists it
+ * with getdents64 and stats entries with statx relative to the directory fd,
+ * queueing subdirectories as it finds them. The root is followed if it is a
+ * symlink; below it, symlinks are recorded as neither files nor directories
+ * and are never followed. Only regular files become FileMetadata; each is
+ * tagged with its lowercase extension. Records are sorted by path, so the result does not depend on the
+ * thread count (except which files make the cut when max_files is hit).
+ *
+ * Block contents are read the same way: each file is opened with openat
+ * relative to its directory, reached from the root fd one component at a
+ * time, and is skipped if it is no longer a regular file.
+ *
+ * Unreadable entries are counted in CrawlStats::skipped; only an unreadable
+ * root throws std::runtime_error. An exception on a worker thread stops the
+ * walk and is rethrown from crawl().
+ */
+class FilesystemCrawler {
+public:
+    explicit FilesystemCrawler(const CrawlOptions& options = CrawlOptions());
+
+    Corpus crawl(const std::string& root);
+
+    // Counters from the last crawl
+    const CrawlStats& stats() const { return stats_; }
+
+private:
+    CrawlOptions options_;
+    CrawlStats stats_;
+};
+
+} // namespace benchmark
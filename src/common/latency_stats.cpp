@@ -0,0 +1,192 @@
+#include "common/latency_stats.h"
+#include <algorithm>
+#include <cmath>
+#include "common/fast_random.h"
+
+namespace benchmark {
+
+namespace {
+    const unsigned SUB_BUCKET_BITS = 7;
+    const uint64_t SUB_BUCKET_COUNT = uint64_t(1) << SUB_BUCKET_BITS;      // 128
+    const uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;                 // 64
+
+    size_t bucket_index(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(value));
+        unsigned shift = exponent - SUB_BUCKET_BITS + 1;
+        uint64_t sub_bucket = value >> shift;  // In [64, 128)
+        return static_cast<size_t>(SUB_BUCKET_COUNT + (exponent - SUB_BUCKET_BITS) * SUB_BUCKET_HALF +
+                                   (sub_bucket - SUB_BUCKET_HALF));
+    }
+
+    // Lowest value and width of a bucket
+    std::pair<uint64_t, uint64_t> bucket_range(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return {index, 1};
+        }
+        uint64_t above = index - SUB_BUCKET_COUNT;
+        unsigned shift = static_cast<unsigned>(above / SUB_BUCKET_HALF) + 1;
+        uint64_t sub_bucket = SUB_BUCKET_HALF + above % SUB_BUCKET_HALF;
+        return {sub_bucket << shift, uint64_t(1) << shift};
+    }
+}
+
+void LatencyHistogram::record(uint64_t value_ns) {
+    size_t index = bucket_index(value_ns);
+    if (index >= counts_.size()) {
+        counts_.resize(index + 1, 0);
+    }
+    ++counts_[index];
+
+    min_ = count_ == 0 ? value_ns : std::min(min_, value_ns);
+    max_ = std::max(max_, value_ns);
+    ++count_;
+    double value = static_cast<double>(value_ns);
+    sum_ += value;
+    sum_squares_ += value * value;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (other.counts_.size() > counts_.size()) {
+        counts_.resize(other.counts_.size(), 0);
+    }
+    for (size_t i = 0; i < other.counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    min_ = count_ == 0 ? other.min_ : std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    count_ += other.count_;
+    sum_ += other.sum_;
+    sum_squares_ += other.sum_squares_;
+}
+
+double LatencyHistogram::mean() const {
+    return count_ ? sum_ / static_cast<double>(count_) : 0.0;
+}
+
+double LatencyHistogram::stddev() const {
+    if (count_ < 2) {
+        return 0.0;
+    }
+    double n = static_cast<double>(count_);
+    double variance = (sum_squares_ - sum_ * sum_ / n) / (n - 1);
+    return variance > 0.0 ? std::sqrt(variance) : 0.0;
+}
+
+uint64_t LatencyHistogram::value_at_percentile(double percentile) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    // Rank of the requested sample, 1-based, as in HDR Histogram
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count_)));
+    rank = std::max<uint64_t>(rank, 1);
+    if (rank >= count_) {
+        return max_;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            auto range = bucket_range(i);
+            uint64_t midpoint = range.first + range.second / 2;
+            return std::min(std::max(midpoint, min_), max_);
+        }
+    }
+    return max_;
+}
+
+std::vector<std::pair<uint64_t, uint64_t>> LatencyHistogram::nonempty_buckets() const {
+    std::vector<std::pair<uint64_t, uint64_t>> buckets;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        if (counts_[i] > 0) {
+            buckets.emplace_back(bucket_range(i).first, counts_[i]);
+        }
+    }
+    return buckets;
+}
+
+double trimmed_mean(std::vector<double> samples_ms) {
+    if (samples_ms.empty()) {
+        return 0.0;
+    }
+    std::sort(samples_ms.begin(), samples_ms.end());
+    size_t outliers = samples_ms.size() / 10;
+    double total = 0.0;
+    for (size_t i = outliers; i < samples_ms.size() - outliers; ++i) {
+        total += samples_ms[i];
+    }
+    return total / static_cast<double>(samples_ms.size() - 2 * outliers);
+}
+
+LatencyStats summarize_latencies(const std::vector<double>& samples_ms,
+                                 const LatencyHistogram& histogram,
+                                 double confidence,
+                                 size_t resamples) {
+    const double NS_PER_MS = 1e6;
+
+    LatencyStats stats;
+    stats.samples = samples_ms.size();
+    stats.min_ms = histogram.min() / NS_PER_MS;
+    stats.p50_ms = histogram.value_at_percentile(50.0) / NS_PER_MS;
+    stats.p90_ms = histogram.value_at_percentile(90.0) / NS_PER_MS;
+    stats.p99_ms = histogram.value_at_percentile(99.0) / NS_PER_MS;
+    stats.p999_ms = histogram.value_at_percentile(99.9) / NS_PER_MS;
+    stats.max_ms = histogram.max() / NS_PER_MS;
+    stats.mean_ms = histogram.mean() / NS_PER_MS;
+    stats.stddev_ms = histogram.stddev() / NS_PER_MS;
+    stats.trimmed_mean_ms = trimmed_mean(samples_ms);
+    stats.ci_low_ms = stats.ci_high_ms = stats.trimmed_mean_ms;
+
+    size_t n = samples_ms.size();
+    if (n < 2 || resamples == 0) {
+        return stats;
+    }
+
+    // A resample is a multiset of sorted indices, so its trimmed mean is one
+    // ordered walk over the counts; no per-resample sort is needed
+    std::vector<double> sorted(samples_ms);
+    std::sort(sorted.begin(), sorted.end());
+    size_t outliers = n / 10;
+    size_t kept = n - 2 * outliers;
+
+    Xoshiro256StarStar rng(0x5EED);
+    std::vector<uint32_t> picks(n);
+    std::vector<double> estimates;
+    estimates.reserve(resamples);
+    for (size_t r = 0; r < resamples; ++r) {
+        std::fill(picks.begin(), picks.end(), 0);
+        for (size_t i = 0; i < n; ++i) {
+            ++picks[rng() % n];
+        }
+
+        size_t to_skip = outliers;
+        size_t to_take = kept;
+        double total = 0.0;
+        for (size_t i = 0; i < n && to_take > 0; ++i) {
+            size_t copies = picks[i];
+            size_t skipped = std::min(copies, to_skip);
+            to_skip -= skipped;
+            size_t taken = std::min(copies - skipped, to_take);
+            to_take -= taken;
+            total += sorted[i] * static_cast<double>(taken);
+        }
+        estimates.push_back(total / static_cast<double>(kept));
+    }
+
+    std::sort(estimates.begin(), estimates.end());
+    double tail = (1.0 - confidence) / 2.0;
+    size_t low = static_cast<size_t>(tail * static_cast<double>(resamples - 1));
+    size_t high = static_cast<size_t>(std::ceil((1.0 - tail) * static_cast<double>(resamples - 1)));
+    stats.ci_low_ms = estimates[low];
+    stats.ci_high_ms = estimates[std::min(high, resamples - 1)];
+    return stats;
+}
+
+} // namespace benchmark
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace benchmark {
+
+/**
+ * HDR-style log-linear histogram of latencies in nanoseconds.
+ *
+ * Values below 128 get one bucket each; above that every power of two is
+ * split into 64 equal buckets, so a recorded value is known to within 1/64
+ * (about 1.6%) of itself at any magnitude. Buckets are allocated up to the
+ * largest value seen, a few KiB for benchmark-scale latencies.
+ */
+class LatencyHistogram {
+public:
+    void record(uint64_t value_ns);
+
+    // Adds another histogram's counts, e.g. from other threads or runs
+    void merge(const LatencyHistogram& other);
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const;
+    double stddev() const;  // Sample standard deviation
+
+    // Midpoint of the bucket holding the given percentile (0-100), clamped to
+    // [min, max]; the top rank returns the exact max
+    uint64_t value_at_percentile(double percentile) const;
+
+    // (lowest value in bucket, count) for every non-empty bucket, ascending
+    std::vector<std::pair<uint64_t, uint64_t>> nonempty_buckets() const;
+
+private:
+    std::vector<uint64_t> counts_;
+    uint64_t count_ = 0;
+    uint64_t min_ = 0;
+    uint64_t max_ = 0;
+    double sum_ = 0.0;
+    double sum_squares_ = 0.0;
+};
+
+/**
+ * Summary of a latency sample, in milliseconds
+ */
+struct LatencyStats {
+    size_t samples = 0;
+    double min_ms = 0.0;
+    double p50_ms = 0.0;
+    double p90_ms = 0.0;
+    double p99_ms = 0.0;
+    double p999_ms = 0.0;
+    double max_ms = 0.0;
+    double mean_ms = 0.0;
+    double stddev_ms = 0.0;
+    double trimmed_mean_ms = 0.0;  // Mean without the fastest and slowest 10%
+    double ci_low_ms = 0.0;        // Percentile-bootstrap confidence interval
+    double ci_high_ms = 0.0;       // of the trimmed mean
+};
+
+// Mean of the samples with the fastest and slowest 10% dropped
+double trimmed_mean(std::vector<double> samples_ms);
+
+// Percentiles and moments come from the histogram; the confidence interval
+// resamples samples_ms (seeded, so repeatable) and costs O(resamples * n)
+LatencyStats summarize_latencies(const std::vector<double>& samples_ms,
+                                 const LatencyHistogram& histogram,
+                                 double confidence = 0.95,
+                                 size_t resamples = 1000);
+
+} // namespace benchmark
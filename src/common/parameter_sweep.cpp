@@ -0,0 +1,409 @@
+#include "common/parameter_sweep.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include "common/benchmark_timing.h"
+#include "common/test_data_generator.h"
+#include "common/utilities.h"
+
+namespace benchmark {
+
+namespace {
+    // Fixed, so the generated paths and timestamps repeat from run to run
+    const time_t SWEEP_REFERENCE_TIME = 1700000000;
+
+    template<typename Func>
+    double seconds_for(Func&& call) {
+        auto start = std::chrono::high_resolution_clock::now();
+        call();
+        return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // Pads (deterministically) or truncates the file name, keeping the directory
+    void set_name_length(FileMetadata& metadata, size_t length) {
+        static const char FILL[] = "abcdefghijklmnopqrstuvwxyz0123456789_-";
+        std::string name = metadata.name;
+        while (name.size() < length) {
+            name.push_back(FILL[name.size() % (sizeof(FILL) - 1)]);
+        }
+        name.resize(length);
+        metadata.path = metadata.path.substr(0, metadata.path.rfind('/') + 1) + name;
+        metadata.name = name;
+    }
+
+    // The one parameter a single-parameter series varies, or 0
+    size_t series_parameter(const SweepPoint& point) {
+        if (point.series == "block") {
+            return point.block_size;
+        }
+        if (point.series == "metadata_batch") {
+            return point.batch_size;
+        }
+        return 0;
+    }
+}
+
+std::vector<size_t> log_spaced_sizes(size_t min, size_t max, size_t factor) {
+    std::vector<size_t> sizes;
+    if (min == 0 || factor < 2 || min > max) {
+        return sizes;
+    }
+    size_t size = min;
+    while (size < max) {
+        sizes.push_back(size);
+        if (size > max / factor) {
+            break;
+        }
+        size *= factor;
+    }
+    sizes.push_back(max);
+    return sizes;
+}
+
+ParameterSweep::ParameterSweep(const SweepOptions& options)
+    : options_(options) {
+}
+
+BenchmarkResult ParameterSweep::measure(const std::function<BenchmarkResult(BenchmarkRunner&)>& benchmark,
+                                        double single_call_seconds) const {
+    TimingOptions timing = options_.timing;
+    if (single_call_seconds > 0.0) {
+        double affordable = options_.point_seconds / single_call_seconds;
+        if (affordable < static_cast<double>(timing.samples)) {
+            timing.samples = std::max<size_t>(3, static_cast<size_t>(affordable));
+            timing.target_rse = 0.0;
+        }
+    }
+    BenchmarkRunner runner(timing);
+    return benchmark(runner);
+}
+
+std::vector<SweepPoint> ParameterSweep::run(const std::vector<SerializerInterface*>& serializers) {
+    std::vector<SweepPoint> points;
+    TestDataGenerator generator(options_.seed);
+    generator.set_reference_time(SWEEP_REFERENCE_TIME);
+
+    auto add = [&](SweepPoint point) {
+        if (options_.on_point) {
+            options_.on_point(point);
+        }
+        points.push_back(std::move(point));
+    };
+
+    // One serialization and one deserialization point; the untimed first
+    // encode and decode size the sample counts
+    auto round_trip = [&](const SweepPoint& parameters,
+                          const std::function<std::vector<uint8_t>()>& encode,
+                          const std::function<void(const std::vector<uint8_t>&)>& decode,
+                          const std::function<BenchmarkResult(BenchmarkRunner&)>& serialize,
+                          const std::function<BenchmarkResult(BenchmarkRunner&,
+                                                              const std::vector<uint8_t>&)>& deserialize) {
+        std::vector<uint8_t> encoded;
+        double encode_seconds = seconds_for([&]() { encoded = encode(); });
+        double decode_seconds = seconds_for([&]() { decode(encoded); });
+
+        SweepPoint point = parameters;
+        point.result = measure(serialize, encode_seconds);
+        add(point);
+        point.result = measure([&](BenchmarkRunner& runner) { return deserialize(runner, encoded); },
+                               decode_seconds);
+        add(point);
+    };
+
+    for (size_t block_size : options_.block_sizes) {
+        FileBlock block = generator.generate_block(block_size);
+        SweepPoint parameters;
+        parameters.series = "block";
+        parameters.block_size = block_size;
+        for (SerializerInterface* serializer : serializers) {
+            round_trip(parameters,
+                       [&]() { return serializer->serialize_block(block); },
+                       [&](const std::vector<uint8_t>& data) { do_not_optimize(serializer->deserialize_block(data)); },
+                       [&](BenchmarkRunner& runner) { return runner.benchmark_block_serialization(*serializer, block); },
+                       [&](BenchmarkRunner& runner, const std::vector<uint8_t>& data) {
+                           return runner.benchmark_block_deserialization(*serializer, data);
+                       });
+        }
+    }
+
+    for (size_t tag_count : options_.tag_counts) {
+        // One record per tag count, so name length is the only other change
+        FileMetadata base = generator.generate_metadata(tag_count);
+        for (size_t name_length : options_.name_lengths) {
+            FileMetadata metadata = base;
+            set_name_length(metadata, name_length);
+            SweepPoint parameters;
+            parameters.series = "metadata";
+            parameters.tag_count = tag_count;
+            parameters.name_length = name_length;
+            for (SerializerInterface* serializer : serializers) {
+                round_trip(parameters,
+                           [&]() { return serializer->serialize_metadata(metadata); },
+                           [&](const std::vector<uint8_t>& data) {
+                               do_not_optimize(serializer->deserialize_metadata(data));
+                           },
+                           [&](BenchmarkRunner& runner) {
+                               return runner.benchmark_metadata_serialization(*serializer, metadata);
+                           },
+                           [&](BenchmarkRunner& runner, const std::vector<uint8_t>& data) {
+                               return runner.benchmark_metadata_deserialization(*serializer, data);
+                           });
+            }
+        }
+    }
+
+    for (size_t batch_size : options_.batch_sizes) {
+        std::vector<FileMetadata> batch = generator.generate_metadata_batch(batch_size);
+        SweepPoint parameters;
+        parameters.series = "metadata_batch";
+        parameters.batch_size = batch_size;
+        for (SerializerInterface* serializer : serializers) {
+            round_trip(parameters,
+                       [&]() { return serializer->serialize_metadata_batch(batch); },
+                       [&](const std::vector<uint8_t>& data) {
+                           do_not_optimize(serializer->deserialize_metadata_batch(data));
+                       },
+                       [&](BenchmarkRunner& runner) {
+                           return runner.benchmark_metadata_batch_serialization(*serializer, batch);
+                       },
+                       [&](BenchmarkRunner& runner, const std::vector<uint8_t>& data) {
+                           return runner.benchmark_metadata_batch_deserialization(*serializer, data);
+                       });
+        }
+    }
+
+    return points;
+}
+
+std::vector<ScalingExponent> fit_scaling_exponents(const std::vector<SweepPoint>& points) {
+    // Groups in first-seen order
+    std::vector<ScalingExponent> fits;
+    std::vector<std::vector<std::pair<double, double>>> samples;
+    for (const auto& point : points) {
+        const BenchmarkResult& result = point.result;
+        size_t group = 0;
+        while (group < fits.size() &&
+               !(fits[group].format_name == result.format_name && fits[group].series == point.series &&
+                 fits[group].operation_name == result.operation_name)) {
+            ++group;
+        }
+        if (group == fits.size()) {
+            ScalingExponent fit;
+            fit.format_name = result.format_name;
+            fit.series = point.series;
+            fit.operation_name = result.operation_name;
+            fits.push_back(fit);
+            samples.emplace_back();
+        }
+        if (result.data_size_bytes > 0 && result.duration_ms > 0.0) {
+            samples[group].emplace_back(std::log(static_cast<double>(result.data_size_bytes)),
+                                        std::log(result.duration_ms));
+        }
+    }
+
+    for (size_t group = 0; group < fits.size(); ++group) {
+        const auto& xy = samples[group];
+        fits[group].points = xy.size();
+        if (xy.size() < 2) {
+            continue;
+        }
+        double n = static_cast<double>(xy.size());
+        double mean_x = 0.0;
+        double mean_y = 0.0;
+        for (const auto& sample : xy) {
+            mean_x += sample.first / n;
+            mean_y += sample.second / n;
+        }
+        double sxx = 0.0;
+        double sxy = 0.0;
+        double syy = 0.0;
+        for (const auto& sample : xy) {
+            double dx = sample.first - mean_x;
+            double dy = sample.second - mean_y;
+            sxx += dx * dx;
+            sxy += dx * dy;
+            syy += dy * dy;
+        }
+        if (sxx <= 0.0) {
+            continue;  // Every point had the same size
+        }
+        fits[group].exponent = sxy / sxx;
+        fits[group].r_squared = syy > 0.0 ? (sxy * sxy) / (sxx * syy) : 1.0;
+    }
+    return fits;
+}
+
+std::vector<Crossover> find_crossovers(const std::vector<SweepPoint>& points) {
+    // (series, operation) -> parameter -> format -> duration
+    std::map<std::pair<std::string, std::string>, std::map<size_t, std::map<std::string, double>>> table;
+    for (const auto& point : points) {
+        size_t parameter = series_parameter(point);
+        if (parameter == 0) {
+            continue;
+        }
+        table[{point.series, point.result.operation_name}][parameter][point.result.format_name] =
+            point.result.duration_ms;
+    }
+
+    std::vector<Crossover> crossovers;
+    for (const auto& series : table) {
+        const auto& by_parameter = series.second;
+        for (auto below = by_parameter.begin(); below != by_parameter.end(); ++below) {
+            auto above = std::next(below);
+            if (above == by_parameter.end()) {
+                break;
+            }
+            for (const auto& a : below->second) {
+                for (const auto& b : below->second) {
+                    if (a.first >= b.first || !above->second.count(a.first) || !above->second.count(b.first)) {
+                        continue;
+                    }
+                    bool a_faster_below = a.second < b.second;
+                    bool a_faster_above = above->second.at(a.first) < above->second.at(b.first);
+                    if (a_faster_below == a_faster_above) {
+                        continue;
+                    }
+                    Crossover crossover;
+                    crossover.series = series.first.first;
+                    crossover.operation_name = series.first.second;
+                    crossover.faster_below = a_faster_below ? a.first : b.first;
+                    crossover.faster_above = a_faster_below ? b.first : a.first;
+                    crossover.parameter_below = below->first;
+                    crossover.parameter_above = above->first;
+                    crossovers.push_back(crossover);
+                }
+            }
+        }
+    }
+    return crossovers;
+}
+
+void export_sweep_csv(const std::vector<SweepPoint>& points, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
+        return;
+    }
+    export_sweep_csv(points, file);
+}
+
+void export_sweep_csv(const std::vector<SweepPoint>& points, std::ostream& out) {
+    out << "Series,Format,Operation,BlockSize,TagCount,NameLength,BatchSize,"
+        << "DataSizeBytes,SerializedSizeBytes,Records,Samples,DurationMs,CiLowMs,CiHighMs,P50Ms,P99Ms,"
+        << "OpsPerSec,RecordsPerSec,LogicalMBps,WireMBps,AllocsPerOp" << std::endl;
+
+    auto parameter = [](size_t value, bool used) { return used ? std::to_string(value) : std::string(); };
+    for (const auto& point : points) {
+        const BenchmarkResult& result = point.result;
+        bool block = point.series == "block";
+        bool metadata = point.series == "metadata";
+        bool batch = point.series == "metadata_batch";
+        out << point.series << ","
+            << result.format_name << ","
+            << result.operation_name << ","
+            << parameter(point.block_size, block) << ","
+            << parameter(point.tag_count, metadata) << ","
+            << parameter(point.name_length, metadata) << ","
+            << parameter(point.batch_size, batch) << ","
+            << result.data_size_bytes << ","
+            << result.serialized_size_bytes << ","
+            << result.records << ","
+            << result.latency.samples << ","
+            << std::fixed << std::setprecision(6) << result.duration_ms << ","
+            << result.latency.ci_low_ms << ","
+            << result.latency.ci_high_ms << ","
+            << result.latency.p50_ms << ","
+            << result.latency.p99_ms << ","
+            << result.ops_per_sec << ","
+            << result.records_per_sec << ","
+            << result.logical_mb_per_sec << ","
+            << result.wire_mb_per_sec << ","
+            << parameter(result.allocations_per_op, result.allocations_measured)
+            << std::endl;
+    }
+}
+
+void export_sweep_json(const std::vector<SweepPoint>& points, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
+        return;
+    }
+    export_sweep_json(points, file);
+}
+
+void export_sweep_json(const std::vector<SweepPoint>& points, std::ostream& out) {
+    auto parameter = [](size_t value, bool used) { return used ? std::to_string(value) : std::string("null"); };
+    out << "[" << std::endl;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const SweepPoint& point = points[i];
+        const BenchmarkResult& result = point.result;
+        bool metadata = point.series == "metadata";
+        out << std::fixed << std::setprecision(6)
+            << "  {\"series\": \"" << json_escape(point.series) << "\""
+            << ", \"format\": \"" << json_escape(result.format_name) << "\""
+            << ", \"operation\": \"" << json_escape(result.operation_name) << "\""
+            << ", \"block_size\": " << parameter(point.block_size, point.series == "block")
+            << ", \"tag_count\": " << parameter(point.tag_count, metadata)
+            << ", \"name_length\": " << parameter(point.name_length, metadata)
+            << ", \"batch_size\": " << parameter(point.batch_size, point.series == "metadata_batch")
+            << ", \"data_size_bytes\": " << result.data_size_bytes
+            << ", \"serialized_size_bytes\": " << result.serialized_size_bytes
+            << ", \"records\": " << result.records
+            << ", \"samples\": " << result.latency.samples
+            << ", \"duration_ms\": " << result.duration_ms
+            << ", \"ci_low_ms\": " << result.latency.ci_low_ms
+            << ", \"ci_high_ms\": " << result.latency.ci_high_ms
+            << ", \"p50_ms\": " << result.latency.p50_ms
+            << ", \"p99_ms\": " << result.latency.p99_ms
+            << ", \"ops_per_sec\": " << result.ops_per_sec
+            << ", \"logical_mb_per_sec\": " << result.logical_mb_per_sec
+            << ", \"wire_mb_per_sec\": " << result.wire_mb_per_sec
+            << ", \"allocs_per_op\": " << parameter(result.allocations_per_op, result.allocations_measured)
+            << "}" << (i + 1 < points.size() ? "," : "") << std::endl;
+    }
+    out << "]" << std::endl;
+}
+
+void print_sweep_summary(const std::vector<SweepPoint>& points) {
+    std::cout << std::left
+              << std::setw(18) << "Format"
+              << std::setw(16) << "Series"
+              << std::setw(32) << "Operation"
+              << std::setw(8) << "Points"
+              << std::setw(10) << "Exponent"
+              << std::setw(6) << "R^2"
+              << std::endl;
+    std::cout << std::string(90, '-') << std::endl;
+
+    for (const auto& fit : fit_scaling_exponents(points)) {
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(18) << fit.format_name
+                  << std::setw(16) << fit.series
+                  << std::setw(32) << fit.operation_name
+                  << std::setw(8) << fit.points
+                  << std::setw(10) << fit.exponent
+                  << std::setw(6) << fit.r_squared
+                  << std::endl;
+    }
+
+    std::vector<Crossover> crossovers = find_crossovers(points);
+    if (crossovers.empty()) {
+        return;
+    }
+    std::cout << std::endl << "Crossovers:" << std::endl;
+    for (const auto& crossover : crossovers) {
+        const char* unit = crossover.series == "block" ? " B" : " records";
+        std::cout << "  " << crossover.operation_name << ": "
+                  << crossover.faster_below << " faster at " << crossover.parameter_below << unit << ", "
+                  << crossover.faster_above << " faster at " << crossover.parameter_above << unit
+                  << std::endl;
+    }
+}
+
+} // namespace benchmark
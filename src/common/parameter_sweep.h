@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "common/benchmark_runner.h"
+#include "common/serializer_interface.h"
+
+namespace benchmark {
+
+// min, min * factor, ... up to and including max (added if the steps skip it)
+std::vector<size_t> log_spaced_sizes(size_t min, size_t max, size_t factor = 4);
+
+/**
+ * One measured point. Only the parameters of its series are set:
+ * "block" varies block_size, "metadata" tag_count and name_length,
+ * "metadata_batch" batch_size; the rest stay 0.
+ */
+struct SweepPoint {
+    std::string series;
+    size_t block_size = 0;
+    size_t tag_count = 0;
+    size_t name_length = 0;
+    size_t batch_size = 0;
+    BenchmarkResult result;
+};
+
+struct SweepOptions {
+    std::vector<size_t> block_sizes = log_spaced_sizes(64, size_t(64) << 20);
+    std::vector<size_t> tag_counts = {0, 4, 16, 64};
+    std::vector<size_t> name_lengths = {8, 64, 512};
+    std::vector<size_t> batch_sizes = {1, 16, 256, 4096};
+
+    // Timing of every point; samples is the most any point takes
+    TimingOptions timing;
+    // Points whose single call is slow take fewer samples (at least 3) so
+    // that each stays near this budget
+    double point_seconds = 0.5;
+    unsigned seed = 42;
+
+    // Called after each point, e.g. to report progress on long sweeps
+    std::function<void(const SweepPoint&)> on_point;
+};
+
+/**
+ * Serialization and deserialization of every format over each series of
+ * SweepOptions. Inputs are generated once per parameter value and shared by
+ * all formats.
+ */
+class ParameterSweep {
+public:
+    explicit ParameterSweep(const SweepOptions& options = SweepOptions());
+
+    std::vector<SweepPoint> run(const std::vector<SerializerInterface*>& serializers);
+
+private:
+    // Runs benchmark with a sample count sized to point_seconds
+    BenchmarkResult measure(const std::function<BenchmarkResult(BenchmarkRunner&)>& benchmark,
+                            double single_call_seconds) const;
+
+    SweepOptions options_;
+};
+
+/**
+ * Least-squares fit of log(duration) against log(logical bytes) over one
+ * format's points for one operation: time grows as bytes^exponent
+ */
+struct ScalingExponent {
+    std::string format_name;
+    std::string series;
+    std::string operation_name;
+    size_t points = 0;
+    double exponent = 0.0;
+    double r_squared = 0.0;
+};
+
+std::vector<ScalingExponent> fit_scaling_exponents(const std::vector<SweepPoint>& points);
+
+/**
+ * Two formats swapping places between neighbouring values of a
+ * single-parameter series: faster_below wins at parameter_below,
+ * faster_above at parameter_above
+ */
+struct Crossover {
+    std::string series;
+    std::string operation_name;
+    std::string faster_below;
+    std::string faster_above;
+    size_t parameter_below = 0;
+    size_t parameter_above = 0;
+};
+
+std::vector<Crossover> find_crossovers(const std::vector<SweepPoint>& points);
+
+// One row per point; parameters a series does not vary are left empty
+void export_sweep_csv(const std::vector<SweepPoint>& points, const std::string& filename);
+void export_sweep_csv(const std::vector<SweepPoint>& points, std::ostream& out);
+
+// The same rows as an array of JSON objects
+void export_sweep_json(const std::vector<SweepPoint>& points, const std::string& filename);
+void export_sweep_json(const std::vector<SweepPoint>& points, std::ostream& out);
+
+// Scaling exponents per format and operation, then the crossovers
+void print_sweep_summary(const std::vector<SweepPoint>& points);
+
+} // namespace benchmark
@@ -0,0 +1,170 @@
+#include "common/perf_counters.h"
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace benchmark {
+
+namespace {
+    struct EventConfig {
+        uint32_t type;
+        uint64_t config;
+    };
+
+    EventConfig event_config(PerfCounter counter) {
+        switch (counter) {
+            case PerfCounter::Cycles:
+                return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+            case PerfCounter::Instructions:
+                return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+            case PerfCounter::BranchMisses:
+                return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+            case PerfCounter::L1dMisses:
+                return {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                                            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+            case PerfCounter::LlcMisses:
+                return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+            case PerfCounter::PageFaults:
+                return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS};
+        }
+        return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+    }
+
+    int open_event(PerfCounter counter, int group_fd) {
+        EventConfig event = event_config(counter);
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = event.type;
+        attr.config = event.config;
+        attr.disabled = group_fd == -1 ? 1 : 0;  // Members follow their leader
+        attr.exclude_kernel = 1;                 // Allowed at perf_event_paranoid 2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+        return static_cast<int>(fd);
+    }
+}
+
+const char* perf_counter_name(PerfCounter counter) {
+    switch (counter) {
+        case PerfCounter::Cycles:
+            return "cycles";
+        case PerfCounter::Instructions:
+            return "instructions";
+        case PerfCounter::BranchMisses:
+            return "branch-misses";
+        case PerfCounter::L1dMisses:
+            return "L1d-misses";
+        case PerfCounter::LlcMisses:
+            return "LLC-misses";
+        case PerfCounter::PageFaults:
+            return "page-faults";
+    }
+    return "unknown";
+}
+
+bool PerfCounterValues::any() const {
+    for (bool counter : measured) {
+        if (counter) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double PerfCounterValues::ipc() const {
+    if (!has(PerfCounter::Cycles) || !has(PerfCounter::Instructions) || get(PerfCounter::Cycles) <= 0.0) {
+        return 0.0;
+    }
+    return get(PerfCounter::Instructions) / get(PerfCounter::Cycles);
+}
+
+PerfCounterGroup::PerfCounterGroup() {
+    fds_.fill(-1);
+    int leader = -1;
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        PerfCounter counter = static_cast<PerfCounter>(i);
+        int fd = open_event(counter, leader);
+        if (fd < 0 && leader != -1) {
+            // Some PMUs cannot schedule every event together; count it alone
+            fd = open_event(counter, -1);
+        }
+        fds_[i] = fd;
+        if (leader == -1 && fd >= 0) {
+            leader = fd;
+        }
+    }
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+bool PerfCounterGroup::available() const {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PerfCounterGroup::start() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        }
+    }
+    resume();
+}
+
+void PerfCounterGroup::resume() {
+    // Leaders and standalone counters were opened disabled; group members
+    // count whenever their leader does
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void PerfCounterGroup::stop() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+}
+
+PerfCounterValues PerfCounterGroup::read(uint64_t operations) const {
+    PerfCounterValues values;
+    if (operations == 0) {
+        return values;
+    }
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        if (fds_[i] < 0) {
+            continue;
+        }
+        uint64_t data[3] = {0, 0, 0};  // value, time enabled, time running
+        if (::read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+            continue;  // Never scheduled onto the PMU
+        }
+        double count = static_cast<double>(data[0]);
+        if (data[2] < data[1]) {
+            count *= static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        }
+        values.per_op[i] = count / static_cast<double>(operations);
+        values.measured[i] = true;
+    }
+    return values;
+}
+
+} // namespace benchmark
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace benchmark {
+
+/**
+ * Hardware and software events read through perf_event_open
+ */
+enum class PerfCounter : uint8_t {
+    Cycles,
+    Instructions,
+    BranchMisses,
+    L1dMisses,      // L1 data cache read misses
+    LlcMisses,      // Last-level cache misses
+    PageFaults
+};
+
+const size_t PERF_COUNTER_COUNT = 6;
+
+const char* perf_counter_name(PerfCounter counter);
+
+/**
+ * Counter totals divided by the number of operations they covered. A counter
+ * the kernel or CPU would not provide is left unmeasured.
+ */
+struct PerfCounterValues {
+    std::array<double, PERF_COUNTER_COUNT> per_op = {};
+    std::array<bool, PERF_COUNTER_COUNT> measured = {};
+
+    bool any() const;
+    bool has(PerfCounter counter) const { return measured[static_cast<size_t>(counter)]; }
+    double get(PerfCounter counter) const { return per_op[static_cast<size_t>(counter)]; }
+
+    // Instructions per cycle, or 0 when either is missing
+    double ipc() const;
+};
+
+/**
+ * The counters above for the calling thread, user space only, opened as one
+ * group so they cover the same instructions. Counters that cannot join the
+ * group are opened on their own; with perf_event_paranoid too high, no PMU
+ * (most VMs) or no syscall at all, available() is false and read() reports
+ * nothing measured. Never throws.
+ */
+class PerfCounterGroup {
+public:
+    PerfCounterGroup();
+    ~PerfCounterGroup();
+
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool available() const;
+
+    // Zero and enable every counter
+    void start();
+    // Disable every counter, keeping the counts
+    void stop();
+    // Enable again after stop(), adding to the counts
+    void resume();
+
+    // Counts since start(), scaled up if the kernel multiplexed a counter,
+    // divided by operations
+    PerfCounterValues read(uint64_t operations) const;
+
+private:
+    std::array<int, PERF_COUNTER_COUNT> fds_;
+};
+
+} // namespace benchmark
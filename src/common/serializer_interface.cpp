@@ -0,0 +1,68 @@
+#include "common/serializer_interface.h"
+#include <stdexcept>
+#include "common/binary_encoding.h"
+#include "common/utilities.h"
+
+namespace benchmark {
+
+std::vector<uint8_t> SerializerInterface::serialize_metadata_batch(const std::vector<FileMetadata>& batch) {
+    std::vector<uint8_t> result;
+    append_varint(result, batch.size());
+    
+    for (const auto& metadata : batch) {
+        std::vector<uint8_t> row = serialize_metadata(metadata);
+        append_varint(result, row.size());
+        append_bytes(result, row.data(), row.size());
+    }
+    
+    return result;
+}
+
+std::vector<FileMetadata> SerializerInterface::deserialize_metadata_batch(const std::vector<uint8_t>& data) {
+    ByteReader reader(data);
+    uint64_t count = reader.read_varint();
+    if (count > reader.remaining()) {
+        throw std::runtime_error("Batch record count exceeds serialized data");
+    }
+    
+    std::vector<FileMetadata> batch;
+    batch.reserve(count);
+    
+    std::vector<uint8_t> row;
+    for (uint64_t i = 0; i < count; ++i) {
+        size_t row_size = reader.read_varint();
+        const uint8_t* row_data = reader.read_bytes(row_size);
+        row.assign(row_data, row_data + row_size);
+        batch.push_back(deserialize_metadata(row));
+    }
+    
+    return batch;
+}
+
+FileBlock SerializerInterface::deserialize_block_verified(const std::vector<uint8_t>& data) {
+    FileBlock block = deserialize_block(data);
+    if (!block.validate_checksum()) {
+        throw std::runtime_error("Checksum mismatch after deserialization");
+    }
+    return block;
+}
+
+DecodedBlock SerializerInterface::decode_block(const std::vector<uint8_t>& data,
+                                               const DecodeOptions& options) {
+    if (options.verification == VerificationMode::Strict) {
+        return DecodedBlock(deserialize_block_verified(data), VerificationMode::Strict);
+    }
+    return DecodedBlock(deserialize_block(data), options.verification);
+}
+
+void SerializerInterface::assign_verified_payload(FileBlock& block, const uint8_t* payload, size_t size) {
+    ChecksumState state(block.checksum_algorithm);
+    block.data.clear();
+    append_with_checksum(block.data, payload, size, state);
+    
+    if (state.finalize() != block.checksum) {
+        throw std::runtime_error("Checksum mismatch after deserialization");
+    }
+}
+
+} // namespace benchmark
\ No newline at end of file
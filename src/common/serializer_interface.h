@@ -1,8 +1,11 @@
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <vector>
 #include <string>
 #include "common/data_structures.h"
+#include "common/decode_options.h"
 
 namespace benchmark {
 
@@ -25,8 +28,34 @@ public:
     // Serialize file block to binary string
     virtual std::vector<uint8_t> serialize_block(const FileBlock& block) = 0;
     
-    // Deserialize file block from binary string
+    // Deserialize file block from binary string, without verifying its checksum
     virtual FileBlock deserialize_block(const std::vector<uint8_t>& data) = 0;
+    
+    // Deserialize a block and verify its checksum, throwing std::runtime_error
+    // on mismatch. The default decodes and then re-reads the payload; formats
+    // that copy or decode the payload override it to checksum in the same pass.
+    virtual FileBlock deserialize_block_verified(const std::vector<uint8_t>& data);
+    
+    // Deserialize a block under a verification policy: strict goes through
+    // deserialize_block_verified, deferred and trusted through deserialize_block
+    DecodedBlock decode_block(const std::vector<uint8_t>& data,
+                              const DecodeOptions& options = DecodeOptions());
+    
+    // Serialize a batch of metadata records (e.g. a directory listing).
+    // The default frames each serialize_metadata() row with a varint length;
+    // batch-oriented formats override both methods.
+    virtual std::vector<uint8_t> serialize_metadata_batch(const std::vector<FileMetadata>& batch);
+    
+    // Deserialize a batch produced by serialize_metadata_batch
+    virtual std::vector<FileMetadata> deserialize_metadata_batch(const std::vector<uint8_t>& data);
+
+protected:
+    // Copies payload into block.data while checksumming it with
+    // block.checksum_algorithm; throws if the result differs from block.checksum
+    static void assign_verified_payload(FileBlock& block, const uint8_t* payload, size_t size);
 };
 
+// Creates a fresh serializer, e.g. one per worker thread of a scaling run
+using SerializerFactory = std::function<std::unique_ptr<SerializerInterface>()>;
+
 } // namespace benchmark
\ No newline at end of file
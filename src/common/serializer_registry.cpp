@@ -0,0 +1,118 @@
+#include "common/serializer_registry.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <utility>
+
+namespace benchmark {
+
+namespace {
+    bool equals_ignoring_case(const std::string& a, const std::string& b) {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(), [](unsigned char x, unsigned char y) {
+                   return std::tolower(x) == std::tolower(y);
+               });
+    }
+}
+
+const char* serializer_capability_name(SerializerCapability capability) {
+    switch (capability) {
+        case SerializerCapability::BinarySafe:
+            return "binary-safe";
+        case SerializerCapability::ZeroCopyRead:
+            return "zero-copy";
+        case SerializerCapability::Streaming:
+            return "streaming";
+        case SerializerCapability::Batch:
+            return "batch";
+        case SerializerCapability::SchemaRequired:
+            return "schema-required";
+        case SerializerCapability::Deterministic:
+            return "deterministic";
+    }
+    return "unknown";
+}
+
+bool parse_serializer_capability(const std::string& name, SerializerCapability& capability) {
+    for (size_t i = 0; i < SERIALIZER_CAPABILITY_COUNT; ++i) {
+        SerializerCapability candidate = static_cast<SerializerCapability>(1u << i);
+        if (name == serializer_capability_name(candidate)) {
+            capability = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string serializer_capability_names(SerializerCapabilities capabilities) {
+    std::string names;
+    for (size_t i = 0; i < SERIALIZER_CAPABILITY_COUNT; ++i) {
+        if (capabilities & (1u << i)) {
+            if (!names.empty()) {
+                names += ",";
+            }
+            names += serializer_capability_name(static_cast<SerializerCapability>(1u << i));
+        }
+    }
+    return names;
+}
+
+SerializerRegistry& SerializerRegistry::instance() {
+    static SerializerRegistry registry;
+    return registry;
+}
+
+void SerializerRegistry::add(const SerializerRegistration& registration) {
+    if (!registration.create) {
+        throw std::invalid_argument("Serializer " + registration.key + " has no factory");
+    }
+    if (find(registration.key) || find(registration.format_name)) {
+        throw std::invalid_argument("Serializer " + registration.key + " (" +
+                                    registration.format_name + ") is already registered");
+    }
+    auto position = std::lower_bound(formats_.begin(), formats_.end(), registration,
+        [](const SerializerRegistration& a, const SerializerRegistration& b) { return a.key < b.key; });
+    formats_.insert(position, registration);
+}
+
+const SerializerRegistration* SerializerRegistry::find(const std::string& name) const {
+    for (const auto& registration : formats_) {
+        if (equals_ignoring_case(registration.key, name) || equals_ignoring_case(registration.format_name, name)) {
+            return &registration;
+        }
+    }
+    return nullptr;
+}
+
+std::unique_ptr<SerializerInterface> SerializerRegistry::create(const std::string& name) const {
+    const SerializerRegistration* registration = find(name);
+    if (!registration) {
+        throw std::out_of_range("Unknown serializer: " + name);
+    }
+    return registration->create();
+}
+
+std::vector<const SerializerRegistration*> SerializerRegistry::with_capabilities(
+    SerializerCapabilities required) const {
+    std::vector<const SerializerRegistration*> matching;
+    for (const auto& registration : formats_) {
+        if ((registration.capabilities & required) == required) {
+            matching.push_back(&registration);
+        }
+    }
+    return matching;
+}
+
+SerializerRegistrar::SerializerRegistrar(const std::string& key,
+                                         const std::string& format_name,
+                                         SerializerCapabilities capabilities,
+                                         SerializerFactory create) {
+    SerializerRegistration registration;
+    registration.key = key;
+    registration.format_name = format_name;
+    registration.capabilities = capabilities;
+    registration.create = std::move(create);
+    SerializerRegistry::instance().add(registration);
+}
+
+} // namespace benchmark
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "common/serializer_interface.h"
+
+namespace benchmark {
+
+/**
+ * Properties of a format's encoding that callers select formats by
+ */
+enum class SerializerCapability : uint32_t {
+    BinarySafe = 1u << 0,      // Any bytes in any string or payload field round-trip
+    ZeroCopyRead = 1u << 1,    // Fields can be read in place from the encoded buffer
+    Streaming = 1u << 2,       // A record's header gives its length, so records can be split out of a stream unparsed
+    Batch = 1u << 3,           // Native batch encoding rather than length-framed single records
+    SchemaRequired = 1u << 4,  // Field names are not on the wire; readers need the schema
+    Deterministic = 1u << 5    // Equal records always encode to equal bytes
+};
+
+const size_t SERIALIZER_CAPABILITY_COUNT = 6;
+
+// A set of SerializerCapability bits
+using SerializerCapabilities = uint32_t;
+
+inline SerializerCapabilities operator|(SerializerCapability a, SerializerCapability b) {
+    return static_cast<SerializerCapabilities>(a) | static_cast<SerializerCapabilities>(b);
+}
+
+inline SerializerCapabilities operator|(SerializerCapabilities a, SerializerCapability b) {
+    return a | static_cast<SerializerCapabilities>(b);
+}
+
+// Capability names ("binary-safe", "zero-copy", "streaming", "batch",
+// "schema-required", "deterministic") and lookup by name
+const char* serializer_capability_name(SerializerCapability capability);
+bool parse_serializer_capability(const std::string& name, SerializerCapability& capability);
+
+// Names of every capability in the set, comma-separated
+std::string serializer_capability_names(SerializerCapabilities capabilities);
+
+struct SerializerRegistration {
+    std::string key;            // Short name for command lines, e.g. "protobuf"
+    std::string format_name;    // format_name() of the serializers create() returns
+    SerializerCapabilities capabilities = 0;
+    SerializerFactory create;
+
+    bool has(SerializerCapability capability) const {
+        return (capabilities & static_cast<SerializerCapabilities>(capability)) != 0;
+    }
+};
+
+/**
+ * The formats linked into the program. Each format registers itself from
+ * its own translation unit through a SerializerRegistrar, so a program sees
+ * exactly the formats it links. Formats are kept sorted by key, since static
+ * initialization order across translation units is unspecified.
+ *
+ * Registration happens during static initialization and is not locked;
+ * lookups are safe from any thread once main() has started.
+ */
+class SerializerRegistry {
+public:
+    // The registry SerializerRegistrar adds to
+    static SerializerRegistry& instance();
+
+    // Throws std::invalid_argument if the key or format name is taken, or the factory is empty
+    void add(const SerializerRegistration& registration);
+
+    const std::vector<SerializerRegistration>& formats() const { return formats_; }
+
+    // By key or format name, ignoring case; nullptr if neither matches
+    const SerializerRegistration* find(const std::string& name) const;
+
+    // A new serializer by key or format name; throws std::out_of_range if unknown
+    std::unique_ptr<SerializerInterface> create(const std::string& name) const;
+
+    // Formats that have every capability in required
+    std::vector<const SerializerRegistration*> with_capabilities(SerializerCapabilities required) const;
+
+private:
+    std::vector<SerializerRegistration> formats_;
+};
+
+/**
+ * Adds a format to SerializerRegistry::instance() when constructed. Define
+ * one at namespace scope in the format's .cpp file.
+ */
+class SerializerRegistrar {
+public:
+    SerializerRegistrar(const std::string& key,
+                        const std::string& format_name,
+                        SerializerCapabilities capabilities,
+                        SerializerFactory create);
+};
+
+} // namespace benchmark
@@ -1,15 +1,276 @@
 #include "common/test_data_generator.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
 #include <sstream>
 #include <iomanip>
+#include <thread>
 
 namespace benchmark {
 
-TestDataGenerator::TestDataGenerator(unsigned int seed)
-    : rng_(seed), byte_dist_(0, 255) {
+namespace {
+    // Constant-initialized, so they are never rebuilt per call
+    const char* const POSSIBLE_TAGS[] = {
+        "document", "image", "video", "audio", "archive",
+        "temp", "system", "user", "application", "cache",
+        "backup", "project", "data", "config", "log"
+    };
+    const size_t POSSIBLE_TAG_COUNT = sizeof(POSSIBLE_TAGS) / sizeof(POSSIBLE_TAGS[0]);
+
+    const char* const POSSIBLE_USERS[] = {
+        "root", "admin", "user", "guest", "daemon",
+        "system", "john", "alice", "bob", "carol"
+    };
+    const size_t POSSIBLE_USER_COUNT = sizeof(POSSIBLE_USERS) / sizeof(POSSIBLE_USERS[0]);
+
+    // Profile-shaped metadata draws from these in popularity order
+    const char* const DIRECTORY_NAMES[] = {
+        "src", "docs", "data", "build", "projects", "home", "lib", "assets",
+        "photos", "downloads", "backup", "logs", "tmp", "archive", "reports", "shared",
+        "music", "videos", "config", "tests", "scripts", "releases", "notes", "export",
+        "raw", "processed", "2023", "2024", "2025", "q1", "q2", "misc"
+    };
+    const size_t DIRECTORY_NAME_COUNT = sizeof(DIRECTORY_NAMES) / sizeof(DIRECTORY_NAMES[0]);
+
+    const char* const EXTENSIONS[] = {
+        "txt", "jpg", "log", "pdf", "json", "png", "cpp", "h",
+        "gz", "mp4", "csv", "docx", "py", "zst", "xml", "dat"
+    };
+    const size_t EXTENSION_COUNT = sizeof(EXTENSIONS) / sizeof(EXTENSIONS[0]);
+
+    const uint32_t COMMON_PERMISSIONS[] = {0644, 0600, 0755, 0640, 0664, 0700, 0444, 0775};
+    const size_t COMMON_PERMISSION_COUNT = sizeof(COMMON_PERMISSIONS) / sizeof(COMMON_PERMISSIONS[0]);
+
+    const char NAME_CHARSET[] = "abcdefghijklmnopqrstuvwxyz0123456789_-";
+
+    // Two- and three-byte UTF-8 characters (Latin accents, Cyrillic, CJK)
+    const char* const UTF8_CHARACTERS[] = {
+        "\xC3\xA9", "\xC3\xBC", "\xC3\xB1", "\xC3\xA5", "\xC3\xB8", "\xC3\x9F",
+        "\xD0\xB4", "\xD0\xB6", "\xD1\x8F", "\xCE\xBB",
+        "\xE6\x97\xA5", "\xE6\x9C\xAC", "\xE6\x96\x87", "\xE6\xA1\xA3", "\xE5\x86\x99", "\xE7\x9C\x9F"
+    };
+    const size_t UTF8_CHARACTER_COUNT = sizeof(UTF8_CHARACTERS) / sizeof(UTF8_CHARACTERS[0]);
+
+    const char* const TEXT_WORDS[] = {
+        "the", "of", "and", "to", "a", "in", "is", "that", "for", "it", "as", "was", "with", "be",
+        "by", "on", "not", "he", "this", "are", "or", "his", "from", "at", "which", "but", "have",
+        "an", "had", "they", "you", "were", "their", "one", "all", "we", "can", "her", "has",
+        "there", "been", "if", "more", "when", "will", "would", "who", "so", "no", "file",
+        "storage", "block", "request", "system", "server", "value", "between", "another",
+        "performance", "benchmark", "serialization", "however", "following", "configuration"
+    };
+    const size_t TEXT_WORD_COUNT = sizeof(TEXT_WORDS) / sizeof(TEXT_WORDS[0]);
+
+    const char* const LOG_LEVELS[] = {"INFO ", "INFO ", "INFO ", "INFO ", "DEBUG", "DEBUG", "WARN ", "ERROR"};
+    const char* const LOG_METHODS[] = {"GET", "GET", "GET", "POST", "PUT", "DELETE", "GET", "HEAD"};
+    const char* const LOG_RESOURCES[] = {"files", "blocks", "users", "metadata", "health", "search", "tags", "sessions"};
+    const char* const LOG_STATUSES[] = {"200", "200", "200", "200", "204", "304", "404", "500"};
+
+    // Buffered random bytes for the structured payload fillers
+    class ByteSource {
+    public:
+        explicit ByteSource(BulkRandomGenerator& rng) : rng_(rng), pos_(sizeof(buffer_)) {}
+
+        uint8_t next() {
+            if (pos_ == sizeof(buffer_)) {
+                rng_.fill(buffer_, sizeof(buffer_));
+                pos_ = 0;
+            }
+            return buffer_[pos_++];
+        }
+
+    private:
+        BulkRandomGenerator& rng_;
+        uint8_t buffer_[4096];
+        size_t pos_;
+    };
+
+    // Maps a random byte to a word index with Zipf(1.0) frequencies
+    struct WordTable {
+        uint8_t index[256];
+        uint8_t length[TEXT_WORD_COUNT];
+
+        WordTable() {
+            for (size_t k = 0; k < TEXT_WORD_COUNT; ++k) {
+                length[k] = static_cast<uint8_t>(std::strlen(TEXT_WORDS[k]));
+            }
+            double total = 0.0;
+            for (size_t k = 0; k < TEXT_WORD_COUNT; ++k) {
+                total += 1.0 / static_cast<double>(k + 1);
+            }
+            size_t slot = 0;
+            double cumulative = 0.0;
+            for (size_t k = 0; k < TEXT_WORD_COUNT; ++k) {
+                cumulative += 1.0 / static_cast<double>(k + 1);
+                size_t end = (k + 1 == TEXT_WORD_COUNT) ? 256
+                           : std::max(slot + 1, static_cast<size_t>(cumulative / total * 256.0));
+                for (; slot < end && slot < 256; ++slot) {
+                    index[slot] = static_cast<uint8_t>(k);
+                }
+            }
+        }
+    };
+
+    char* write_digits(char* out, uint64_t value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        return out + width;
+    }
+
+    // Formats milliseconds since the epoch as YYYY-MM-DDTHH:MM:SS.mmmZ (24 chars)
+    char* write_timestamp(char* out, int64_t ms) {
+        int64_t seconds = ms / 1000;
+        int64_t days = seconds / 86400;
+        int64_t rem = seconds % 86400;
+
+        // Civil date from days since 1970-01-01 (Howard Hinnant's algorithm)
+        days += 719468;
+        int64_t era = days / 146097;
+        int64_t doe = days - era * 146097;
+        int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        int64_t mp = (5 * doy + 2) / 153;
+        int64_t day = doy - (153 * mp + 2) / 5 + 1;
+        int64_t month = mp < 10 ? mp + 3 : mp - 9;
+        int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+        out = write_digits(out, year, 4);
+        *out++ = '-';
+        out = write_digits(out, month, 2);
+        *out++ = '-';
+        out = write_digits(out, day, 2);
+        *out++ = 'T';
+        out = write_digits(out, rem / 3600, 2);
+        *out++ = ':';
+        out = write_digits(out, rem / 60 % 60, 2);
+        *out++ = ':';
+        out = write_digits(out, rem % 60, 2);
+        *out++ = '.';
+        out = write_digits(out, ms % 1000, 3);
+        *out++ = 'Z';
+        return out;
+    }
+
+    char* write_string(char* out, const char* text) {
+        size_t length = std::strlen(text);
+        std::memcpy(out, text, length);
+        return out + length;
+    }
+
+    // Records per metadata chunk; large enough to amortize seeding a chunk generator
+    const size_t METADATA_CHUNK = 1024;
+
+    // A block chunk closes at this many blocks or bytes, whichever comes first
+    const size_t BLOCK_CHUNK_COUNT = 256;
+    const size_t BLOCK_CHUNK_BYTES = 4 * 1024 * 1024;
+
+    uint64_t substream_seed(uint64_t batch_seed, uint64_t chunk) {
+        uint64_t state = batch_seed ^ chunk;
+        splitmix64(state);
+        return splitmix64(state);
+    }
+
+    // Runs task(0..chunks-1) on up to threads workers, the caller included.
+    // Chunks are handed out dynamically; each task writes only its own slots.
+    void run_chunks(size_t chunks, unsigned threads, const std::function<void(size_t)>& task) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size_t worker_count = std::min<size_t>(threads, chunks);
+        std::atomic<size_t> next(0);
+        auto drain = [&]() {
+            for (size_t chunk = next++; chunk < chunks; chunk = next++) {
+                task(chunk);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        if (worker_count > 1) {
+            workers.reserve(worker_count - 1);
+            for (size_t i = 1; i < worker_count; ++i) {
+                workers.emplace_back(drain);
+            }
+        }
+        drain();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+}
+
+TestDataGenerator::TestDataGenerator(unsigned int seed, const WorkloadProfile& profile)
+    : rng_(seed), payload_rng_(seed), seed_(seed), reference_time_(std::time(nullptr)) {
+    set_profile(profile);
+}
+
+TestDataGenerator::TestDataGenerator(uint64_t stream_seed, time_t reference_time,
+                                     const WorkloadProfile& profile)
+    : payload_rng_(stream_seed), seed_(stream_seed), reference_time_(reference_time) {
+    std::seed_seq seq{static_cast<uint32_t>(stream_seed), static_cast<uint32_t>(stream_seed >> 32)};
+    rng_.seed(seq);
+    set_profile(profile);
+}
+
+void TestDataGenerator::set_profile(const WorkloadProfile& profile) {
+    profile_ = profile;
+    directory_dist_ = ZipfDistribution(std::max<size_t>(profile.directory_fanout, 1),
+                                       profile.directory_skew);
+    tag_dist_ = ZipfDistribution(POSSIBLE_TAG_COUNT, profile.tag_skew);
+    owner_dist_ = ZipfDistribution(POSSIBLE_USER_COUNT, profile.owner_skew);
+    payload_class_dist_ = std::discrete_distribution<size_t>(profile.payload_mix.begin(),
+                                                             profile.payload_mix.end());
+}
+
+uint64_t TestDataGenerator::next_batch_seed() {
+    uint64_t state = seed_ + parallel_batches_++;
+    return splitmix64(state);
+}
+
+FileMetadata TestDataGenerator::generate_metadata() {
+    size_t tag_count = profile_.min_tags;
+    if (profile_.max_tags > profile_.min_tags) {
+        tag_count = std::uniform_int_distribution<size_t>(profile_.min_tags, profile_.max_tags)(rng_);
+    }
+    return generate_metadata(tag_count);
 }
 
 FileMetadata TestDataGenerator::generate_metadata(size_t tag_count) {
+    if (profile_.synthetic) {
+        return generate_synthetic_metadata(tag_count);
+    }
+    
+    FileMetadata metadata;
+    metadata.name = random_file_name();
+    metadata.path = random_path_prefix() + "/" + metadata.name;
+    metadata.size = random_file_size();
+    
+    // Created within the last year, modified at or after creation
+    std::uniform_int_distribution<time_t> created_dist(reference_time_ - 365 * 24 * 60 * 60,
+                                                       reference_time_);
+    metadata.created_at = created_dist(rng_);
+    metadata.last_modified =
+        std::uniform_int_distribution<time_t>(metadata.created_at, reference_time_)(rng_);
+    
+    metadata.tags.clear();
+    metadata.tags.reserve(tag_count);
+    for (size_t i = 0; i < tag_count; ++i) {
+        metadata.tags.emplace_back(POSSIBLE_TAGS[tag_dist_(rng_)]);
+    }
+    
+    static const ZipfDistribution permission_dist(COMMON_PERMISSION_COUNT, 1.5);
+    metadata.permissions = COMMON_PERMISSIONS[permission_dist(rng_)];
+    
+    metadata.owner = POSSIBLE_USERS[owner_dist_(rng_)];
+    metadata.group = POSSIBLE_USERS[owner_dist_(rng_)];
+    
+    return metadata;
+}
+
+FileMetadata TestDataGenerator::generate_synthetic_metadata(size_t tag_count) {
     FileMetadata metadata;
     
     // Generate a random file name
@@ -25,23 +286,18 @@ FileMetadata TestDataGenerator::generate_metadata(size_t tag_count) {
     
     // Set timestamps (within the last year)
     std::uniform_int_distribution<time_t> time_dist(
-        std::time(nullptr) - 365 * 24 * 60 * 60,
-        std::time(nullptr)
+        reference_time_ - 365 * 24 * 60 * 60,
+        reference_time_
     );
     metadata.created_at = time_dist(rng_);
     metadata.last_modified = time_dist(rng_);
     
     // Generate random tags
     metadata.tags.clear();
-    std::vector<std::string> possible_tags = {
-        "document", "image", "video", "audio", "archive",
-        "temp", "system", "user", "application", "cache",
-        "backup", "project", "data", "config", "log"
-    };
-    
-    std::uniform_int_distribution<size_t> tag_idx_dist(0, possible_tags.size() - 1);
+    metadata.tags.reserve(tag_count);
+    std::uniform_int_distribution<size_t> tag_idx_dist(0, POSSIBLE_TAG_COUNT - 1);
     for (size_t i = 0; i < tag_count; ++i) {
-        metadata.tags.push_back(possible_tags[tag_idx_dist(rng_)]);
+        metadata.tags.emplace_back(POSSIBLE_TAGS[tag_idx_dist(rng_)]);
     }
     
     // Generate random permissions (between 0600 and 0777)
@@ -49,19 +305,25 @@ FileMetadata TestDataGenerator::generate_metadata(size_t tag_count) {
     metadata.permissions = perm_dist(rng_);
     
     // Set owner and group
-    std::vector<std::string> possible_users = {
-        "root", "admin", "user", "guest", "daemon",
-        "system", "john", "alice", "bob", "carol"
-    };
-    
-    std::uniform_int_distribution<size_t> user_idx_dist(0, possible_users.size() - 1);
-    metadata.owner = possible_users[user_idx_dist(rng_)];
-    metadata.group = possible_users[user_idx_dist(rng_)];
+    std::uniform_int_distribution<size_t> user_idx_dist(0, POSSIBLE_USER_COUNT - 1);
+    metadata.owner = POSSIBLE_USERS[user_idx_dist(rng_)];
+    metadata.group = POSSIBLE_USERS[user_idx_dist(rng_)];
     
     return metadata;
 }
 
-FileBlock TestDataGenerator::generate_block(size_t size_bytes, uint64_t offset) {
+FileBlock TestDataGenerator::generate_block(size_t size_bytes, uint64_t offset,
+                                            ChecksumAlgorithm algorithm) {
+    PayloadClass payload_class = PayloadClass::Random;
+    if (!profile_.synthetic) {
+        payload_class = static_cast<PayloadClass>(payload_class_dist_(rng_));
+    }
+    return generate_block(size_bytes, offset, algorithm, payload_class);
+}
+
+FileBlock TestDataGenerator::generate_block(size_t size_bytes, uint64_t offset,
+                                            ChecksumAlgorithm algorithm,
+                                            PayloadClass payload_class) {
     FileBlock block;
     
     // Generate a unique block ID (hex string)
@@ -73,13 +335,28 @@ FileBlock TestDataGenerator::generate_block(size_t size_bytes, uint64_t offset)
     // Set the offset
     block.offset = offset;
     
-    // Generate random data
+    // Generate the payload; resize leaves it zeroed for PayloadClass::Zeros
     block.data.resize(size_bytes);
-    std::generate(block.data.begin(), block.data.end(), 
-                  [this]() { return byte_dist_(rng_); });
+    switch (payload_class) {
+        case PayloadClass::Random:
+            payload_rng_.fill(block.data.data(), block.data.size());
+            break;
+        case PayloadClass::Zeros:
+            break;
+        case PayloadClass::Text:
+            fill_text(block.data.data(), block.data.size());
+            break;
+        case PayloadClass::Logs:
+            fill_logs(block.data.data(), block.data.size());
+            break;
+        case PayloadClass::Compressed:
+            fill_compressed(block.data.data(), block.data.size());
+            break;
+    }
     
     // Calculate checksum
-    block.checksum = benchmark::calculate_checksum(block.data);
+    block.checksum_algorithm = algorithm;
+    block.checksum = benchmark::calculate_checksum(block.data, algorithm);
     
     return block;
 }
@@ -108,6 +385,56 @@ std::vector<FileBlock> TestDataGenerator::generate_block_batch(const std::vector
     return batch;
 }
 
+std::vector<FileMetadata> TestDataGenerator::generate_metadata_batch_parallel(size_t count,
+                                                                              unsigned threads) {
+    std::vector<FileMetadata> batch(count);
+    uint64_t batch_seed = next_batch_seed();
+    size_t chunks = (count + METADATA_CHUNK - 1) / METADATA_CHUNK;
+    
+    run_chunks(chunks, threads, [&](size_t chunk) {
+        TestDataGenerator generator(substream_seed(batch_seed, chunk), reference_time_, profile_);
+        size_t end = std::min(count, (chunk + 1) * METADATA_CHUNK);
+        for (size_t i = chunk * METADATA_CHUNK; i < end; ++i) {
+            batch[i] = generator.generate_metadata();
+        }
+    });
+    
+    return batch;
+}
+
+std::vector<FileBlock> TestDataGenerator::generate_block_batch_parallel(const std::vector<size_t>& sizes,
+                                                                        ChecksumAlgorithm algorithm,
+                                                                        unsigned threads) {
+    // Offsets and chunk boundaries depend only on the sizes
+    std::vector<uint64_t> offsets(sizes.size());
+    std::vector<size_t> chunk_starts;
+    uint64_t current_offset = 0;
+    size_t chunk_bytes = 0;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (chunk_starts.empty() || i - chunk_starts.back() == BLOCK_CHUNK_COUNT ||
+            chunk_bytes >= BLOCK_CHUNK_BYTES) {
+            chunk_starts.push_back(i);
+            chunk_bytes = 0;
+        }
+        offsets[i] = current_offset;
+        current_offset += sizes[i];
+        chunk_bytes += sizes[i];
+    }
+    chunk_starts.push_back(sizes.size());
+    
+    std::vector<FileBlock> batch(sizes.size());
+    uint64_t batch_seed = next_batch_seed();
+    
+    run_chunks(chunk_starts.size() - 1, threads, [&](size_t chunk) {
+        TestDataGenerator generator(substream_seed(batch_seed, chunk), reference_time_, profile_);
+        for (size_t i = chunk_starts[chunk]; i < chunk_starts[chunk + 1]; ++i) {
+            batch[i] = generator.generate_block(sizes[i], offsets[i], algorithm);
+        }
+    });
+    
+    return batch;
+}
+
 std::string TestDataGenerator::random_string(size_t length) {
     static const char charset[] = "abcdefghijklmnopqrstuvwxyz0123456789";
     std::uniform_int_distribution<size_t> dist(0, sizeof(charset) - 2);
@@ -120,4 +447,131 @@ std::string TestDataGenerator::random_string(size_t length) {
     return result;
 }
 
-} // namespace benchmark
\ No newline at end of file
+std::string TestDataGenerator::random_path_prefix() {
+    size_t depth = std::uniform_int_distribution<size_t>(profile_.min_depth, profile_.max_depth)(rng_);
+    
+    std::string path;
+    for (size_t level = 0; level < depth; ++level) {
+        // Rotate the vocabulary per level so the most popular rank differs by depth
+        size_t rank = directory_dist_(rng_);
+        size_t word = (rank + level * 7) % DIRECTORY_NAME_COUNT;
+        path += '/';
+        path += DIRECTORY_NAMES[word];
+        if (rank >= DIRECTORY_NAME_COUNT) {
+            path += '-';
+            path += std::to_string(rank / DIRECTORY_NAME_COUNT);
+        }
+    }
+    return path;
+}
+
+std::string TestDataGenerator::random_file_name() {
+    size_t length = std::uniform_int_distribution<size_t>(profile_.min_name_length,
+                                                          profile_.max_name_length)(rng_);
+    bool utf8 = std::bernoulli_distribution(profile_.utf8_name_fraction)(rng_);
+    
+    std::uniform_int_distribution<size_t> ascii_dist(0, sizeof(NAME_CHARSET) - 2);
+    std::uniform_int_distribution<size_t> utf8_dist(0, UTF8_CHARACTER_COUNT - 1);
+    std::bernoulli_distribution multibyte_dist(0.4);
+    
+    std::string name;
+    name.reserve(length * 2 + 8);
+    for (size_t i = 0; i < length; ++i) {
+        if (utf8 && multibyte_dist(rng_)) {
+            name += UTF8_CHARACTERS[utf8_dist(rng_)];
+        } else {
+            name += NAME_CHARSET[ascii_dist(rng_)];
+        }
+    }
+    
+    static const ZipfDistribution extension_dist(EXTENSION_COUNT, 1.0);
+    name += '.';
+    name += EXTENSIONS[extension_dist(rng_)];
+    return name;
+}
+
+uint64_t TestDataGenerator::random_file_size() {
+    double size;
+    if (std::bernoulli_distribution(profile_.size_tail_fraction)(rng_)) {
+        // Pareto tail starting two standard deviations above the log-normal median
+        double scale = std::exp(profile_.size_log_mean + 2.0 * profile_.size_log_sigma);
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+        size = scale / std::pow(1.0 - u, 1.0 / profile_.size_tail_alpha);
+    } else {
+        size = std::lognormal_distribution<double>(profile_.size_log_mean,
+                                                   profile_.size_log_sigma)(rng_);
+    }
+    
+    size = std::min(std::max(size, static_cast<double>(profile_.min_size)),
+                    static_cast<double>(profile_.max_size));
+    return static_cast<uint64_t>(size);
+}
+
+void TestDataGenerator::fill_text(uint8_t* out, size_t size) {
+    static const WordTable table;
+    ByteSource random(payload_rng_);
+    
+    size_t pos = 0;
+    while (pos < size) {
+        size_t word = table.index[random.next()];
+        size_t length = std::min<size_t>(table.length[word], size - pos);
+        std::memcpy(out + pos, TEXT_WORDS[word], length);
+        pos += length;
+        if (pos < size) {
+            // Roughly one line break per 12 words
+            out[pos++] = random.next() < 21 ? '\n' : ' ';
+        }
+    }
+}
+
+void TestDataGenerator::fill_logs(uint8_t* out, size_t size) {
+    ByteSource random(payload_rng_);
+    
+    // Lines start in the day before the reference time and advance 0-255 ms each
+    int64_t clock_ms = (static_cast<int64_t>(reference_time_) - 86400) * 1000 +
+                       random.next() * 1000;
+    char line[160];
+    size_t pos = 0;
+    while (pos < size) {
+        clock_ms += random.next();
+        
+        char* p = write_timestamp(line, clock_ms);
+        *p++ = ' ';
+        p = write_string(p, LOG_LEVELS[random.next() & 7]);
+        p = write_string(p, " [svc-");
+        p = write_digits(p, random.next() & 15, 2);
+        p = write_string(p, "] ");
+        p = write_string(p, LOG_METHODS[random.next() & 7]);
+        p = write_string(p, " /api/v1/");
+        p = write_string(p, LOG_RESOURCES[random.next() & 7]);
+        *p++ = '/';
+        uint32_t id = random.next();
+        id = (id << 8 | random.next()) & 0x3FFF;
+        p = write_digits(p, id, 5);
+        p = write_string(p, " status=");
+        p = write_string(p, LOG_STATUSES[random.next() & 7]);
+        p = write_string(p, " latency_ms=");
+        uint32_t latency = random.next() % 64;
+        latency = latency * random.next() % 1000;
+        p = write_digits(p, latency, 3);
+        *p++ = '\n';
+        
+        size_t length = std::min(static_cast<size_t>(p - line), size - pos);
+        std::memcpy(out + pos, line, length);
+        pos += length;
+    }
+}
+
+void TestDataGenerator::fill_compressed(uint8_t* out, size_t size) {
+    // Random frame contents behind a zstd frame header every 128 KiB, which is
+    // as far as a serializer or compressor can tell from real compressed output
+    const size_t FRAME_SIZE = 128 * 1024;
+    static const uint8_t FRAME_HEADER[] = {0x28, 0xB5, 0x2F, 0xFD, 0x64, 0x00, 0x00, 0x02};
+    
+    payload_rng_.fill(out, size);
+    for (size_t pos = 0; pos < size; pos += FRAME_SIZE) {
+        std::memcpy(out + pos, FRAME_HEADER, std::min(sizeof(FRAME_HEADER), size - pos));
+    }
+}
+
+} // namespace benchmark
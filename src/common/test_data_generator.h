@@ -2,33 +2,89 @@
 
 #include <vector>
 #include <random>
+#include <ctime>
 #include "common/data_structures.h"
+#include "common/fast_random.h"
+#include "common/workload_profile.h"
 
 namespace benchmark {
 
 class TestDataGenerator {
 public:
-    TestDataGenerator(unsigned int seed = std::random_device{}());
+    TestDataGenerator(unsigned int seed = std::random_device{}(),
+                      const WorkloadProfile& profile = default_workload_profile());
     
-    // Generate file metadata with random values
-    FileMetadata generate_metadata(size_t tag_count = 3);
+    // Generate file metadata shaped by the profile
+    FileMetadata generate_metadata();
     
-    // Generate file block with random data of specified size
-    FileBlock generate_block(size_t size_bytes, uint64_t offset = 0);
+    // Same, with a fixed number of tags
+    FileMetadata generate_metadata(size_t tag_count);
+    
+    // Generate a file block of the specified size; the payload class is drawn
+    // from the profile's payload mix
+    FileBlock generate_block(size_t size_bytes, uint64_t offset = 0,
+                             ChecksumAlgorithm algorithm = ChecksumAlgorithm::Adler32);
+    
+    // Same, with a fixed payload class
+    FileBlock generate_block(size_t size_bytes, uint64_t offset, ChecksumAlgorithm algorithm,
+                             PayloadClass payload_class);
     
     // Generate a vector of file metadata entries
     std::vector<FileMetadata> generate_metadata_batch(size_t count);
     
     // Generate a vector of file blocks with specified sizes
     std::vector<FileBlock> generate_block_batch(const std::vector<size_t>& sizes);
+    
+    // Parallel batch generation. Work is cut into chunks that depend only on the
+    // request, and each chunk draws from its own substream derived from the seed,
+    // so the output is the same for any thread count (threads = 0 uses all cores).
+    // It differs from the serial batch methods; each call yields a new batch.
+    std::vector<FileMetadata> generate_metadata_batch_parallel(size_t count, unsigned threads = 0);
+    std::vector<FileBlock> generate_block_batch_parallel(
+        const std::vector<size_t>& sizes,
+        ChecksumAlgorithm algorithm = ChecksumAlgorithm::Adler32,
+        unsigned threads = 0);
+    
+    // Timestamps fall in the year before this instant (construction time by default)
+    time_t reference_time() const { return reference_time_; }
+    void set_reference_time(time_t reference_time) { reference_time_ = reference_time; }
+    
+    const WorkloadProfile& profile() const { return profile_; }
+    void set_profile(const WorkloadProfile& profile);
 
 private:
+    // Substream generator for one chunk of a parallel batch
+    TestDataGenerator(uint64_t stream_seed, time_t reference_time, const WorkloadProfile& profile);
+    
+    uint64_t next_batch_seed();
+    
     std::mt19937 rng_;
-    std::uniform_int_distribution<uint8_t> byte_dist_;
+    BulkRandomGenerator payload_rng_;  // Block payloads, 32 bytes per step
+    uint64_t seed_;
+    uint64_t parallel_batches_ = 0;
+    time_t reference_time_;
+    
+    // Profile and the samplers derived from it
+    WorkloadProfile profile_;
+    ZipfDistribution directory_dist_;
+    ZipfDistribution tag_dist_;
+    ZipfDistribution owner_dist_;
+    std::discrete_distribution<size_t> payload_class_dist_;
     
     // Helper method to generate a random string
     std::string random_string(size_t length);
     
+    // Profile-shaped metadata fields
+    FileMetadata generate_synthetic_metadata(size_t tag_count);
+    std::string random_path_prefix();
+    std::string random_file_name();
+    uint64_t random_file_size();
+    
+    // Payload fillers for the non-trivial entropy classes
+    void fill_text(uint8_t* out, size_t size);
+    void fill_logs(uint8_t* out, size_t size);
+    void fill_compressed(uint8_t* out, size_t size);
+    
     // Helper method to calculate simple checksum
     uint32_t calculate_checksum(const std::vector<uint8_t>& data);
 };
@@ -1,13 +1,698 @@
 #include "common/utilities.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BENCHMARK_X86_SIMD 1
+#endif
 
 namespace benchmark {
-    uint32_t calculate_checksum(const std::vector<uint8_t>& data) {
+    namespace {
         const uint32_t MOD_ADLER = 65521;
-        uint32_t a = 1, b = 0;
-        for (uint8_t byte : data) {
-            a = (a + byte) % MOD_ADLER;
-            b = (b + a) % MOD_ADLER;
+
+        // Largest n such that 255n(n+1)/2 + (n+1)(MOD_ADLER-1) fits in 32 bits,
+        // i.e. how many bytes can be summed before a modulo is required
+        const size_t NMAX = 5552;
+
+        using Adler32Function = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+        using Crc32cFunction = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+        // Reflected Castagnoli polynomial
+        const uint32_t CRC32C_POLY = 0x82F63B78;
+
+        // Slicing-by-8 tables for the portable CRC-32C
+        using Crc32cTables = std::array<std::array<uint32_t, 256>, 8>;
+
+        Crc32cTables make_crc32c_tables() {
+            Crc32cTables tables{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int j = 0; j < 8; ++j) {
+                    crc = (crc >> 1) ^ (CRC32C_POLY & (0 - (crc & 1)));
+                }
+                tables[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (size_t t = 1; t < 8; ++t) {
+                    tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+                }
+            }
+            return tables;
+        }
+
+        inline uint64_t rotl64(uint64_t value, int bits) {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        inline uint64_t read_u64(const uint8_t* p) {
+            uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            value = __builtin_bswap64(value);
+#endif
+            return value;
+        }
+
+        inline uint32_t read_u32(const uint8_t* p) {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            value = __builtin_bswap32(value);
+#endif
+            return value;
+        }
+
+        const uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+        const uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+        const uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+        const uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+        const uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+        inline uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+            acc += input * XXH_PRIME64_2;
+            acc = rotl64(acc, 31);
+            return acc * XXH_PRIME64_1;
+        }
+
+        inline uint64_t xxh64_merge_round(uint64_t acc, uint64_t value) {
+            acc ^= xxh64_round(0, value);
+            return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+        }
+
+        const size_t XXH_STRIPE_SIZE = 32;
+
+        void xxh64_init_lanes(uint64_t lanes[4], uint64_t seed) {
+            lanes[0] = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+            lanes[1] = seed + XXH_PRIME64_2;
+            lanes[2] = seed;
+            lanes[3] = seed - XXH_PRIME64_1;
+        }
+
+        // Folds every whole 32-byte stripe into the lanes; returns the unconsumed tail
+        const uint8_t* xxh64_consume_stripes(uint64_t lanes[4], const uint8_t* data, size_t size) {
+            const uint8_t* end = data + size;
+            while (end - data >= static_cast<ptrdiff_t>(XXH_STRIPE_SIZE)) {
+                lanes[0] = xxh64_round(lanes[0], read_u64(data));
+                lanes[1] = xxh64_round(lanes[1], read_u64(data + 8));
+                lanes[2] = xxh64_round(lanes[2], read_u64(data + 16));
+                lanes[3] = xxh64_round(lanes[3], read_u64(data + 24));
+                data += XXH_STRIPE_SIZE;
+            }
+            return data;
+        }
+
+        // tail holds the last total_length % 32 bytes of the input
+        uint64_t xxh64_finalize(const uint64_t lanes[4], uint64_t seed, uint64_t total_length,
+                                const uint8_t* tail, size_t tail_size) {
+            uint64_t hash;
+            if (total_length >= XXH_STRIPE_SIZE) {
+                hash = rotl64(lanes[0], 1) + rotl64(lanes[1], 7) +
+                       rotl64(lanes[2], 12) + rotl64(lanes[3], 18);
+                hash = xxh64_merge_round(hash, lanes[0]);
+                hash = xxh64_merge_round(hash, lanes[1]);
+                hash = xxh64_merge_round(hash, lanes[2]);
+                hash = xxh64_merge_round(hash, lanes[3]);
+            } else {
+                hash = seed + XXH_PRIME64_5;
+            }
+
+            hash += total_length;
+
+            const uint8_t* end = tail + tail_size;
+            while (end - tail >= 8) {
+                hash ^= xxh64_round(0, read_u64(tail));
+                hash = rotl64(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+                tail += 8;
+            }
+            if (end - tail >= 4) {
+                hash ^= static_cast<uint64_t>(read_u32(tail)) * XXH_PRIME64_1;
+                hash = rotl64(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+                tail += 4;
+            }
+            while (tail < end) {
+                hash ^= (*tail++) * XXH_PRIME64_5;
+                hash = rotl64(hash, 11) * XXH_PRIME64_1;
+            }
+
+            // Avalanche
+            hash ^= hash >> 33;
+            hash *= XXH_PRIME64_2;
+            hash ^= hash >> 29;
+            hash *= XXH_PRIME64_3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        // Multiplies a and b modulo the CRC-32C polynomial (reflected bit order)
+        uint32_t crc32c_multiply(uint32_t a, uint32_t b) {
+            uint32_t product = 0;
+            for (uint32_t mask = 1u << 31; mask != 0; mask >>= 1) {
+                if (a & mask) {
+                    product ^= b;
+                }
+                b = (b & 1) ? (b >> 1) ^ CRC32C_POLY : b >> 1;
+            }
+            return product;
+        }
+
+        // x^(8 * length) modulo the CRC-32C polynomial
+        uint32_t crc32c_shift(uint64_t length) {
+            // Powers x^(2^k), k = 3.. (i.e. one byte, two bytes, four bytes, ...)
+            static const std::array<uint32_t, 64> powers = []() {
+                std::array<uint32_t, 64> table{};
+                uint32_t power = 1u << 30; // x^1
+                for (int k = 0; k < 3; ++k) {
+                    power = crc32c_multiply(power, power);
+                }
+                for (auto& entry : table) {
+                    entry = power;
+                    power = crc32c_multiply(power, power);
+                }
+                return table;
+            }();
+
+            uint32_t result = 1u << 31; // x^0
+            for (size_t k = 0; length != 0; length >>= 1, ++k) {
+                if (length & 1) {
+                    result = crc32c_multiply(powers[k], result);
+                }
+            }
+            return result;
+        }
+
+#ifdef BENCHMARK_X86_SIMD
+        __attribute__((target("ssse3")))
+        uint32_t adler32_update_ssse3(uint32_t adler, const uint8_t* data, size_t size) {
+            const size_t BLOCK_SIZE = 32;
+            uint32_t a = adler & 0xFFFF;
+            uint32_t b = adler >> 16;
+
+            size_t blocks = size / BLOCK_SIZE;
+            size -= blocks * BLOCK_SIZE;
+
+            const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                               24, 23, 22, 21, 20, 19, 18, 17);
+            const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,
+                                               8, 7, 6, 5, 4, 3, 2, 1);
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i ones = _mm_set1_epi16(1);
+
+            while (blocks) {
+                size_t n = NMAX / BLOCK_SIZE;
+                if (n > blocks) {
+                    n = blocks;
+                }
+                blocks -= n;
+
+                // v_ps accumulates the running a at the start of each block;
+                // it contributes 32 * a to b per block
+                __m128i v_ps = _mm_set_epi32(0, 0, 0, static_cast<int>(a * n));
+                __m128i v_s2 = _mm_set_epi32(0, 0, 0, static_cast<int>(b));
+                __m128i v_s1 = zero;
+
+                do {
+                    const __m128i bytes1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+                    const __m128i bytes2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+
+                    v_ps = _mm_add_epi32(v_ps, v_s1);
+
+                    v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+                    v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+                    v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+                    v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+
+                    data += BLOCK_SIZE;
+                } while (--n);
+
+                v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+                // Horizontal sums
+                v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(2, 3, 0, 1)));
+                v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(1, 0, 3, 2)));
+                a += static_cast<uint32_t>(_mm_cvtsi128_si32(v_s1));
+
+                v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(2, 3, 0, 1)));
+                v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(1, 0, 3, 2)));
+                b = static_cast<uint32_t>(_mm_cvtsi128_si32(v_s2));
+
+                a %= MOD_ADLER;
+                b %= MOD_ADLER;
+            }
+
+            // Fewer than BLOCK_SIZE bytes remain
+            return adler32_update_scalar((b << 16) | a, data, size);
+        }
+
+        __attribute__((target("avx2")))
+        uint32_t adler32_update_avx2(uint32_t adler, const uint8_t* data, size_t size) {
+            const size_t BLOCK_SIZE = 32;
+            uint32_t a = adler & 0xFFFF;
+            uint32_t b = adler >> 16;
+
+            size_t blocks = size / BLOCK_SIZE;
+            size -= blocks * BLOCK_SIZE;
+
+            const __m256i tap = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                                 24, 23, 22, 21, 20, 19, 18, 17,
+                                                 16, 15, 14, 13, 12, 11, 10, 9,
+                                                 8, 7, 6, 5, 4, 3, 2, 1);
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i ones = _mm256_set1_epi16(1);
+
+            while (blocks) {
+                size_t n = NMAX / BLOCK_SIZE;
+                if (n > blocks) {
+                    n = blocks;
+                }
+                blocks -= n;
+
+                __m256i v_ps = _mm256_set_epi32(0, 0, 0, 0, 0, 0, 0, static_cast<int>(a * n));
+                __m256i v_s2 = _mm256_set_epi32(0, 0, 0, 0, 0, 0, 0, static_cast<int>(b));
+                __m256i v_s1 = zero;
+
+                do {
+                    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+
+                    v_ps = _mm256_add_epi32(v_ps, v_s1);
+                    v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(bytes, zero));
+                    v_s2 = _mm256_add_epi32(v_s2, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, tap), ones));
+
+                    data += BLOCK_SIZE;
+                } while (--n);
+
+                v_s2 = _mm256_add_epi32(v_s2, _mm256_slli_epi32(v_ps, 5));
+
+                // Fold the two 128-bit halves, then sum the four lanes
+                __m128i s1 = _mm_add_epi32(_mm256_castsi256_si128(v_s1), _mm256_extracti128_si256(v_s1, 1));
+                s1 = _mm_add_epi32(s1, _mm_shuffle_epi32(s1, _MM_SHUFFLE(2, 3, 0, 1)));
+                s1 = _mm_add_epi32(s1, _mm_shuffle_epi32(s1, _MM_SHUFFLE(1, 0, 3, 2)));
+                a += static_cast<uint32_t>(_mm_cvtsi128_si32(s1));
+
+                __m128i s2 = _mm_add_epi32(_mm256_castsi256_si128(v_s2), _mm256_extracti128_si256(v_s2, 1));
+                s2 = _mm_add_epi32(s2, _mm_shuffle_epi32(s2, _MM_SHUFFLE(2, 3, 0, 1)));
+                s2 = _mm_add_epi32(s2, _mm_shuffle_epi32(s2, _MM_SHUFFLE(1, 0, 3, 2)));
+                b = static_cast<uint32_t>(_mm_cvtsi128_si32(s2));
+
+                a %= MOD_ADLER;
+                b %= MOD_ADLER;
+            }
+
+            return adler32_update_scalar((b << 16) | a, data, size);
+        }
+
+        __attribute__((target("sse4.2")))
+        uint32_t crc32c_update_sse42(uint32_t crc, const uint8_t* data, size_t size) {
+            uint64_t crc64 = ~crc;
+            while (size >= 8) {
+                uint64_t word;
+                std::memcpy(&word, data, sizeof(word));
+                crc64 = _mm_crc32_u64(crc64, word);
+                data += 8;
+                size -= 8;
+            }
+            uint32_t crc32 = static_cast<uint32_t>(crc64);
+            while (size--) {
+                crc32 = _mm_crc32_u8(crc32, *data++);
+            }
+            return ~crc32;
+        }
+#endif
+
+        std::vector<ChecksumImplementation> supported_adler32() {
+            std::vector<ChecksumImplementation> implementations = {{"scalar", adler32_update_scalar}};
+#ifdef BENCHMARK_X86_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("ssse3")) {
+                implementations.push_back({"ssse3", adler32_update_ssse3});
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                implementations.push_back({"avx2", adler32_update_avx2});
+            }
+#endif
+            return implementations;
         }
+
+        std::vector<ChecksumImplementation> supported_crc32c() {
+            std::vector<ChecksumImplementation> implementations = {{"portable", crc32c_update_portable}};
+#ifdef BENCHMARK_X86_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("sse4.2")) {
+                implementations.push_back({"sse4.2", crc32c_update_sse42});
+            }
+#endif
+            return implementations;
+        }
+
+        // Implementations are chosen once, on first use, so callers from other
+        // static initializers are safe. The last supported one is the fastest.
+        struct ChecksumDispatch {
+            const char* adler32_name;
+            Adler32Function adler32;
+            const char* crc32c_name;
+            Crc32cFunction crc32c;
+
+            ChecksumDispatch() {
+                ChecksumImplementation adler = supported_adler32().back();
+                ChecksumImplementation crc = supported_crc32c().back();
+                adler32_name = adler.name;
+                adler32 = adler.update;
+                crc32c_name = crc.name;
+                crc32c = crc.update;
+            }
+        };
+
+        const ChecksumDispatch& checksum_dispatch() {
+            static const ChecksumDispatch dispatch;
+            return dispatch;
+        }
+    }
+
+    uint32_t calculate_checksum(const std::vector<uint8_t>& data) {
+        return adler32_update(1, data.data(), data.size());
+    }
+
+    uint32_t adler32_update(uint32_t adler, const uint8_t* data, size_t size) {
+        return checksum_dispatch().adler32(adler, data, size);
+    }
+
+    uint32_t adler32_update_scalar(uint32_t adler, const uint8_t* data, size_t size) {
+        uint32_t a = adler & 0xFFFF;
+        uint32_t b = adler >> 16;
+
+        // Sum NMAX bytes at a time and reduce once per chunk instead of per byte
+        while (size > 0) {
+            size_t chunk = size < NMAX ? size : NMAX;
+            size -= chunk;
+
+            while (chunk >= 8) {
+                a += data[0]; b += a;
+                a += data[1]; b += a;
+                a += data[2]; b += a;
+                a += data[3]; b += a;
+                a += data[4]; b += a;
+                a += data[5]; b += a;
+                a += data[6]; b += a;
+                a += data[7]; b += a;
+                data += 8;
+                chunk -= 8;
+            }
+            while (chunk--) {
+                a += *data++;
+                b += a;
+            }
+
+            a %= MOD_ADLER;
+            b %= MOD_ADLER;
+        }
+
         return (b << 16) | a;
     }
-}
\ No newline at end of file
+
+    const char* adler32_implementation() {
+        return checksum_dispatch().adler32_name;
+    }
+
+    uint64_t calculate_checksum(const std::vector<uint8_t>& data, ChecksumAlgorithm algorithm) {
+        return calculate_checksum(data.data(), data.size(), algorithm);
+    }
+
+    uint64_t calculate_checksum(const uint8_t* data, size_t size, ChecksumAlgorithm algorithm) {
+        switch (algorithm) {
+            case ChecksumAlgorithm::Adler32:
+                return adler32_update(1, data, size);
+            case ChecksumAlgorithm::Crc32c:
+                return crc32c_update(0, data, size);
+            case ChecksumAlgorithm::XxHash64:
+                return xxhash64(data, size);
+        }
+        throw std::invalid_argument("Unknown checksum algorithm");
+    }
+
+    uint32_t crc32c_update(uint32_t crc, const uint8_t* data, size_t size) {
+        return checksum_dispatch().crc32c(crc, data, size);
+    }
+
+    uint32_t crc32c_update_portable(uint32_t crc, const uint8_t* data, size_t size) {
+        static const Crc32cTables tables = make_crc32c_tables();
+
+        crc = ~crc;
+        while (size >= 8) {
+            uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            word = __builtin_bswap64(word);
+#endif
+            word ^= crc;
+            crc = tables[7][word & 0xFF] ^
+                  tables[6][(word >> 8) & 0xFF] ^
+                  tables[5][(word >> 16) & 0xFF] ^
+                  tables[4][(word >> 24) & 0xFF] ^
+                  tables[3][(word >> 32) & 0xFF] ^
+                  tables[2][(word >> 40) & 0xFF] ^
+                  tables[1][(word >> 48) & 0xFF] ^
+                  tables[0][word >> 56];
+            data += 8;
+            size -= 8;
+        }
+        while (size--) {
+            crc = (crc >> 8) ^ tables[0][(crc ^ *data++) & 0xFF];
+        }
+        return ~crc;
+    }
+
+    const char* crc32c_implementation() {
+        return checksum_dispatch().crc32c_name;
+    }
+
+    std::vector<ChecksumImplementation> adler32_implementations() {
+        return supported_adler32();
+    }
+
+    std::vector<ChecksumImplementation> crc32c_implementations() {
+        return supported_crc32c();
+    }
+
+    uint64_t xxhash64(const uint8_t* data, size_t size, uint64_t seed) {
+        uint64_t lanes[4];
+        xxh64_init_lanes(lanes, seed);
+        const uint8_t* tail = xxh64_consume_stripes(lanes, data, size);
+        return xxh64_finalize(lanes, seed, size, tail, data + size - tail);
+    }
+
+    uint32_t adler32_combine(uint32_t adler_a, uint32_t adler_b, uint64_t length_b) {
+        // Same derivation as zlib's adler32_combine: B's running sum picks up
+        // A's byte sum once per byte of B
+        uint32_t remainder = static_cast<uint32_t>(length_b % MOD_ADLER);
+        uint32_t sum1 = adler_a & 0xFFFF;
+        uint32_t sum2 = static_cast<uint32_t>((static_cast<uint64_t>(remainder) * sum1) % MOD_ADLER);
+
+        sum1 += (adler_b & 0xFFFF) + MOD_ADLER - 1;
+        sum2 += (adler_a >> 16) + (adler_b >> 16) + MOD_ADLER - remainder;
+        if (sum1 >= MOD_ADLER) sum1 -= MOD_ADLER;
+        if (sum1 >= MOD_ADLER) sum1 -= MOD_ADLER;
+        if (sum2 >= 2 * MOD_ADLER) sum2 -= 2 * MOD_ADLER;
+        if (sum2 >= MOD_ADLER) sum2 -= MOD_ADLER;
+
+        return (sum2 << 16) | sum1;
+    }
+
+    uint32_t crc32c_combine(uint32_t crc_a, uint32_t crc_b, uint64_t length_b) {
+        // Shifting A's CRC past length_b zero bytes, then xoring in B's
+        return crc32c_multiply(crc32c_shift(length_b), crc_a) ^ crc_b;
+    }
+
+    bool checksum_is_combinable(ChecksumAlgorithm algorithm) {
+        return algorithm != ChecksumAlgorithm::XxHash64;
+    }
+
+    ChecksumState::ChecksumState(ChecksumAlgorithm algorithm)
+        : algorithm_(algorithm) {
+        if (!is_checksum_algorithm(static_cast<uint64_t>(algorithm))) {
+            throw std::invalid_argument("Unknown checksum algorithm");
+        }
+        reset();
+    }
+
+    void ChecksumState::reset() {
+        length_ = 0;
+        value_ = algorithm_ == ChecksumAlgorithm::Adler32 ? 1 : 0;
+        xxh64_init_lanes(lanes_, 0);
+        buffered_ = 0;
+    }
+
+    void ChecksumState::update(const uint8_t* data, size_t size) {
+        length_ += size;
+
+        switch (algorithm_) {
+            case ChecksumAlgorithm::Adler32:
+                value_ = adler32_update(value_, data, size);
+                return;
+            case ChecksumAlgorithm::Crc32c:
+                value_ = crc32c_update(value_, data, size);
+                return;
+            case ChecksumAlgorithm::XxHash64:
+                break;
+        }
+
+        // Top up a partial stripe first, then stream whole stripes from the input
+        if (buffered_ > 0) {
+            size_t take = std::min(size, XXH_STRIPE_SIZE - buffered_);
+            std::memcpy(stripe_ + buffered_, data, take);
+            buffered_ += take;
+            data += take;
+            size -= take;
+            if (buffered_ < XXH_STRIPE_SIZE) {
+                return;
+            }
+            xxh64_consume_stripes(lanes_, stripe_, XXH_STRIPE_SIZE);
+            buffered_ = 0;
+        }
+
+        const uint8_t* tail = xxh64_consume_stripes(lanes_, data, size);
+        buffered_ = data + size - tail;
+        if (buffered_ > 0) {
+            std::memcpy(stripe_, tail, buffered_);
+        }
+    }
+
+    void ChecksumState::combine(const ChecksumState& next) {
+        if (next.algorithm_ != algorithm_) {
+            throw std::invalid_argument("Cannot combine checksums of different algorithms");
+        }
+
+        switch (algorithm_) {
+            case ChecksumAlgorithm::Adler32:
+                value_ = adler32_combine(value_, next.value_, next.length_);
+                break;
+            case ChecksumAlgorithm::Crc32c:
+                value_ = crc32c_combine(value_, next.value_, next.length_);
+                break;
+            case ChecksumAlgorithm::XxHash64:
+                throw std::invalid_argument("xxHash64 checksums cannot be combined");
+        }
+        length_ += next.length_;
+    }
+
+    uint64_t ChecksumState::finalize() const {
+        if (algorithm_ == ChecksumAlgorithm::XxHash64) {
+            return xxh64_finalize(lanes_, 0, length_, stripe_, buffered_);
+        }
+        return value_;
+    }
+
+    void append_with_checksum(std::vector<uint8_t>& out, const uint8_t* src, size_t size,
+                              ChecksumState& state) {
+        const size_t STRIP_SIZE = 8 * 1024;
+
+        // reserve + insert copies without zero-filling the destination first
+        out.reserve(out.size() + size);
+        while (size > 0) {
+            size_t n = std::min(size, STRIP_SIZE);
+            size_t pos = out.size();
+            out.insert(out.end(), src, src + n);
+            state.update(out.data() + pos, n);
+            src += n;
+            size -= n;
+        }
+    }
+
+    uint64_t checksum_parallel(const uint8_t* data, size_t size, ChecksumAlgorithm algorithm,
+                               unsigned threads) {
+        // Below this a chunk costs less to checksum than a thread costs to start
+        const size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size_t chunks = std::min<size_t>(threads, size / MIN_CHUNK_SIZE);
+        if (chunks <= 1 || !checksum_is_combinable(algorithm)) {
+            return calculate_checksum(data, size, algorithm);
+        }
+
+        std::vector<ChecksumState> states(chunks, ChecksumState(algorithm));
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+
+        size_t chunk_size = size / chunks;
+        for (size_t i = 1; i < chunks; ++i) {
+            size_t begin = i * chunk_size;
+            size_t length = (i + 1 == chunks) ? size - begin : chunk_size;
+            workers.emplace_back([&states, data, begin, length, i]() {
+                states[i].update(data + begin, length);
+            });
+        }
+
+        // The calling thread takes the first chunk
+        states[0].update(data, chunk_size);
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (size_t i = 1; i < chunks; ++i) {
+            states[0].combine(states[i]);
+        }
+        return states[0].finalize();
+    }
+
+    uint64_t checksum_parallel(const std::vector<uint8_t>& data, ChecksumAlgorithm algorithm,
+                               unsigned threads) {
+        return checksum_parallel(data.data(), data.size(), algorithm, threads);
+    }
+
+    const char* checksum_algorithm_name(ChecksumAlgorithm algorithm) {
+        switch (algorithm) {
+            case ChecksumAlgorithm::Adler32:
+                return "adler32";
+            case ChecksumAlgorithm::Crc32c:
+                return "crc32c";
+            case ChecksumAlgorithm::XxHash64:
+                return "xxhash64";
+        }
+        return "unknown";
+    }
+
+    bool parse_checksum_algorithm(const std::string& name, ChecksumAlgorithm& algorithm) {
+        for (ChecksumAlgorithm candidate : {ChecksumAlgorithm::Adler32,
+                                            ChecksumAlgorithm::Crc32c,
+                                            ChecksumAlgorithm::XxHash64}) {
+            if (name == checksum_algorithm_name(candidate)) {
+                algorithm = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool is_checksum_algorithm(uint64_t value) {
+        return value <= static_cast<uint64_t>(ChecksumAlgorithm::XxHash64);
+    }
+
+    ChecksumAlgorithm checksum_algorithm_from_value(uint64_t value) {
+        if (!is_checksum_algorithm(value)) {
+            throw std::runtime_error("Unknown checksum algorithm " + std::to_string(value));
+        }
+        return static_cast<ChecksumAlgorithm>(value);
+    }
+
+    std::string json_escape(const std::string& value) {
+        std::string escaped;
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                escaped.push_back('\\');
+                escaped.push_back(c);
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                escaped += buffer;
+            } else {
+                escaped.push_back(c);
+            }
+        }
+        return escaped;
+    }
+}
@@ -1,7 +1,129 @@
 #pragma once
 #include <vector>
+#include <string>
+#include <cstddef>
 #include <cstdint>
 
 namespace benchmark {
+    /**
+     * Block checksum algorithms. The numeric values are part of every
+     * serialized FileBlock, so existing values must never change.
+     */
+    enum class ChecksumAlgorithm : uint8_t {
+        Adler32 = 0,   // zlib Adler-32, 32-bit
+        Crc32c = 1,    // CRC-32C (Castagnoli), SSE4.2 crc32 when available
+        XxHash64 = 2   // xxHash64 with seed 0, 64-bit
+    };
+
+    // Adler-32 of a whole buffer
     uint32_t calculate_checksum(const std::vector<uint8_t>& data);
+
+    // Checksum of a whole buffer with the given algorithm, widened to 64 bits
+    uint64_t calculate_checksum(const std::vector<uint8_t>& data, ChecksumAlgorithm algorithm);
+    uint64_t calculate_checksum(const uint8_t* data, size_t size, ChecksumAlgorithm algorithm);
+
+    // Continue an Adler-32 from a previous value (1 for an empty prefix).
+    // Dispatches at runtime to the fastest implementation the CPU supports.
+    uint32_t adler32_update(uint32_t adler, const uint8_t* data, size_t size);
+
+    // Portable implementation with deferred modulo, for comparison in tests
+    uint32_t adler32_update_scalar(uint32_t adler, const uint8_t* data, size_t size);
+
+    // Name of the implementation adler32_update dispatches to
+    const char* adler32_implementation();
+
+    // Continue a CRC-32C from a previous value (0 for an empty prefix).
+    // Uses the SSE4.2 crc32 instruction when the CPU supports it.
+    uint32_t crc32c_update(uint32_t crc, const uint8_t* data, size_t size);
+
+    // Portable slicing-by-8 implementation, for comparison in tests
+    uint32_t crc32c_update_portable(uint32_t crc, const uint8_t* data, size_t size);
+
+    // Name of the implementation crc32c_update dispatches to
+    const char* crc32c_implementation();
+
+    // One implementation of adler32_update or crc32c_update
+    struct ChecksumImplementation {
+        const char* name;
+        uint32_t (*update)(uint32_t value, const uint8_t* data, size_t size);
+    };
+
+    // Every implementation this CPU can run, portable first and the one
+    // dispatched to last, so tests can check each against the reference
+    std::vector<ChecksumImplementation> adler32_implementations();
+    std::vector<ChecksumImplementation> crc32c_implementations();
+
+    // xxHash64 of a buffer
+    uint64_t xxhash64(const uint8_t* data, size_t size, uint64_t seed = 0);
+
+    // Checksum of A followed by B, given the checksums of A and B and the length of B.
+    // O(log length) for CRC-32C and O(1) for Adler-32; neither touches the data.
+    uint32_t adler32_combine(uint32_t adler_a, uint32_t adler_b, uint64_t length_b);
+    uint32_t crc32c_combine(uint32_t crc_a, uint32_t crc_b, uint64_t length_b);
+
+    // Whether checksums of adjacent chunks can be merged (xxHash64 cannot)
+    bool checksum_is_combinable(ChecksumAlgorithm algorithm);
+
+    /**
+     * Incremental checksum for data that arrives in pieces, e.g. off a socket.
+     * Feeding a buffer through any sequence of update() calls produces the
+     * same value as calculate_checksum() over the whole buffer.
+     */
+    class ChecksumState {
+    public:
+        explicit ChecksumState(ChecksumAlgorithm algorithm = ChecksumAlgorithm::Adler32);
+
+        void update(const uint8_t* data, size_t size);
+        void update(const std::vector<uint8_t>& data) { update(data.data(), data.size()); }
+
+        // Append the checksum of data that directly follows everything seen so far.
+        // Both states must use the same combinable algorithm.
+        void combine(const ChecksumState& next);
+
+        // Checksum of everything seen so far; the state stays usable
+        uint64_t finalize() const;
+
+        void reset();
+
+        ChecksumAlgorithm algorithm() const { return algorithm_; }
+        uint64_t length() const { return length_; }
+
+    private:
+        ChecksumAlgorithm algorithm_;
+        uint64_t length_;
+        uint32_t value_;            // Running Adler-32 / CRC-32C
+
+        // xxHash64 streaming state: four lanes plus a partial 32-byte stripe
+        uint64_t lanes_[4];
+        uint8_t stripe_[32];
+        size_t buffered_;
+    };
+
+    // Appends src to out and feeds it to state in L1-sized strips, so each byte
+    // is checksummed while still in cache instead of in a second pass
+    void append_with_checksum(std::vector<uint8_t>& out, const uint8_t* src, size_t size,
+                              ChecksumState& state);
+
+    // Checksum of a buffer split across up to `threads` threads (0 = hardware
+    // concurrency). Chunks are merged with the combine functions, so the result
+    // equals calculate_checksum(); xxHash64 is always computed on one thread.
+    uint64_t checksum_parallel(const uint8_t* data, size_t size, ChecksumAlgorithm algorithm,
+                               unsigned threads = 0);
+    uint64_t checksum_parallel(const std::vector<uint8_t>& data, ChecksumAlgorithm algorithm,
+                               unsigned threads = 0);
+
+    // Algorithm names ("adler32", "crc32c", "xxhash64") and lookup by name
+    const char* checksum_algorithm_name(ChecksumAlgorithm algorithm);
+    bool parse_checksum_algorithm(const std::string& name, ChecksumAlgorithm& algorithm);
+
+    // Whether a serialized algorithm value names a ChecksumAlgorithm
+    bool is_checksum_algorithm(uint64_t value);
+
+    // The algorithm a decoded value names. Decoders read it from untrusted
+    // input, so an unknown value throws std::runtime_error rather than
+    // becoming an enumerator outside the enum.
+    ChecksumAlgorithm checksum_algorithm_from_value(uint64_t value);
+
+    // Escapes quotes, backslashes and control characters for a JSON string literal
+    std::string json_escape(const std::string& value);
 }
\ No newline at end of file
@@ -0,0 +1,277 @@
+#include "common/working_set.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "common/test_data_generator.h"
+#include "common/utilities.h"
+
+namespace benchmark {
+
+namespace {
+    // Fixed, so pools repeat from run to run
+    const time_t WORKING_SET_REFERENCE_TIME = 1700000000;
+
+    // Shortest prefix of sizes adding up to at least target (at least one
+    // entry), as (entries, bytes)
+    std::pair<size_t, size_t> prefix_for(const std::vector<size_t>& sizes, size_t target) {
+        size_t count = 0;
+        size_t bytes = 0;
+        while (count < sizes.size() && (count == 0 || bytes < target)) {
+            bytes += sizes[count];
+            ++count;
+        }
+        return {count, bytes};
+    }
+
+    template<typename T>
+    std::vector<T> prefix(const std::vector<T>& pool, size_t count) {
+        return std::vector<T>(pool.begin(), pool.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    // Hot, each working set and flushed results for one operation over one pool
+    template<typename T>
+    void measure_modes(const std::vector<T>& pool,
+                       const std::vector<size_t>& item_bytes,
+                       const std::vector<size_t>& working_sets,
+                       const WorkingSetOptions& options,
+                       const std::function<BenchmarkResult(BenchmarkRunner&, const std::vector<T>&)>& benchmark,
+                       std::vector<WorkingSetResult>& results) {
+        BenchmarkRunner runner(options.timing);
+        std::vector<T> single = prefix(pool, 1);
+
+        WorkingSetResult hot;
+        hot.mode = "hot";
+        hot.working_set_bytes = item_bytes[0];
+        hot.result = benchmark(runner, single);
+        results.push_back(hot);
+
+        for (size_t target : working_sets) {
+            auto span = prefix_for(item_bytes, target);
+            WorkingSetResult rotating;
+            rotating.mode = "working_set";
+            rotating.working_set_bytes = span.second;
+            rotating.pool_size = span.first;
+            rotating.result = benchmark(runner, prefix(pool, span.first));
+            results.push_back(rotating);
+        }
+
+        if (options.include_flushed) {
+            TimingOptions flushed_timing = options.timing;
+            flushed_timing.flush_cache = true;
+            flushed_timing.samples = std::min(flushed_timing.samples, options.flushed_samples);
+            flushed_timing.target_rse = 0.0;
+            BenchmarkRunner flushed_runner(flushed_timing);
+
+            WorkingSetResult flushed;
+            flushed.mode = "flushed";
+            flushed.working_set_bytes = item_bytes[0];
+            flushed.result = benchmark(flushed_runner, single);
+            results.push_back(flushed);
+        }
+    }
+}
+
+std::vector<size_t> default_working_sets(const CacheSizes& caches, size_t max_bytes) {
+    std::vector<size_t> sizes;
+    for (size_t size : {caches.l1d / 2, caches.l2 / 2, caches.llc / 2, caches.llc * 4}) {
+        size = std::min(size, max_bytes);
+        if (sizes.empty() || size > sizes.back()) {
+            sizes.push_back(size);
+        }
+    }
+    return sizes;
+}
+
+std::vector<WorkingSetResult> run_working_set_benchmark(
+    const std::vector<SerializerInterface*>& serializers,
+    const WorkingSetOptions& options) {
+
+    std::vector<size_t> working_sets = options.working_set_bytes;
+    if (working_sets.empty()) {
+        working_sets = default_working_sets(detect_cache_sizes(), options.max_working_set_bytes);
+    }
+    size_t largest = *std::max_element(working_sets.begin(), working_sets.end());
+
+    TestDataGenerator generator(options.seed);
+    generator.set_reference_time(WORKING_SET_REFERENCE_TIME);
+
+    // Enough distinct records for the largest working set, with 10% to spare
+    // since encodings may be smaller than the logical size
+    std::vector<FileMetadata> sample = generator.generate_metadata_batch(256);
+    size_t average_metadata = std::max<size_t>(1, logical_size(sample) / sample.size());
+    size_t metadata_count = std::min(options.max_pool_records, largest / average_metadata * 11 / 10 + 1);
+    std::vector<FileMetadata> metadata_pool = generator.generate_metadata_batch_parallel(metadata_count);
+
+    size_t block_bytes = std::max<size_t>(1, options.block_size);
+    size_t block_count = std::min(options.max_pool_records, largest / block_bytes * 11 / 10 + 1);
+    std::vector<FileBlock> block_pool =
+        generator.generate_block_batch_parallel(std::vector<size_t>(block_count, options.block_size));
+
+    std::vector<size_t> metadata_bytes;
+    for (const auto& metadata : metadata_pool) {
+        metadata_bytes.push_back(logical_size(metadata));
+    }
+    std::vector<size_t> block_logical_bytes;
+    for (const auto& block : block_pool) {
+        block_logical_bytes.push_back(logical_size(block));
+    }
+
+    std::vector<WorkingSetResult> results;
+    for (SerializerInterface* serializer : serializers) {
+        measure_modes<FileMetadata>(metadata_pool, metadata_bytes, working_sets, options,
+            [serializer](BenchmarkRunner& runner, const std::vector<FileMetadata>& pool) {
+                return runner.benchmark_metadata_serialization_rotating(*serializer, pool);
+            }, results);
+
+        // Encoded pools exist for one format at a time
+        {
+            std::vector<std::vector<uint8_t>> encoded;
+            std::vector<size_t> encoded_bytes;
+            size_t total = 0;
+            for (size_t i = 0; i < metadata_pool.size() && (i == 0 || total < largest); ++i) {
+                encoded.push_back(serializer->serialize_metadata(metadata_pool[i]));
+                encoded_bytes.push_back(encoded.back().size());
+                total += encoded.back().size();
+            }
+            measure_modes<std::vector<uint8_t>>(encoded, encoded_bytes, working_sets, options,
+                [serializer](BenchmarkRunner& runner, const std::vector<std::vector<uint8_t>>& pool) {
+                    return runner.benchmark_metadata_deserialization_rotating(*serializer, pool);
+                }, results);
+        }
+
+        measure_modes<FileBlock>(block_pool, block_logical_bytes, working_sets, options,
+            [serializer](BenchmarkRunner& runner, const std::vector<FileBlock>& pool) {
+                return runner.benchmark_block_serialization_rotating(*serializer, pool);
+            }, results);
+
+        {
+            std::vector<std::vector<uint8_t>> encoded;
+            std::vector<size_t> encoded_bytes;
+            size_t total = 0;
+            for (size_t i = 0; i < block_pool.size() && (i == 0 || total < largest); ++i) {
+                encoded.push_back(serializer->serialize_block(block_pool[i]));
+                encoded_bytes.push_back(encoded.back().size());
+                total += encoded.back().size();
+            }
+            measure_modes<std::vector<uint8_t>>(encoded, encoded_bytes, working_sets, options,
+                [serializer](BenchmarkRunner& runner, const std::vector<std::vector<uint8_t>>& pool) {
+                    return runner.benchmark_block_deserialization_rotating(*serializer, pool);
+                }, results);
+        }
+    }
+
+    // Each operation's results start with its hot run
+    double hot_ms = 0.0;
+    for (auto& result : results) {
+        if (result.mode == "hot") {
+            hot_ms = result.result.duration_ms;
+        }
+        result.slowdown = hot_ms > 0.0 ? result.result.duration_ms / hot_ms : 0.0;
+    }
+    return results;
+}
+
+void print_working_set_results(const std::vector<WorkingSetResult>& results) {
+    std::cout << std::left
+              << std::setw(18) << "Format"
+              << std::setw(26) << "Operation"
+              << std::setw(13) << "Mode"
+              << std::setw(14) << "Working set"
+              << std::setw(10) << "Records"
+              << std::setw(14) << "Per op (us)"
+              << std::setw(12) << "p99 (us)"
+              << std::setw(10) << "vs hot"
+              << std::endl;
+    std::cout << std::string(117, '-') << std::endl;
+
+    for (const auto& entry : results) {
+        std::ostringstream working_set;
+        if (entry.working_set_bytes >= (size_t(1) << 20)) {
+            working_set << entry.working_set_bytes / (size_t(1) << 20) << " MiB";
+        } else if (entry.working_set_bytes >= 1024) {
+            working_set << entry.working_set_bytes / 1024 << " KiB";
+        } else {
+            working_set << entry.working_set_bytes << " B";
+        }
+        std::cout << std::left << std::fixed
+                  << std::setw(18) << entry.result.format_name
+                  << std::setw(26) << entry.result.operation_name
+                  << std::setw(13) << entry.mode
+                  << std::setw(14) << working_set.str()
+                  << std::setw(10) << entry.pool_size
+                  << std::setprecision(3)
+                  << std::setw(14) << entry.result.duration_ms * 1e3
+                  << std::setw(12) << entry.result.latency.p99_ms * 1e3
+                  << std::setprecision(2) << std::setw(10) << entry.slowdown
+                  << std::endl;
+    }
+}
+
+void export_working_set_csv(const std::vector<WorkingSetResult>& results, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
+        return;
+    }
+    export_working_set_csv(results, file);
+}
+
+void export_working_set_csv(const std::vector<WorkingSetResult>& results, std::ostream& out) {
+    out << "Format,Operation,Mode,WorkingSetBytes,PoolSize,DataSizeBytes,SerializedSizeBytes,"
+        << "DurationMs,P50Ms,P99Ms,CiLowMs,CiHighMs,Slowdown" << std::endl;
+    for (const auto& entry : results) {
+        const BenchmarkResult& result = entry.result;
+        out << result.format_name << ","
+            << result.operation_name << ","
+            << entry.mode << ","
+            << entry.working_set_bytes << ","
+            << entry.pool_size << ","
+            << result.data_size_bytes << ","
+            << result.serialized_size_bytes << ","
+            << std::fixed << std::setprecision(6) << result.duration_ms << ","
+            << result.latency.p50_ms << ","
+            << result.latency.p99_ms << ","
+            << result.latency.ci_low_ms << ","
+            << result.latency.ci_high_ms << ","
+            << entry.slowdown
+            << std::endl;
+    }
+}
+
+void export_working_set_json(const std::vector<WorkingSetResult>& results, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
+        return;
+    }
+    export_working_set_json(results, file);
+}
+
+void export_working_set_json(const std::vector<WorkingSetResult>& results, std::ostream& out) {
+    out << "[" << std::endl;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const WorkingSetResult& entry = results[i];
+        const BenchmarkResult& result = entry.result;
+        out << std::fixed << std::setprecision(6)
+            << "  {\"format\": \"" << json_escape(result.format_name) << "\""
+            << ", \"operation\": \"" << json_escape(result.operation_name) << "\""
+            << ", \"mode\": \"" << json_escape(entry.mode) << "\""
+            << ", \"working_set_bytes\": " << entry.working_set_bytes
+            << ", \"pool_size\": " << entry.pool_size
+            << ", \"data_size_bytes\": " << result.data_size_bytes
+            << ", \"serialized_size_bytes\": " << result.serialized_size_bytes
+            << ", \"duration_ms\": " << result.duration_ms
+            << ", \"p50_ms\": " << result.latency.p50_ms
+            << ", \"p99_ms\": " << result.latency.p99_ms
+            << ", \"ci_low_ms\": " << result.latency.ci_low_ms
+            << ", \"ci_high_ms\": " << result.latency.ci_high_ms
+            << ", \"slowdown\": " << entry.slowdown
+            << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    out << "]" << std::endl;
+}
+
+} // namespace benchmark
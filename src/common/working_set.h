@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "common/benchmark_runner.h"
+#include "common/cache_info.h"
+#include "common/serializer_interface.h"
+
+namespace benchmark {
+
+/**
+ * Hot versus cold cost of each format. "hot" repeats one record, as every
+ * other benchmark does; "working_set" rotates through enough distinct
+ * records to fill the given number of input bytes; "flushed" repeats one
+ * record but evicts every cache level before each call.
+ */
+struct WorkingSetOptions {
+    // Input bytes to rotate through. Empty means half of L1d, half of L2,
+    // half of the LLC and 4x the LLC, each capped at max_working_set_bytes.
+    std::vector<size_t> working_set_bytes;
+    size_t max_working_set_bytes = size_t(256) << 20;
+    // Pools are generated for the largest working set by logical size, up to
+    // this many records; a format whose encodings are much smaller than that
+    // reaches less, and WorkingSetResult reports what it reached
+    size_t max_pool_records = size_t(1) << 20;
+
+    size_t block_size = 4096;
+    bool include_flushed = true;
+    size_t flushed_samples = 20;   // Each flushed call first walks twice the LLC
+
+    TimingOptions timing;
+    unsigned seed = 42;
+};
+
+// The default working sets for these cache sizes
+std::vector<size_t> default_working_sets(const CacheSizes& caches, size_t max_bytes);
+
+struct WorkingSetResult {
+    std::string mode;               // "hot", "working_set" or "flushed"
+    size_t working_set_bytes = 0;   // Input bytes one pass over the pool reads
+    size_t pool_size = 1;
+    BenchmarkResult result;
+    double slowdown = 1.0;          // duration_ms over the hot result for this format and operation
+};
+
+// Metadata and block serialization and deserialization of every format in
+// every mode. Deserialization pools are sized by encoded bytes, so each
+// format rotates through the same number of bytes rather than records.
+std::vector<WorkingSetResult> run_working_set_benchmark(
+    const std::vector<SerializerInterface*>& serializers,
+    const WorkingSetOptions& options = WorkingSetOptions());
+
+void print_working_set_results(const std::vector<WorkingSetResult>& results);
+
+void export_working_set_csv(const std::vector<WorkingSetResult>& results, const std::string& filename);
+void export_working_set_csv(const std::vector<WorkingSetResult>& results, std::ostream& out);
+
+// The same rows as an array of JSON objects
+void export_working_set_json(const std::vector<WorkingSetResult>& results, const std::string& filename);
+void export_working_set_json(const std::vector<WorkingSetResult>& results, std::ostream& out);
+
+} // namespace benchmark
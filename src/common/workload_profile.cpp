@@ -0,0 +1,155 @@
+#include "common/workload_profile.h"
+#include <cmath>
+
+namespace benchmark {
+
+namespace {
+    WorkloadProfile uniform_profile() {
+        WorkloadProfile profile;
+        profile.name = "uniform";
+        profile.synthetic = true;
+        return profile;
+    }
+
+    // Home directories: deep trees, mixed documents, source and downloads
+    WorkloadProfile home_profile() {
+        WorkloadProfile profile;
+        profile.name = "home";
+        profile.min_depth = 3;
+        profile.max_depth = 9;
+        profile.directory_fanout = 48;
+        profile.directory_skew = 1.1;
+        profile.min_name_length = 4;
+        profile.max_name_length = 40;
+        profile.utf8_name_fraction = 0.15;
+        profile.size_log_mean = std::log(16.0 * 1024);
+        profile.size_log_sigma = 2.0;
+        profile.size_tail_fraction = 0.02;
+        profile.size_tail_alpha = 1.2;
+        profile.min_size = 0;
+        profile.max_size = 4ULL << 30;
+        profile.min_tags = 0;
+        profile.max_tags = 5;
+        profile.tag_skew = 1.2;
+        profile.owner_skew = 1.5;
+        profile.payload_mix = {0.10, 0.05, 0.45, 0.05, 0.35};
+        return profile;
+    }
+
+    // Log servers: shallow, date-partitioned trees of rotated text logs
+    WorkloadProfile logs_profile() {
+        WorkloadProfile profile;
+        profile.name = "logs";
+        profile.min_depth = 3;
+        profile.max_depth = 6;
+        profile.directory_fanout = 12;
+        profile.directory_skew = 1.3;
+        profile.min_name_length = 16;
+        profile.max_name_length = 48;
+        profile.size_log_mean = std::log(1024.0 * 1024);
+        profile.size_log_sigma = 1.5;
+        profile.size_tail_fraction = 0.01;
+        profile.size_tail_alpha = 1.5;
+        profile.min_size = 0;
+        profile.max_size = 16ULL << 30;
+        profile.min_tags = 1;
+        profile.max_tags = 2;
+        profile.tag_skew = 2.0;
+        profile.owner_skew = 2.5;
+        profile.payload_mix = {0.0, 0.0, 0.0, 0.85, 0.15};
+        return profile;
+    }
+
+    // Photo and video libraries: large, already-compressed files with long names
+    WorkloadProfile media_profile() {
+        WorkloadProfile profile;
+        profile.name = "media";
+        profile.min_depth = 2;
+        profile.max_depth = 6;
+        profile.directory_fanout = 32;
+        profile.directory_skew = 0.9;
+        profile.min_name_length = 8;
+        profile.max_name_length = 64;
+        profile.utf8_name_fraction = 0.30;
+        profile.size_log_mean = std::log(4.0 * 1024 * 1024);
+        profile.size_log_sigma = 1.5;
+        profile.size_tail_fraction = 0.05;
+        profile.size_tail_alpha = 1.1;
+        profile.min_size = 1024;
+        profile.max_size = 64ULL << 30;
+        profile.min_tags = 1;
+        profile.max_tags = 4;
+        profile.tag_skew = 1.0;
+        profile.owner_skew = 1.2;
+        profile.payload_mix = {0.10, 0.0, 0.0, 0.0, 0.90};
+        return profile;
+    }
+
+    // A shared production filesystem: every shape at once, dominated by small files
+    WorkloadProfile production_profile() {
+        WorkloadProfile profile;
+        profile.name = "production";
+        profile.min_depth = 2;
+        profile.max_depth = 12;
+        profile.directory_fanout = 64;
+        profile.directory_skew = 1.2;
+        profile.min_name_length = 3;
+        profile.max_name_length = 80;
+        profile.utf8_name_fraction = 0.10;
+        profile.size_log_mean = std::log(32.0 * 1024);
+        profile.size_log_sigma = 2.5;
+        profile.size_tail_fraction = 0.01;
+        profile.size_tail_alpha = 1.1;
+        profile.min_size = 0;
+        profile.max_size = 64ULL << 30;
+        profile.min_tags = 0;
+        profile.max_tags = 6;
+        profile.tag_skew = 1.3;
+        profile.owner_skew = 1.8;
+        profile.payload_mix = {0.10, 0.10, 0.30, 0.20, 0.30};
+        return profile;
+    }
+}
+
+const char* payload_class_name(PayloadClass payload_class) {
+    switch (payload_class) {
+        case PayloadClass::Random:
+            return "random";
+        case PayloadClass::Zeros:
+            return "zeros";
+        case PayloadClass::Text:
+            return "text";
+        case PayloadClass::Logs:
+            return "logs";
+        case PayloadClass::Compressed:
+            return "compressed";
+    }
+    return "unknown";
+}
+
+std::vector<std::string> workload_profile_names() {
+    return {"uniform", "home", "logs", "media", "production"};
+}
+
+bool find_workload_profile(const std::string& name, WorkloadProfile& profile) {
+    if (name == "uniform") {
+        profile = uniform_profile();
+    } else if (name == "home") {
+        profile = home_profile();
+    } else if (name == "logs") {
+        profile = logs_profile();
+    } else if (name == "media") {
+        profile = media_profile();
+    } else if (name == "production") {
+        profile = production_profile();
+    } else {
+        return false;
+    }
+    return true;
+}
+
+WorkloadProfile default_workload_profile() {
+    return uniform_profile();
+}
+
+} // namespace benchmark
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+/**
+ * Entropy classes for generated block payloads
+ */
+enum class PayloadClass : uint8_t {
+    Random,      // Uniform random bytes
+    Zeros,       // All zero, e.g. sparse or preallocated files
+    Text,        // Words, spaces and line breaks with skewed word frequencies
+    Logs,        // Timestamped log lines with a few varying fields
+    Compressed   // High-entropy frames behind a zstd frame header
+};
+
+const size_t PAYLOAD_CLASS_COUNT = 5;
+
+const char* payload_class_name(PayloadClass payload_class);
+
+/**
+ * Shape of the data a TestDataGenerator produces. Each skew field is a Zipf
+ * exponent over the candidate ranks (0 means uniform).
+ */
+struct WorkloadProfile {
+    std::string name;
+
+    // The original generator: 8-character names under /data/<5 chars>/, sizes
+    // uniform in 100 B..10 MiB, uniform tags and owners, random payloads.
+    // All other fields are ignored when set.
+    bool synthetic = false;
+
+    // Directory tree: depth in [min_depth, max_depth]; each level picks one of
+    // directory_fanout names with directory_skew popularity
+    size_t min_depth = 1;
+    size_t max_depth = 1;
+    size_t directory_fanout = 1;
+    double directory_skew = 0.0;
+
+    // File names: stem length in characters; utf8_name_fraction of names mix in
+    // multi-byte characters
+    size_t min_name_length = 8;
+    size_t max_name_length = 8;
+    double utf8_name_fraction = 0.0;
+
+    // File sizes: log-normal body (parameters of the underlying normal, in
+    // ln bytes) with a Pareto tail for tail_fraction of files; clamped to range
+    double size_log_mean = 0.0;
+    double size_log_sigma = 0.0;
+    double size_tail_fraction = 0.0;
+    double size_tail_alpha = 1.0;
+    uint64_t min_size = 0;
+    uint64_t max_size = 0;
+
+    // Tag count range and popularity of tags, owners and groups
+    size_t min_tags = 3;
+    size_t max_tags = 3;
+    double tag_skew = 0.0;
+    double owner_skew = 0.0;
+
+    // Relative weight of each payload class, indexed by PayloadClass
+    std::array<double, PAYLOAD_CLASS_COUNT> payload_mix = {1.0, 0.0, 0.0, 0.0, 0.0};
+};
+
+// Built-in profiles: "uniform" (the default), "home", "logs", "media", "production"
+std::vector<std::string> workload_profile_names();
+
+// Look up a built-in profile by name; false if there is none
+bool find_workload_profile(const std::string& name, WorkloadProfile& profile);
+
+// The "uniform" profile
+WorkloadProfile default_workload_profile();
+
+} // namespace benchmark
@@ -0,0 +1,464 @@
+#include "formats/columnar/columnar_serializer.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include "common/binary_encoding.h"
+#include "common/serializer_registry.h"
+
+namespace benchmark {
+
+namespace {
+    const uint32_t BATCH_MAGIC = 0x314C4F43; // "COL1"
+    const uint32_t BLOCK_MAGIC = 0x32424F43; // "COB2": 64-bit checksum + algorithm
+    const uint8_t FLAG_PERMUTED = 0x01;
+
+    // Interns owner, group and tag strings; ids are assigned in first-seen order.
+    // Open addressing keeps lookups to one hash and usually one probe, which
+    // matters because every record does several of them.
+    class StringDictionary {
+    public:
+        StringDictionary() : slots_(64, EMPTY), mask_(63) {}
+
+        uint64_t id(const std::string& value) {
+            uint64_t hash = hash_bytes(value);
+            size_t slot = hash & mask_;
+            while (slots_[slot] != EMPTY) {
+                uint32_t candidate = slots_[slot];
+                if (hashes_[candidate] == hash && values_[candidate] == value) {
+                    return candidate;
+                }
+                slot = (slot + 1) & mask_;
+            }
+
+            uint32_t next = static_cast<uint32_t>(values_.size());
+            slots_[slot] = next;
+            values_.push_back(value);
+            hashes_.push_back(hash);
+            if (values_.size() * 2 > slots_.size()) {
+                grow();
+            }
+            return next;
+        }
+
+        const std::vector<std::string_view>& values() const { return values_; }
+
+    private:
+        static constexpr uint32_t EMPTY = UINT32_MAX;
+
+        // Views point into the batch being encoded, which outlives the dictionary
+        std::vector<std::string_view> values_;
+        std::vector<uint64_t> hashes_;
+        std::vector<uint32_t> slots_;
+        size_t mask_;
+
+        static uint64_t hash_bytes(const std::string& value) {
+            // FNV-1a: owner/group/tag strings are short
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (unsigned char c : value) {
+                hash = (hash ^ c) * 0x100000001b3ULL;
+            }
+            return hash ^ (hash >> 29);
+        }
+
+        void grow() {
+            slots_.assign(slots_.size() * 2, EMPTY);
+            mask_ = slots_.size() - 1;
+            for (uint32_t i = 0; i < values_.size(); ++i) {
+                size_t slot = hashes_[i] & mask_;
+                while (slots_[slot] != EMPTY) {
+                    slot = (slot + 1) & mask_;
+                }
+                slots_[slot] = i;
+            }
+        }
+    };
+
+    class PermissionDictionary {
+    public:
+        uint64_t id(uint32_t value) {
+            auto it = ids_.find(value);
+            if (it != ids_.end()) {
+                return it->second;
+            }
+            uint64_t next = values_.size();
+            ids_.emplace(value, next);
+            values_.push_back(value);
+            return next;
+        }
+
+        const std::vector<uint32_t>& values() const { return values_; }
+
+    private:
+        std::unordered_map<uint32_t, uint64_t> ids_;
+        std::vector<uint32_t> values_;
+    };
+
+    bool name_is_basename(const FileMetadata& metadata) {
+        const std::string& name = metadata.name;
+        const std::string& path = metadata.path;
+        return name.find('/') == std::string::npos &&
+               path.size() > name.size() &&
+               path[path.size() - name.size() - 1] == '/' &&
+               path.compare(path.size() - name.size(), name.size(), name) == 0;
+    }
+
+    size_t common_prefix(const std::string& a, const std::string& b) {
+        size_t limit = std::min(a.size(), b.size());
+        size_t i = 0;
+        while (i < limit && a[i] == b[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    uint64_t timestamp_delta(time_t current, time_t previous) {
+        return zigzag_encode(static_cast<int64_t>(
+            static_cast<uint64_t>(current) - static_cast<uint64_t>(previous)));
+    }
+
+    time_t apply_delta(time_t previous, uint64_t encoded) {
+        return static_cast<time_t>(
+            static_cast<uint64_t>(previous) + static_cast<uint64_t>(zigzag_decode(encoded)));
+    }
+
+    void append_string(std::vector<uint8_t>& out, std::string_view value) {
+        append_varint(out, value.size());
+        append_bytes(out, value.data(), value.size());
+    }
+
+    void append_column(std::vector<uint8_t>& out, const std::vector<uint8_t>& column) {
+        append_varint(out, column.size());
+        append_bytes(out, column.data(), column.size());
+    }
+
+    ByteReader read_column(ByteReader& reader) {
+        size_t size = reader.read_varint();
+        return ByteReader(reader.read_bytes(size), size);
+    }
+
+    uint64_t read_id(ByteReader& column, size_t dictionary_size) {
+        uint64_t id = column.read_varint();
+        if (id >= dictionary_size) {
+            throw std::runtime_error("Columnar dictionary id out of range");
+        }
+        return id;
+    }
+
+    std::vector<uint8_t> encode_batch(const FileMetadata* records, size_t count) {
+        // Sort order for front coding; most listings arrive sorted already
+        std::vector<size_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        auto by_path = [records](size_t a, size_t b) { return records[a].path < records[b].path; };
+        bool permuted = !std::is_sorted(order.begin(), order.end(), by_path);
+        if (permuted) {
+            std::stable_sort(order.begin(), order.end(), by_path);
+        }
+
+        std::vector<uint8_t> permutation, paths, names, sizes, created, modified;
+        std::vector<uint8_t> permissions, owners, groups, tag_counts, tag_ids;
+
+        if (permuted) {
+            std::vector<uint64_t> rank(count);
+            for (size_t r = 0; r < count; ++r) {
+                rank[order[r]] = r;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                append_varint(permutation, rank[i]);
+            }
+        }
+
+        const std::string* previous_path = nullptr;
+        for (size_t r = 0; r < count; ++r) {
+            const std::string& path = records[order[r]].path;
+            size_t shared = previous_path ? common_prefix(*previous_path, path) : 0;
+            append_varint(paths, shared);
+            append_string(paths, std::string_view(path).substr(shared));
+            previous_path = &path;
+        }
+
+        StringDictionary strings;
+        PermissionDictionary modes;
+        time_t previous_created = 0;
+        time_t previous_modified = 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            const FileMetadata& metadata = records[i];
+
+            if (name_is_basename(metadata)) {
+                append_varint(names, 0);
+            } else {
+                append_varint(names, metadata.name.size() + 1);
+                append_bytes(names, metadata.name.data(), metadata.name.size());
+            }
+
+            append_varint(sizes, metadata.size);
+            append_varint(created, timestamp_delta(metadata.created_at, previous_created));
+            append_varint(modified, timestamp_delta(metadata.last_modified, previous_modified));
+            previous_created = metadata.created_at;
+            previous_modified = metadata.last_modified;
+
+            append_varint(permissions, modes.id(metadata.permissions));
+            append_varint(owners, strings.id(metadata.owner));
+            append_varint(groups, strings.id(metadata.group));
+
+            append_varint(tag_counts, metadata.tags.size());
+            for (const auto& tag : metadata.tags) {
+                append_varint(tag_ids, strings.id(tag));
+            }
+        }
+
+        std::vector<uint8_t> out;
+        out.reserve(64 + paths.size() + names.size() + sizes.size() + created.size() +
+                    modified.size() + permissions.size() + owners.size() + groups.size() +
+                    tag_counts.size() + tag_ids.size() + permutation.size());
+
+        append_le<uint32_t>(out, BATCH_MAGIC);
+        append_varint(out, count);
+        out.push_back(permuted ? FLAG_PERMUTED : 0);
+
+        append_varint(out, strings.values().size());
+        for (std::string_view value : strings.values()) {
+            append_string(out, value);
+        }
+        append_varint(out, modes.values().size());
+        for (uint32_t mode : modes.values()) {
+            append_varint(out, mode);
+        }
+
+        if (permuted) {
+            append_column(out, permutation);
+        }
+        append_column(out, paths);
+        append_column(out, names);
+        append_column(out, sizes);
+        append_column(out, created);
+        append_column(out, modified);
+        append_column(out, permissions);
+        append_column(out, owners);
+        append_column(out, groups);
+        append_column(out, tag_counts);
+        append_column(out, tag_ids);
+
+        return out;
+    }
+}
+
+std::vector<uint8_t> ColumnarSerializer::serialize_metadata(const FileMetadata& metadata) {
+    return encode_batch(&metadata, 1);
+}
+
+FileMetadata ColumnarSerializer::deserialize_metadata(const std::vector<uint8_t>& data) {
+    std::vector<FileMetadata> batch = deserialize_metadata_batch(data);
+    if (batch.size() != 1) {
+        throw std::runtime_error("Columnar data does not hold a single record");
+    }
+    return std::move(batch.front());
+}
+
+std::vector<uint8_t> ColumnarSerializer::serialize_metadata_batch(const std::vector<FileMetadata>& batch) {
+    return encode_batch(batch.data(), batch.size());
+}
+
+std::vector<FileMetadata> ColumnarSerializer::deserialize_metadata_batch(const std::vector<uint8_t>& data) {
+    ByteReader reader(data);
+    if (reader.read_le<uint32_t>() != BATCH_MAGIC) {
+        throw std::runtime_error("Columnar batch has wrong magic");
+    }
+
+    uint64_t count = reader.read_varint();
+    if (count > reader.remaining()) {
+        throw std::runtime_error("Columnar record count exceeds serialized data");
+    }
+    bool permuted = (reader.read_le<uint8_t>() & FLAG_PERMUTED) != 0;
+
+    // Shared dictionaries
+    uint64_t string_count = reader.read_varint();
+    if (string_count > reader.remaining()) {
+        throw std::runtime_error("Columnar dictionary size exceeds serialized data");
+    }
+    std::vector<std::string> strings;
+    strings.reserve(string_count);
+    for (uint64_t i = 0; i < string_count; ++i) {
+        strings.push_back(reader.read_string(reader.read_varint()));
+    }
+
+    uint64_t mode_count = reader.read_varint();
+    if (mode_count > reader.remaining()) {
+        throw std::runtime_error("Columnar dictionary size exceeds serialized data");
+    }
+    std::vector<uint32_t> modes;
+    modes.reserve(mode_count);
+    for (uint64_t i = 0; i < mode_count; ++i) {
+        modes.push_back(static_cast<uint32_t>(reader.read_varint()));
+    }
+
+    std::vector<FileMetadata> batch(count);
+
+    std::vector<uint64_t> rank;
+    if (permuted) {
+        ByteReader column = read_column(reader);
+        rank.resize(count);
+        std::vector<bool> seen(count, false);
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t r = column.read_varint();
+            if (r >= count || seen[r]) {
+                throw std::runtime_error("Columnar permutation is invalid");
+            }
+            seen[r] = true;
+            rank[i] = r;
+        }
+    }
+
+    // Paths are front-coded in sorted order
+    {
+        ByteReader column = read_column(reader);
+        std::vector<std::string> sorted_paths(permuted ? count : 0);
+        const std::string* previous = nullptr;
+
+        for (uint64_t r = 0; r < count; ++r) {
+            size_t shared = column.read_varint();
+            if (shared > (previous ? previous->size() : 0)) {
+                throw std::runtime_error("Columnar path prefix out of range");
+            }
+            size_t suffix_size = column.read_varint();
+            const uint8_t* suffix = column.read_bytes(suffix_size);
+
+            std::string& path = permuted ? sorted_paths[r] : batch[r].path;
+            path.reserve(shared + suffix_size);
+            if (previous) {
+                path.assign(*previous, 0, shared);
+            }
+            path.append(reinterpret_cast<const char*>(suffix), suffix_size);
+            previous = &path;
+        }
+
+        if (permuted) {
+            for (uint64_t i = 0; i < count; ++i) {
+                batch[i].path = std::move(sorted_paths[rank[i]]);
+            }
+        }
+    }
+
+    ByteReader names = read_column(reader);
+    for (auto& metadata : batch) {
+        uint64_t encoded = names.read_varint();
+        if (encoded == 0) {
+            size_t slash = metadata.path.rfind('/');
+            if (slash == std::string::npos) {
+                throw std::runtime_error("Columnar basename reference without a path");
+            }
+            metadata.name.assign(metadata.path, slash + 1, std::string::npos);
+        } else {
+            metadata.name = names.read_string(encoded - 1);
+        }
+    }
+
+    ByteReader sizes = read_column(reader);
+    for (auto& metadata : batch) {
+        metadata.size = sizes.read_varint();
+    }
+
+    ByteReader created = read_column(reader);
+    time_t previous_created = 0;
+    for (auto& metadata : batch) {
+        metadata.created_at = previous_created = apply_delta(previous_created, created.read_varint());
+    }
+
+    ByteReader modified = read_column(reader);
+    time_t previous_modified = 0;
+    for (auto& metadata : batch) {
+        metadata.last_modified = previous_modified = apply_delta(previous_modified, modified.read_varint());
+    }
+
+    ByteReader permissions = read_column(reader);
+    for (auto& metadata : batch) {
+        metadata.permissions = modes[read_id(permissions, modes.size())];
+    }
+
+    ByteReader owners = read_column(reader);
+    for (auto& metadata : batch) {
+        metadata.owner = strings[read_id(owners, strings.size())];
+    }
+
+    ByteReader groups = read_column(reader);
+    for (auto& metadata : batch) {
+        metadata.group = strings[read_id(groups, strings.size())];
+    }
+
+    ByteReader tag_counts = read_column(reader);
+    ByteReader tag_ids = read_column(reader);
+    for (auto& metadata : batch) {
+        uint64_t tag_count = tag_counts.read_varint();
+        if (tag_count > tag_ids.remaining()) {
+            throw std::runtime_error("Columnar tag count exceeds serialized data");
+        }
+        metadata.tags.reserve(tag_count);
+        for (uint64_t i = 0; i < tag_count; ++i) {
+            metadata.tags.push_back(strings[read_id(tag_ids, strings.size())]);
+        }
+    }
+
+    return batch;
+}
+
+std::vector<uint8_t> ColumnarSerializer::serialize_block(const FileBlock& block) {
+    std::vector<uint8_t> out;
+    out.reserve(32 + block.block_id.size() + block.data.size());
+
+    append_le<uint32_t>(out, BLOCK_MAGIC);
+    append_string(out, block.block_id);
+    append_varint(out, block.offset);
+    append_varint(out, block.data.size());
+    append_bytes(out, block.data.data(), block.data.size());
+    out.push_back(static_cast<uint8_t>(block.checksum_algorithm));
+    append_le<uint64_t>(out, block.checksum);
+
+    return out;
+}
+
+FileBlock ColumnarSerializer::deserialize_block(const std::vector<uint8_t>& data) {
+    return read_block(data, false);
+}
+
+FileBlock ColumnarSerializer::deserialize_block_verified(const std::vector<uint8_t>& data) {
+    return read_block(data, true);
+}
+
+FileBlock ColumnarSerializer::read_block(const std::vector<uint8_t>& data, bool verify) {
+    ByteReader reader(data);
+    if (reader.read_le<uint32_t>() != BLOCK_MAGIC) {
+        throw std::runtime_error("Columnar block has wrong magic");
+    }
+
+    FileBlock block;
+    block.block_id = reader.read_string(reader.read_varint());
+    block.offset = reader.read_varint();
+
+    size_t data_size = reader.read_varint();
+    const uint8_t* payload = reader.read_bytes(data_size);
+
+    block.checksum_algorithm = checksum_algorithm_from_value(reader.read_le<uint8_t>());
+    block.checksum = reader.read_le<uint64_t>();
+
+    if (verify) {
+        assign_verified_payload(block, payload, data_size);
+    } else {
+        block.data.assign(payload, payload + data_size);
+    }
+
+    return block;
+}
+
+namespace {
+    const SerializerRegistrar columnar_registration(
+        "columnar", "Columnar",
+        SerializerCapability::BinarySafe |
+        SerializerCapability::Batch |
+        SerializerCapability::SchemaRequired |
+        SerializerCapability::Deterministic,
+        [] { return std::unique_ptr<SerializerInterface>(new ColumnarSerializer()); });
+}
+
+} // namespace benchmark
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "common/serializer_interface.h"
+
+namespace benchmark {
+
+/**
+ * Struct-of-arrays batch encoding for metadata catalogs.
+ *
+ * A batch is written as a header, a shared string dictionary and one
+ * length-prefixed buffer per column:
+ *   names        - 0 when the name is the basename of the path, else length+1 and bytes
+ *   paths        - front-coded in sorted order (shared prefix, suffix); a
+ *                  permutation column maps records back when input was unsorted
+ *   sizes        - varints
+ *   created_at   - zigzag deltas from the previous record
+ *   last_modified- zigzag deltas from the previous record
+ *   permissions  - dictionary ids
+ *   owner, group - ids into the string dictionary
+ *   tags         - per-record count column plus an id column into the dictionary
+ *
+ * Single records are encoded as a batch of one; blocks have no columnar
+ * structure and use a plain length-prefixed layout.
+ */
+class ColumnarSerializer : public SerializerInterface {
+public:
+    std::string format_name() const override {
+        return "Columnar";
+    }
+
+    std::vector<uint8_t> serialize_metadata(const FileMetadata& metadata) override;
+    FileMetadata deserialize_metadata(const std::vector<uint8_t>& data) override;
+
+    std::vector<uint8_t> serialize_block(const FileBlock& block) override;
+    FileBlock deserialize_block(const std::vector<uint8_t>& data) override;
+    FileBlock deserialize_block_verified(const std::vector<uint8_t>& data) override;
+
+    std::vector<uint8_t> serialize_metadata_batch(const std::vector<FileMetadata>& batch) override;
+    std::vector<FileMetadata> deserialize_metadata_batch(const std::vector<uint8_t>& data) override;
+
+private:
+    // Shared by both block decoders; verify checksums the payload while copying it
+    FileBlock read_block(const std::vector<uint8_t>& data, bool verify);
+};
+
+} // namespace benchmark
\ No newline at end of file
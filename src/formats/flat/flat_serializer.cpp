@@ -0,0 +1,326 @@
+#include "formats/flat/flat_serializer.h"
+#include <stdexcept>
+#include "common/binary_encoding.h"
+#include "common/serializer_registry.h"
+
+namespace benchmark {
+
+namespace {
+    const uint32_t METADATA_MAGIC = 0x314D4C46; // "FLM1"
+    const uint32_t BLOCK_MAGIC = 0x31424C46;    // "FLB1"
+    const uint16_t METADATA_VERSION = 1;
+    const uint16_t BLOCK_VERSION = 2;   // v2 widened the checksum and added its algorithm
+
+    // Metadata header
+    const size_t META_PERMISSIONS_OFFSET = 12;
+    const size_t META_SIZE_OFFSET = 16;
+    const size_t META_CREATED_AT_OFFSET = 24;
+    const size_t META_LAST_MODIFIED_OFFSET = 32;
+    const size_t META_TABLE_OFFSET = 40;
+    const uint16_t META_FIELD_COUNT = 5;
+    const size_t META_HEADER_SIZE = META_TABLE_OFFSET + META_FIELD_COUNT * 8;
+
+    enum MetadataField { FIELD_NAME = 0, FIELD_PATH, FIELD_OWNER, FIELD_GROUP, FIELD_TAGS };
+
+    // Block header
+    const size_t BLOCK_ALGORITHM_OFFSET = 12;
+    const size_t BLOCK_CHECKSUM_OFFSET = 16;
+    const size_t BLOCK_OFFSET_OFFSET = 24;
+    const size_t BLOCK_TABLE_OFFSET = 32;
+    const uint16_t BLOCK_FIELD_COUNT = 2;
+    const size_t BLOCK_HEADER_SIZE = BLOCK_TABLE_OFFSET + BLOCK_FIELD_COUNT * 8;
+
+    enum BlockField { FIELD_BLOCK_ID = 0, FIELD_DATA };
+
+    uint32_t checked_u32(size_t value) {
+        if (value > UINT32_MAX) {
+            throw std::length_error("Flat buffer exceeds 4 GiB");
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    // Writes a table entry and the inline bytes it points at; returns the new cursor
+    size_t write_field(uint8_t* buffer, size_t table_entry, size_t cursor,
+                       const void* bytes, size_t length) {
+        store_le<uint32_t>(buffer + table_entry, checked_u32(cursor));
+        store_le<uint32_t>(buffer + table_entry + 4, checked_u32(length));
+        if (length > 0) {
+            std::memcpy(buffer + cursor, bytes, length);
+        }
+        return cursor + length;
+    }
+
+    void write_header(uint8_t* buffer, uint32_t magic, uint16_t version,
+                      uint16_t field_count, size_t total_size) {
+        store_le<uint32_t>(buffer, magic);
+        store_le<uint16_t>(buffer + 4, version);
+        store_le<uint16_t>(buffer + 6, field_count);
+        store_le<uint32_t>(buffer + 8, checked_u32(total_size));
+    }
+
+    // Validates the common header and returns the usable buffer length
+    size_t validate_header(const uint8_t* data, size_t size, uint32_t magic, uint16_t version,
+                           uint16_t field_count, size_t header_size) {
+        if (data == nullptr || size < header_size) {
+            throw std::runtime_error("Flat buffer too small for header");
+        }
+        if (load_le<uint32_t>(data) != magic) {
+            throw std::runtime_error("Flat buffer has wrong magic");
+        }
+        if (load_le<uint16_t>(data + 4) != version) {
+            throw std::runtime_error("Unsupported Flat format version");
+        }
+        if (load_le<uint16_t>(data + 6) != field_count) {
+            throw std::runtime_error("Flat buffer has unexpected field count");
+        }
+        uint32_t total_size = load_le<uint32_t>(data + 8);
+        if (total_size < header_size || total_size > size) {
+            throw std::runtime_error("Flat buffer total size out of range");
+        }
+        return total_size;
+    }
+
+    std::string_view checked_slice(const uint8_t* data, size_t size,
+                                   uint32_t offset, uint32_t length) {
+        if (static_cast<uint64_t>(offset) + length > size) {
+            throw std::out_of_range("Flat field out of bounds");
+        }
+        return std::string_view(reinterpret_cast<const char*>(data) + offset, length);
+    }
+}
+
+std::vector<uint8_t> FlatSerializer::serialize_metadata(const FileMetadata& metadata) {
+    // Size everything up front so the buffer is allocated exactly once
+    size_t tags_size = 4 + metadata.tags.size() * 8;
+    for (const auto& tag : metadata.tags) {
+        tags_size += tag.size();
+    }
+    size_t total_size = META_HEADER_SIZE + metadata.name.size() + metadata.path.size() +
+                        metadata.owner.size() + metadata.group.size() + tags_size;
+
+    std::vector<uint8_t> buffer(total_size);
+    uint8_t* out = buffer.data();
+
+    write_header(out, METADATA_MAGIC, METADATA_VERSION, META_FIELD_COUNT, total_size);
+    store_le<uint32_t>(out + META_PERMISSIONS_OFFSET, metadata.permissions);
+    store_le<uint64_t>(out + META_SIZE_OFFSET, metadata.size);
+    store_le<int64_t>(out + META_CREATED_AT_OFFSET, static_cast<int64_t>(metadata.created_at));
+    store_le<int64_t>(out + META_LAST_MODIFIED_OFFSET, static_cast<int64_t>(metadata.last_modified));
+
+    size_t cursor = META_HEADER_SIZE;
+    cursor = write_field(out, META_TABLE_OFFSET + FIELD_NAME * 8, cursor,
+                         metadata.name.data(), metadata.name.size());
+    cursor = write_field(out, META_TABLE_OFFSET + FIELD_PATH * 8, cursor,
+                         metadata.path.data(), metadata.path.size());
+    cursor = write_field(out, META_TABLE_OFFSET + FIELD_OWNER * 8, cursor,
+                         metadata.owner.data(), metadata.owner.size());
+    cursor = write_field(out, META_TABLE_OFFSET + FIELD_GROUP * 8, cursor,
+                         metadata.group.data(), metadata.group.size());
+
+    // Tags: nested table followed by the tag bytes
+    size_t tags_start = cursor;
+    store_le<uint32_t>(out + META_TABLE_OFFSET + FIELD_TAGS * 8, checked_u32(tags_start));
+    store_le<uint32_t>(out + META_TABLE_OFFSET + FIELD_TAGS * 8 + 4, checked_u32(tags_size));
+    store_le<uint32_t>(out + tags_start, checked_u32(metadata.tags.size()));
+
+    cursor = tags_start + 4 + metadata.tags.size() * 8;
+    for (size_t i = 0; i < metadata.tags.size(); ++i) {
+        const std::string& tag = metadata.tags[i];
+        cursor = write_field(out, tags_start + 4 + i * 8, cursor, tag.data(), tag.size());
+    }
+
+    return buffer;
+}
+
+FileMetadata FlatSerializer::deserialize_metadata(const std::vector<uint8_t>& data) {
+    return FlatMetadataReader(data).to_metadata();
+}
+
+std::vector<uint8_t> FlatSerializer::serialize_block(const FileBlock& block) {
+    size_t total_size = BLOCK_HEADER_SIZE + block.block_id.size() + block.data.size();
+
+    std::vector<uint8_t> buffer(total_size);
+    uint8_t* out = buffer.data();
+
+    write_header(out, BLOCK_MAGIC, BLOCK_VERSION, BLOCK_FIELD_COUNT, total_size);
+    out[BLOCK_ALGORITHM_OFFSET] = static_cast<uint8_t>(block.checksum_algorithm);
+    store_le<uint64_t>(out + BLOCK_CHECKSUM_OFFSET, block.checksum);
+    store_le<uint64_t>(out + BLOCK_OFFSET_OFFSET, block.offset);
+
+    size_t cursor = BLOCK_HEADER_SIZE;
+    cursor = write_field(out, BLOCK_TABLE_OFFSET + FIELD_BLOCK_ID * 8, cursor,
+                         block.block_id.data(), block.block_id.size());
+    write_field(out, BLOCK_TABLE_OFFSET + FIELD_DATA * 8, cursor,
+                block.data.data(), block.data.size());
+
+    return buffer;
+}
+
+FileBlock FlatSerializer::deserialize_block(const std::vector<uint8_t>& data) {
+    return FlatBlockReader(data).to_block();
+}
+
+FileBlock FlatSerializer::deserialize_block_verified(const std::vector<uint8_t>& data) {
+    FlatBlockReader reader(data);
+
+    FileBlock block;
+    block.block_id = std::string(reader.block_id());
+    block.offset = reader.offset();
+    block.checksum = reader.checksum();
+    block.checksum_algorithm = reader.checksum_algorithm();
+    assign_verified_payload(block, reader.data(), reader.data_size());
+
+    return block;
+}
+
+FlatMetadataReader::FlatMetadataReader(const uint8_t* data, size_t size)
+    : data_(data)
+    , size_(validate_header(data, size, METADATA_MAGIC, METADATA_VERSION,
+                            META_FIELD_COUNT, META_HEADER_SIZE)) {
+}
+
+uint64_t FlatMetadataReader::size() const {
+    return load_le<uint64_t>(data_ + META_SIZE_OFFSET);
+}
+
+time_t FlatMetadataReader::created_at() const {
+    return static_cast<time_t>(load_le<int64_t>(data_ + META_CREATED_AT_OFFSET));
+}
+
+time_t FlatMetadataReader::last_modified() const {
+    return static_cast<time_t>(load_le<int64_t>(data_ + META_LAST_MODIFIED_OFFSET));
+}
+
+uint32_t FlatMetadataReader::permissions() const {
+    return load_le<uint32_t>(data_ + META_PERMISSIONS_OFFSET);
+}
+
+std::string_view FlatMetadataReader::name() const {
+    return field(FIELD_NAME);
+}
+
+std::string_view FlatMetadataReader::path() const {
+    return field(FIELD_PATH);
+}
+
+std::string_view FlatMetadataReader::owner() const {
+    return field(FIELD_OWNER);
+}
+
+std::string_view FlatMetadataReader::group() const {
+    return field(FIELD_GROUP);
+}
+
+size_t FlatMetadataReader::tag_count() const {
+    std::string_view tags = field(FIELD_TAGS);
+    if (tags.size() < 4) {
+        throw std::out_of_range("Flat tag table out of bounds");
+    }
+    uint32_t count = load_le<uint32_t>(reinterpret_cast<const uint8_t*>(tags.data()));
+    if ((tags.size() - 4) / 8 < count) {
+        throw std::out_of_range("Flat tag table out of bounds");
+    }
+    return count;
+}
+
+std::string_view FlatMetadataReader::tag(size_t index) const {
+    if (index >= tag_count()) {
+        throw std::out_of_range("Flat tag index out of range");
+    }
+    const uint8_t* entry = reinterpret_cast<const uint8_t*>(field(FIELD_TAGS).data()) + 4 + index * 8;
+    return slice(load_le<uint32_t>(entry), load_le<uint32_t>(entry + 4));
+}
+
+FileMetadata FlatMetadataReader::to_metadata() const {
+    FileMetadata metadata;
+
+    metadata.name = std::string(name());
+    metadata.path = std::string(path());
+    metadata.size = size();
+    metadata.created_at = created_at();
+    metadata.last_modified = last_modified();
+
+    size_t count = tag_count();
+    metadata.tags.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        metadata.tags.emplace_back(tag(i));
+    }
+
+    metadata.permissions = permissions();
+    metadata.owner = std::string(owner());
+    metadata.group = std::string(group());
+
+    return metadata;
+}
+
+std::string_view FlatMetadataReader::field(size_t index) const {
+    const uint8_t* entry = data_ + META_TABLE_OFFSET + index * 8;
+    return slice(load_le<uint32_t>(entry), load_le<uint32_t>(entry + 4));
+}
+
+std::string_view FlatMetadataReader::slice(uint32_t offset, uint32_t length) const {
+    return checked_slice(data_, size_, offset, length);
+}
+
+FlatBlockReader::FlatBlockReader(const uint8_t* data, size_t size)
+    : data_(data)
+    , size_(validate_header(data, size, BLOCK_MAGIC, BLOCK_VERSION,
+                            BLOCK_FIELD_COUNT, BLOCK_HEADER_SIZE)) {
+}
+
+uint64_t FlatBlockReader::offset() const {
+    return load_le<uint64_t>(data_ + BLOCK_OFFSET_OFFSET);
+}
+
+uint64_t FlatBlockReader::checksum() const {
+    return load_le<uint64_t>(data_ + BLOCK_CHECKSUM_OFFSET);
+}
+
+ChecksumAlgorithm FlatBlockReader::checksum_algorithm() const {
+    return checksum_algorithm_from_value(data_[BLOCK_ALGORITHM_OFFSET]);
+}
+
+std::string_view FlatBlockReader::block_id() const {
+    return field(FIELD_BLOCK_ID);
+}
+
+const uint8_t* FlatBlockReader::data() const {
+    return reinterpret_cast<const uint8_t*>(field(FIELD_DATA).data());
+}
+
+size_t FlatBlockReader::data_size() const {
+    return field(FIELD_DATA).size();
+}
+
+FileBlock FlatBlockReader::to_block() const {
+    FileBlock block;
+
+    block.block_id = std::string(block_id());
+    block.offset = offset();
+
+    std::string_view payload = field(FIELD_DATA);
+    block.data.assign(payload.begin(), payload.end());
+
+    block.checksum = checksum();
+    block.checksum_algorithm = checksum_algorithm();
+
+    return block;
+}
+
+std::string_view FlatBlockReader::field(size_t index) const {
+    const uint8_t* entry = data_ + BLOCK_TABLE_OFFSET + index * 8;
+    return checked_slice(data_, size_, load_le<uint32_t>(entry), load_le<uint32_t>(entry + 4));
+}
+
+namespace {
+    const SerializerRegistrar flat_registration(
+        "flat", "Flat",
+        SerializerCapability::BinarySafe |
+        SerializerCapability::ZeroCopyRead |
+        SerializerCapability::Streaming |
+        SerializerCapability::SchemaRequired |
+        SerializerCapability::Deterministic,
+        [] { return std::unique_ptr<SerializerInterface>(new FlatSerializer()); });
+}
+
+} // namespace benchmark
\ No newline at end of file
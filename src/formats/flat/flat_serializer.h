@@ -0,0 +1,104 @@
+#pragma once
+
+#include "common/serializer_interface.h"
+#include <string_view>
+
+namespace benchmark {
+
+/**
+ * In-house zero-copy layout. Scalars live at fixed offsets in the header,
+ * variable-length fields are reached through an offset table, and all
+ * string/bytes data is stored inline in the same buffer.
+ *
+ * Metadata layout (all integers little-endian, offsets from buffer start):
+ *   0  u32 magic        4  u16 version     6  u16 field count
+ *   8  u32 total size  12  u32 permissions
+ *  16  u64 size        24  i64 created_at  32  i64 last_modified
+ *  40  field table: {u32 offset, u32 length} for name, path, owner, group, tags
+ *  80  inline data; the tags entry points to {u32 count, count x {u32 offset, u32 length}}
+ *
+ * Block layout (version 2):
+ *   0  u32 magic        4  u16 version     6  u16 field count
+ *   8  u32 total size  12  u8 checksum algorithm, 3 bytes padding
+ *  16  u64 checksum    24  u64 offset
+ *  32  field table: {u32 offset, u32 length} for block_id, data
+ *  48  inline data
+ */
+class FlatSerializer : public SerializerInterface {
+public:
+    std::string format_name() const override {
+        return "Flat";
+    }
+
+    std::vector<uint8_t> serialize_metadata(const FileMetadata& metadata) override;
+    FileMetadata deserialize_metadata(const std::vector<uint8_t>& data) override;
+
+    std::vector<uint8_t> serialize_block(const FileBlock& block) override;
+    FileBlock deserialize_block(const std::vector<uint8_t>& data) override;
+    FileBlock deserialize_block_verified(const std::vector<uint8_t>& data) override;
+};
+
+/**
+ * Reads metadata fields directly from a Flat buffer.
+ * The constructor validates the header only; every accessor is O(1),
+ * bounds-checked and does not allocate. The buffer must outlive the reader.
+ */
+class FlatMetadataReader {
+public:
+    FlatMetadataReader(const uint8_t* data, size_t size);
+    explicit FlatMetadataReader(const std::vector<uint8_t>& data)
+        : FlatMetadataReader(data.data(), data.size()) {}
+
+    uint64_t size() const;
+    time_t created_at() const;
+    time_t last_modified() const;
+    uint32_t permissions() const;
+
+    std::string_view name() const;
+    std::string_view path() const;
+    std::string_view owner() const;
+    std::string_view group() const;
+
+    size_t tag_count() const;
+    std::string_view tag(size_t index) const;
+
+    // Materialize a full FileMetadata (allocates)
+    FileMetadata to_metadata() const;
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+
+    std::string_view field(size_t index) const;
+    std::string_view slice(uint32_t offset, uint32_t length) const;
+};
+
+/**
+ * Reads block fields directly from a Flat buffer without copying the payload.
+ */
+class FlatBlockReader {
+public:
+    FlatBlockReader(const uint8_t* data, size_t size);
+    explicit FlatBlockReader(const std::vector<uint8_t>& data)
+        : FlatBlockReader(data.data(), data.size()) {}
+
+    uint64_t offset() const;
+    uint64_t checksum() const;
+    ChecksumAlgorithm checksum_algorithm() const;
+    std::string_view block_id() const;
+
+    // Pointer into the underlying buffer and payload length
+    const uint8_t* data() const;
+    size_t data_size() const;
+
+    // Materialize a full FileBlock (copies the payload)
+    FileBlock to_block() const;
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+
+    std::string_view field(size_t index) const;
+};
+
+} // namespace benchmark
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "formats/json/json_serializer.h"
 #include <algorithm>
+#include <array>
 #include <stdexcept>
+#include "common/serializer_registry.h"
 #include "common/utilities.h"
 
 namespace benchmark {
@@ -53,45 +55,60 @@ namespace {
         return encoded;
     }
 
-    std::vector<uint8_t> base64_decode(const std::string& encoded) {
-        size_t in_len = encoded.size();
-        int i = 0, j = 0, in_ = 0;
-        unsigned char char_array_4[4], char_array_3[3];
-        std::vector<uint8_t> decoded;
+    // Characters outside the alphabet decode as 0xFF, as they always have
+    std::array<uint8_t, 256> make_base64_lookup() {
+        std::array<uint8_t, 256> lookup;
+        lookup.fill(0xFF);
+        for (size_t i = 0; i < base64_chars.size(); ++i) {
+            lookup[static_cast<unsigned char>(base64_chars[i])] = static_cast<uint8_t>(i);
+        }
+        return lookup;
+    }
 
-        while (in_len-- && encoded[in_] != '=') {
-            char_array_4[i++] = encoded[in_]; in_++;
-            if (i == 4) {
-                for (i = 0; i < 4; i++)
-                    char_array_4[i] = static_cast<unsigned char>(
-                        base64_chars.find(char_array_4[i]));
+    // Decodes up to the first '='. With a state, the output is produced in
+    // strips that are checksummed while still in L1, so verification does
+    // not need a second pass over the decoded payload.
+    std::vector<uint8_t> base64_decode(const std::string& encoded, ChecksumState* state = nullptr) {
+        static const std::array<uint8_t, 256> lookup = make_base64_lookup();
 
-                char_array_3[0] = (char_array_4[0] << 2) + 
-                                  ((char_array_4[1] & 0x30) >> 4);
-                char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + 
-                                  ((char_array_4[2] & 0x3c) >> 2);
-                char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + 
-                                   char_array_4[3];
+        size_t length = std::min(encoded.find('='), encoded.size());
+        const unsigned char* in = reinterpret_cast<const unsigned char*>(encoded.data());
 
-                for (i = 0; i < 3; i++)
-                    decoded.push_back(char_array_3[i]);
-                i = 0;
-            }
-        }
+        std::vector<uint8_t> decoded;
+        decoded.reserve(length / 4 * 3 + 2);
 
-        if (i) {
-            for (j = 0; j < i; j++)
-                char_array_4[j] = static_cast<unsigned char>(
-                    base64_chars.find(char_array_4[j]));
+        uint8_t strip[3 * 2048];
+        size_t filled = 0;
+        auto flush = [&]() {
+            decoded.insert(decoded.end(), strip, strip + filled);
+            if (state != nullptr) {
+                state->update(strip, filled);
+            }
+            filled = 0;
+        };
 
-            char_array_3[0] = (char_array_4[0] << 2) + 
-                              ((char_array_4[1] & 0x30) >> 4);
-            char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + 
-                              ((char_array_4[2] & 0x3c) >> 2);
+        for (size_t quads = length / 4; quads > 0; --quads) {
+            uint8_t c0 = lookup[in[0]], c1 = lookup[in[1]], c2 = lookup[in[2]], c3 = lookup[in[3]];
+            strip[filled++] = static_cast<uint8_t>((c0 << 2) + ((c1 & 0x30) >> 4));
+            strip[filled++] = static_cast<uint8_t>(((c1 & 0xf) << 4) + ((c2 & 0x3c) >> 2));
+            strip[filled++] = static_cast<uint8_t>(((c2 & 0x3) << 6) + c3);
+            in += 4;
+            if (filled == sizeof(strip)) {
+                flush();
+            }
+        }
 
-            for (j = 0; j < i - 1; j++)
-                decoded.push_back(char_array_3[j]);
+        // A trailing group of 2 or 3 characters carries 1 or 2 bytes
+        size_t rest = length % 4;
+        if (rest >= 2) {
+            uint8_t c0 = lookup[in[0]], c1 = lookup[in[1]];
+            strip[filled++] = static_cast<uint8_t>((c0 << 2) + ((c1 & 0x30) >> 4));
+            if (rest == 3) {
+                uint8_t c2 = lookup[in[2]];
+                strip[filled++] = static_cast<uint8_t>(((c1 & 0xf) << 4) + ((c2 & 0x3c) >> 2));
+            }
         }
+        flush();
 
         return decoded;
     }
@@ -137,24 +154,36 @@ std::vector<uint8_t> JsonSerializer::serialize_block(const FileBlock& block) {
     j["offset"] = block.offset;
     j["data"] = base64_encode(block.data);
     j["checksum"] = block.checksum;
+    j["checksum_algorithm"] = static_cast<uint32_t>(block.checksum_algorithm);
     
     std::string json_str = j.dump();
     return std::vector<uint8_t>(json_str.begin(), json_str.end());
 }
 
 FileBlock JsonSerializer::deserialize_block(const std::vector<uint8_t>& data) {
+    return read_block(data, false);
+}
+
+FileBlock JsonSerializer::deserialize_block_verified(const std::vector<uint8_t>& data) {
+    return read_block(data, true);
+}
+
+FileBlock JsonSerializer::read_block(const std::vector<uint8_t>& data, bool verify) {
     std::string json_str(data.begin(), data.end());
     auto j = nlohmann::json::parse(json_str);
     
     FileBlock block;
     block.block_id = j["block_id"].get<std::string>();
     block.offset = j["offset"].get<uint64_t>();
-    block.data = base64_decode(j["data"].get<std::string>());
-    block.checksum = j["checksum"].get<uint32_t>();
+    block.checksum = j["checksum"].get<uint64_t>();
+    // Older documents predate the algorithm field and are always Adler-32
+    block.checksum_algorithm = checksum_algorithm_from_value(
+        j.value("checksum_algorithm", static_cast<uint64_t>(ChecksumAlgorithm::Adler32)));
     
-    // Verify checksum
-    uint32_t calculated = calculate_checksum(block.data);
-    if (calculated != block.checksum) {
+    // Verify checksum while decoding
+    ChecksumState state(block.checksum_algorithm);
+    block.data = base64_decode(j["data"].get_ref<const std::string&>(), verify ? &state : nullptr);
+    if (verify && state.finalize() != block.checksum) {
         throw std::runtime_error("Checksum mismatch after deserialization");
     }
     
@@ -233,6 +262,7 @@ nlohmann::json JsonSerializer::block_to_json(const FileBlock& block) {
     
     j["data"] = base64_data;
     j["checksum"] = block.checksum;
+    j["checksum_algorithm"] = static_cast<uint32_t>(block.checksum_algorithm);
     
     return j;
 }
@@ -305,9 +335,19 @@ FileBlock JsonSerializer::json_to_block(const nlohmann::json& j) {
         }
     }
     
-    block.checksum = j["checksum"].get<uint32_t>();
+    block.checksum = j["checksum"].get<uint64_t>();
+    block.checksum_algorithm = checksum_algorithm_from_value(
+        j.value("checksum_algorithm", static_cast<uint64_t>(ChecksumAlgorithm::Adler32)));
     
     return block;
 }
 
+namespace {
+    // Strings must be valid UTF-8 to be dumped; keys are written sorted
+    const SerializerRegistrar json_registration(
+        "json", "JSON",
+        static_cast<SerializerCapabilities>(SerializerCapability::Deterministic),
+        [] { return std::unique_ptr<SerializerInterface>(new JsonSerializer()); });
+}
+
 } // namespace benchmark
\ No newline at end of file
@@ -16,6 +16,7 @@ public:
     
     std::vector<uint8_t> serialize_block(const FileBlock& block) override;
     FileBlock deserialize_block(const std::vector<uint8_t>& data) override;
+    FileBlock deserialize_block_verified(const std::vector<uint8_t>& data) override;
     
 private:
     // Helper methods for conversion between FileMetadata and JSON
@@ -25,6 +26,9 @@ private:
     // Helper methods for conversion between FileBlock and JSON
     nlohmann::json block_to_json(const FileBlock& block);
     FileBlock json_to_block(const nlohmann::json& j);
+    
+    // Shared by both block decoders; verify checksums the payload while decoding it
+    FileBlock read_block(const std::vector<uint8_t>& data, bool verify);
 };
 
 } // namespace benchmark
\ No newline at end of file
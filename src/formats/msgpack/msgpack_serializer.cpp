@@ -1,4 +1,5 @@
 #include "formats/msgpack/msgpack_serializer.h"
+#include "common/serializer_registry.h"
 
 namespace benchmark {
 
@@ -46,4 +47,51 @@ FileBlock MessagePackSerializer::deserialize_block(const std::vector<uint8_t>& d
     return block;
 }
 
+FileBlock MessagePackSerializer::deserialize_block_verified(const std::vector<uint8_t>& data) {
+    msgpack::object_handle oh = msgpack::unpack(reinterpret_cast<const char*>(data.data()), data.size());
+    msgpack::object obj = oh.get();
+    
+    // Same layout as convert<FileBlock>, but the bin payload is copied and
+    // checksummed in one pass instead of going through convert()
+    if (obj.type != msgpack::type::ARRAY) throw msgpack::type_error();
+    if (obj.via.array.size != 4 && obj.via.array.size != 5) throw msgpack::type_error();
+    // Old packers wrote raw bytes as str, which convert() also accepts
+    const msgpack::object& payload = obj.via.array.ptr[2];
+    const char* payload_data;
+    size_t payload_size;
+    if (payload.type == msgpack::type::BIN) {
+        payload_data = payload.via.bin.ptr;
+        payload_size = payload.via.bin.size;
+    } else if (payload.type == msgpack::type::STR) {
+        payload_data = payload.via.str.ptr;
+        payload_size = payload.via.str.size;
+    } else {
+        throw msgpack::type_error();
+    }
+    
+    FileBlock block;
+    obj.via.array.ptr[0].convert(block.block_id);
+    obj.via.array.ptr[1].convert(block.offset);
+    obj.via.array.ptr[3].convert(block.checksum);
+    uint64_t algorithm = static_cast<uint64_t>(ChecksumAlgorithm::Adler32);
+    if (obj.via.array.size == 5) {
+        obj.via.array.ptr[4].convert(algorithm);
+    }
+    block.checksum_algorithm = checksum_algorithm_from_value(algorithm);
+    
+    assign_verified_payload(block, reinterpret_cast<const uint8_t*>(payload_data), payload_size);
+    
+    return block;
+}
+
+namespace {
+    // Records are positional arrays, so field order is the schema
+    const SerializerRegistrar msgpack_registration(
+        "msgpack", "MessagePack",
+        SerializerCapability::BinarySafe |
+        SerializerCapability::SchemaRequired |
+        SerializerCapability::Deterministic,
+        [] { return std::unique_ptr<SerializerInterface>(new MessagePackSerializer()); });
+}
+
 } // namespace benchmark
\ No newline at end of file
@@ -16,6 +16,7 @@ public:
     
     std::vector<uint8_t> serialize_block(const FileBlock& block) override;
     FileBlock deserialize_block(const std::vector<uint8_t>& data) override;
+    FileBlock deserialize_block_verified(const std::vector<uint8_t>& data) override;
 };
 
 } // namespace benchmark
@@ -66,12 +67,18 @@ template<>
 struct convert<benchmark::FileBlock> {
     msgpack::object const& operator()(msgpack::object const& o, benchmark::FileBlock& v) const {
         if (o.type != msgpack::type::ARRAY) throw msgpack::type_error();
-        if (o.via.array.size != 4) throw msgpack::type_error();
+        // 4-element arrays predate the algorithm field and are always Adler-32
+        if (o.via.array.size != 4 && o.via.array.size != 5) throw msgpack::type_error();
 
         o.via.array.ptr[0].convert(v.block_id);
         o.via.array.ptr[1].convert(v.offset);
         o.via.array.ptr[2].convert(v.data);
         o.via.array.ptr[3].convert(v.checksum);
+        uint64_t algorithm = static_cast<uint64_t>(benchmark::ChecksumAlgorithm::Adler32);
+        if (o.via.array.size == 5) {
+            o.via.array.ptr[4].convert(algorithm);
+        }
+        v.checksum_algorithm = benchmark::checksum_algorithm_from_value(algorithm);
         return o;
     }
 };
@@ -80,11 +87,12 @@ template<>
 struct pack<benchmark::FileBlock> {
     template <typename Stream>
     msgpack::packer<Stream>& operator()(msgpack::packer<Stream>& o, const benchmark::FileBlock& v) const {
-        o.pack_array(4);
+        o.pack_array(5);
         o.pack(v.block_id);
         o.pack(v.offset);
         o.pack(v.data);
         o.pack(v.checksum);
+        o.pack(static_cast<uint8_t>(v.checksum_algorithm));
         return o;
     }
 };
@@ -0,0 +1,237 @@
+#include "formats/packed/packed_serializer.h"
+#include <stdexcept>
+#include "common/binary_encoding.h"
+#include "common/serializer_registry.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define PACKED_NATIVE_LITTLE_ENDIAN 1
+#else
+#define PACKED_NATIVE_LITTLE_ENDIAN 0
+#endif
+
+namespace benchmark {
+
+namespace {
+    const uint32_t METADATA_MAGIC = 0x314D4B50; // "PKM1"
+    const uint32_t BLOCK_MAGIC = 0x32424B50;    // "PKB2": 64-bit checksum + algorithm
+
+    uint32_t checked_u32(size_t value) {
+        if (value > UINT32_MAX) {
+            throw std::length_error("Packed field exceeds 4 GiB");
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    void check_magic(uint32_t magic, uint32_t expected) {
+        if (magic == expected) {
+            return;
+        }
+        if (magic == __builtin_bswap32(expected)) {
+            throw std::runtime_error("Packed data was written with a different byte order");
+        }
+        throw std::runtime_error("Packed data has wrong magic");
+    }
+
+    // Fixed-field (de)serialization: one memcpy on little-endian hosts
+    void store_header(uint8_t* out, const PackedMetadataHeader& h) {
+#if PACKED_NATIVE_LITTLE_ENDIAN
+        std::memcpy(out, &h, sizeof(h));
+#else
+        store_le<uint32_t>(out + offsetof(PackedMetadataHeader, magic), h.magic);
+        store_le<uint32_t>(out + offsetof(PackedMetadataHeader, permissions), h.permissions);
+        store_le<uint64_t>(out + offsetof(PackedMetadataHeader, size), h.size);
+        store_le<int64_t>(out + offsetof(PackedMetadataHeader, created_at), h.created_at);
+        store_le<int64_t>(out + offsetof(PackedMetadataHeader, last_modified), h.last_modified);
+        store_le<uint32_t>(out + offsetof(PackedMetadataHeader, name_length), h.name_length);
+        store_le<uint32_t>(out + offsetof(PackedMetadataHeader, path_length), h.path_length);
+        store_le<uint32_t>(out + offsetof(PackedMetadataHeader, owner_length), h.owner_length);
+        store_le<uint32_t>(out + offsetof(PackedMetadataHeader, group_length), h.group_length);
+        store_le<uint32_t>(out + offsetof(PackedMetadataHeader, tag_count), h.tag_count);
+        store_le<uint32_t>(out + offsetof(PackedMetadataHeader, reserved), h.reserved);
+#endif
+    }
+
+    PackedMetadataHeader load_metadata_header(const uint8_t* in) {
+        PackedMetadataHeader h;
+#if PACKED_NATIVE_LITTLE_ENDIAN
+        std::memcpy(&h, in, sizeof(h));
+#else
+        h.magic = load_le<uint32_t>(in + offsetof(PackedMetadataHeader, magic));
+        h.permissions = load_le<uint32_t>(in + offsetof(PackedMetadataHeader, permissions));
+        h.size = load_le<uint64_t>(in + offsetof(PackedMetadataHeader, size));
+        h.created_at = load_le<int64_t>(in + offsetof(PackedMetadataHeader, created_at));
+        h.last_modified = load_le<int64_t>(in + offsetof(PackedMetadataHeader, last_modified));
+        h.name_length = load_le<uint32_t>(in + offsetof(PackedMetadataHeader, name_length));
+        h.path_length = load_le<uint32_t>(in + offsetof(PackedMetadataHeader, path_length));
+        h.owner_length = load_le<uint32_t>(in + offsetof(PackedMetadataHeader, owner_length));
+        h.group_length = load_le<uint32_t>(in + offsetof(PackedMetadataHeader, group_length));
+        h.tag_count = load_le<uint32_t>(in + offsetof(PackedMetadataHeader, tag_count));
+        h.reserved = load_le<uint32_t>(in + offsetof(PackedMetadataHeader, reserved));
+#endif
+        return h;
+    }
+
+    void store_header(uint8_t* out, const PackedBlockHeader& h) {
+#if PACKED_NATIVE_LITTLE_ENDIAN
+        std::memcpy(out, &h, sizeof(h));
+#else
+        store_le<uint32_t>(out + offsetof(PackedBlockHeader, magic), h.magic);
+        store_le<uint32_t>(out + offsetof(PackedBlockHeader, checksum_algorithm), h.checksum_algorithm);
+        store_le<uint64_t>(out + offsetof(PackedBlockHeader, offset), h.offset);
+        store_le<uint64_t>(out + offsetof(PackedBlockHeader, checksum), h.checksum);
+        store_le<uint32_t>(out + offsetof(PackedBlockHeader, block_id_length), h.block_id_length);
+        store_le<uint32_t>(out + offsetof(PackedBlockHeader, reserved), h.reserved);
+        store_le<uint64_t>(out + offsetof(PackedBlockHeader, data_length), h.data_length);
+#endif
+    }
+
+    PackedBlockHeader load_block_header(const uint8_t* in) {
+        PackedBlockHeader h;
+#if PACKED_NATIVE_LITTLE_ENDIAN
+        std::memcpy(&h, in, sizeof(h));
+#else
+        h.magic = load_le<uint32_t>(in + offsetof(PackedBlockHeader, magic));
+        h.checksum_algorithm = load_le<uint32_t>(in + offsetof(PackedBlockHeader, checksum_algorithm));
+        h.offset = load_le<uint64_t>(in + offsetof(PackedBlockHeader, offset));
+        h.checksum = load_le<uint64_t>(in + offsetof(PackedBlockHeader, checksum));
+        h.block_id_length = load_le<uint32_t>(in + offsetof(PackedBlockHeader, block_id_length));
+        h.reserved = load_le<uint32_t>(in + offsetof(PackedBlockHeader, reserved));
+        h.data_length = load_le<uint64_t>(in + offsetof(PackedBlockHeader, data_length));
+#endif
+        return h;
+    }
+
+    uint8_t* copy_string(uint8_t* out, const std::string& value) {
+        std::memcpy(out, value.data(), value.size());
+        return out + value.size();
+    }
+}
+
+std::vector<uint8_t> PackedSerializer::serialize_metadata(const FileMetadata& metadata) {
+    PackedMetadataHeader header;
+    header.magic = METADATA_MAGIC;
+    header.permissions = metadata.permissions;
+    header.size = metadata.size;
+    header.created_at = static_cast<int64_t>(metadata.created_at);
+    header.last_modified = static_cast<int64_t>(metadata.last_modified);
+    header.name_length = checked_u32(metadata.name.size());
+    header.path_length = checked_u32(metadata.path.size());
+    header.owner_length = checked_u32(metadata.owner.size());
+    header.group_length = checked_u32(metadata.group.size());
+    header.tag_count = checked_u32(metadata.tags.size());
+    header.reserved = 0;
+
+    size_t total_size = sizeof(header) + metadata.name.size() + metadata.path.size() +
+                        metadata.owner.size() + metadata.group.size();
+    for (const auto& tag : metadata.tags) {
+        total_size += varint_size(tag.size()) + tag.size();
+    }
+
+    std::vector<uint8_t> buffer(total_size);
+    uint8_t* p = buffer.data();
+
+    store_header(p, header);
+    p += sizeof(header);
+    p = copy_string(p, metadata.name);
+    p = copy_string(p, metadata.path);
+    p = copy_string(p, metadata.owner);
+    p = copy_string(p, metadata.group);
+    for (const auto& tag : metadata.tags) {
+        p = write_varint(p, tag.size());
+        p = copy_string(p, tag);
+    }
+
+    return buffer;
+}
+
+FileMetadata PackedSerializer::deserialize_metadata(const std::vector<uint8_t>& data) {
+    ByteReader reader(data);
+    PackedMetadataHeader header = load_metadata_header(reader.read_bytes(sizeof(PackedMetadataHeader)));
+    check_magic(header.magic, METADATA_MAGIC);
+
+    FileMetadata metadata;
+    metadata.size = header.size;
+    metadata.created_at = static_cast<time_t>(header.created_at);
+    metadata.last_modified = static_cast<time_t>(header.last_modified);
+    metadata.permissions = header.permissions;
+
+    metadata.name = reader.read_string(header.name_length);
+    metadata.path = reader.read_string(header.path_length);
+    metadata.owner = reader.read_string(header.owner_length);
+    metadata.group = reader.read_string(header.group_length);
+
+    // Every tag takes at least one byte, which bounds the reservation
+    if (header.tag_count > reader.remaining()) {
+        throw std::runtime_error("Tag count exceeds serialized data");
+    }
+    metadata.tags.reserve(header.tag_count);
+    for (uint32_t i = 0; i < header.tag_count; ++i) {
+        metadata.tags.push_back(reader.read_string(reader.read_varint()));
+    }
+
+    return metadata;
+}
+
+std::vector<uint8_t> PackedSerializer::serialize_block(const FileBlock& block) {
+    PackedBlockHeader header;
+    header.magic = BLOCK_MAGIC;
+    header.checksum_algorithm = static_cast<uint32_t>(block.checksum_algorithm);
+    header.offset = block.offset;
+    header.checksum = block.checksum;
+    header.block_id_length = checked_u32(block.block_id.size());
+    header.reserved = 0;
+    header.data_length = block.data.size();
+
+    std::vector<uint8_t> buffer(sizeof(header) + block.block_id.size() + block.data.size());
+    uint8_t* p = buffer.data();
+
+    store_header(p, header);
+    p += sizeof(header);
+    p = copy_string(p, block.block_id);
+    if (!block.data.empty()) {
+        std::memcpy(p, block.data.data(), block.data.size());
+    }
+
+    return buffer;
+}
+
+FileBlock PackedSerializer::deserialize_block(const std::vector<uint8_t>& data) {
+    return read_block(data, false);
+}
+
+FileBlock PackedSerializer::deserialize_block_verified(const std::vector<uint8_t>& data) {
+    return read_block(data, true);
+}
+
+FileBlock PackedSerializer::read_block(const std::vector<uint8_t>& data, bool verify) {
+    ByteReader reader(data);
+    PackedBlockHeader header = load_block_header(reader.read_bytes(sizeof(PackedBlockHeader)));
+    check_magic(header.magic, BLOCK_MAGIC);
+
+    FileBlock block;
+    block.block_id = reader.read_string(header.block_id_length);
+    block.offset = header.offset;
+
+    block.checksum = header.checksum;
+    block.checksum_algorithm = checksum_algorithm_from_value(header.checksum_algorithm);
+
+    const uint8_t* payload = reader.read_bytes(header.data_length);
+    if (verify) {
+        assign_verified_payload(block, payload, header.data_length);
+    } else {
+        block.data.assign(payload, payload + header.data_length);
+    }
+
+    return block;
+}
+
+namespace {
+    const SerializerRegistrar packed_registration(
+        "packed", "PackedPOD",
+        SerializerCapability::BinarySafe |
+        SerializerCapability::SchemaRequired |
+        SerializerCapability::Deterministic,
+        [] { return std::unique_ptr<SerializerInterface>(new PackedSerializer()); });
+}
+
+} // namespace benchmark
\ No newline at end of file
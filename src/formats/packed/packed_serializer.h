@@ -0,0 +1,91 @@
+#pragma once
+
+#include "common/serializer_interface.h"
+#include <cstddef>
+#include <type_traits>
+
+namespace benchmark {
+
+/**
+ * Fixed-width part of a packed metadata record. On the wire this struct is
+ * the first 56 bytes of the message, little-endian, with no padding, so
+ * little-endian hosts move it with a single memcpy.
+ * The string section follows: name, path, owner, group, then each tag as
+ * a varint length and its bytes.
+ */
+struct PackedMetadataHeader {
+    uint32_t magic;
+    uint32_t permissions;
+    uint64_t size;
+    int64_t created_at;
+    int64_t last_modified;
+    uint32_t name_length;
+    uint32_t path_length;
+    uint32_t owner_length;
+    uint32_t group_length;
+    uint32_t tag_count;
+    uint32_t reserved;
+};
+
+/**
+ * Fixed-width part of a packed block record, followed by the block id and
+ * the payload bytes.
+ */
+struct PackedBlockHeader {
+    uint32_t magic;
+    uint32_t checksum_algorithm;
+    uint64_t offset;
+    uint64_t checksum;
+    uint32_t block_id_length;
+    uint32_t reserved;
+    uint64_t data_length;
+};
+
+// The wire layout is the in-memory layout; any change here is a format change
+static_assert(std::is_trivially_copyable<PackedMetadataHeader>::value &&
+              std::is_standard_layout<PackedMetadataHeader>::value,
+              "PackedMetadataHeader must be a POD");
+static_assert(sizeof(PackedMetadataHeader) == 56, "PackedMetadataHeader layout changed");
+static_assert(offsetof(PackedMetadataHeader, size) == 8 &&
+              offsetof(PackedMetadataHeader, created_at) == 16 &&
+              offsetof(PackedMetadataHeader, last_modified) == 24 &&
+              offsetof(PackedMetadataHeader, name_length) == 32 &&
+              offsetof(PackedMetadataHeader, tag_count) == 48,
+              "PackedMetadataHeader field offsets changed");
+
+static_assert(std::is_trivially_copyable<PackedBlockHeader>::value &&
+              std::is_standard_layout<PackedBlockHeader>::value,
+              "PackedBlockHeader must be a POD");
+static_assert(sizeof(PackedBlockHeader) == 40, "PackedBlockHeader layout changed");
+static_assert(offsetof(PackedBlockHeader, offset) == 8 &&
+              offsetof(PackedBlockHeader, checksum) == 16 &&
+              offsetof(PackedBlockHeader, block_id_length) == 24 &&
+              offsetof(PackedBlockHeader, data_length) == 32,
+              "PackedBlockHeader field offsets changed");
+
+/**
+ * Cheapest-possible encoding for same-architecture node-to-node traffic:
+ * the fixed fields are one memcpy, strings are copied verbatim.
+ * Big-endian hosts still produce the little-endian wire format through a
+ * field-by-field fallback, and a byte-swapped magic is reported as an
+ * endianness mismatch instead of being misread.
+ */
+class PackedSerializer : public SerializerInterface {
+public:
+    std::string format_name() const override {
+        return "PackedPOD";
+    }
+
+    std::vector<uint8_t> serialize_metadata(const FileMetadata& metadata) override;
+    FileMetadata deserialize_metadata(const std::vector<uint8_t>& data) override;
+
+    std::vector<uint8_t> serialize_block(const FileBlock& block) override;
+    FileBlock deserialize_block(const std::vector<uint8_t>& data) override;
+    FileBlock deserialize_block_verified(const std::vector<uint8_t>& data) override;
+
+private:
+    // Shared by both block decoders; verify checksums the payload while copying it
+    FileBlock read_block(const std::vector<uint8_t>& data, bool verify);
+};
+
+} // namespace benchmark
\ No newline at end of file
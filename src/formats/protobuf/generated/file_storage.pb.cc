@@ -48,7 +48,8 @@ PROTOBUF_CONSTEXPR FileBlockProto::FileBlockProto(
     /*decltype(_impl_.block_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.data_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.offset_)*/uint64_t{0u}
-  , /*decltype(_impl_.checksum_)*/0u
+  , /*decltype(_impl_.checksum_)*/uint64_t{0u}
+  , /*decltype(_impl_.checksum_algorithm_)*/0u
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct FileBlockProtoDefaultTypeInternal {
   PROTOBUF_CONSTEXPR FileBlockProtoDefaultTypeInternal()
@@ -91,6 +92,7 @@ const uint32_t TableStruct_file_5fstorage_2eproto::offsets[] PROTOBUF_SECTION_VA
   PROTOBUF_FIELD_OFFSET(::benchmark::proto::FileBlockProto, _impl_.offset_),
   PROTOBUF_FIELD_OFFSET(::benchmark::proto::FileBlockProto, _impl_.data_),
   PROTOBUF_FIELD_OFFSET(::benchmark::proto::FileBlockProto, _impl_.checksum_),
+  PROTOBUF_FIELD_OFFSET(::benchmark::proto::FileBlockProto, _impl_.checksum_algorithm_),
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::benchmark::proto::FileMetadataProto)},
@@ -108,13 +110,14 @@ const char descriptor_table_protodef_file_5fstorage_2eproto[] PROTOBUF_SECTION_V
   "h\030\002 \001(\t\022\014\n\004size\030\003 \001(\004\022\022\n\ncreated_at\030\004 \001("
   "\004\022\025\n\rlast_modified\030\005 \001(\004\022\014\n\004tags\030\006 \003(\t\022\023"
   "\n\013permissions\030\007 \001(\r\022\r\n\005owner\030\010 \001(\t\022\r\n\005gr"
-  "oup\030\t \001(\t\"R\n\016FileBlockProto\022\020\n\010block_id\030"
+  "oup\030\t \001(\t\"n\n\016FileBlockProto\022\020\n\010block_id\030"
   "\001 \001(\t\022\016\n\006offset\030\002 \001(\004\022\014\n\004data\030\003 \001(\014\022\020\n\010c"
-  "hecksum\030\004 \001(\rb\006proto3"
+  "hecksum\030\004 \001(\004\022\032\n\022checksum_algorithm\030\005 \001("
+  "\rb\006proto3"
   ;
 static ::_pbi::once_flag descriptor_table_file_5fstorage_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_file_5fstorage_2eproto = {
-    false, false, 301, descriptor_table_protodef_file_5fstorage_2eproto,
+    false, false, 329, descriptor_table_protodef_file_5fstorage_2eproto,
     "file_storage.proto",
     &descriptor_table_file_5fstorage_2eproto_once, nullptr, 0, 2,
     schemas, file_default_instances, TableStruct_file_5fstorage_2eproto::offsets,
@@ -650,6 +653,7 @@ FileBlockProto::FileBlockProto(const FileBlockProto& from)
     , decltype(_impl_.data_){}
     , decltype(_impl_.offset_){}
     , decltype(_impl_.checksum_){}
+    , decltype(_impl_.checksum_algorithm_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -670,8 +674,8 @@ FileBlockProto::FileBlockProto(const FileBlockProto& from)
       _this->GetArenaForAllocation());
   }
   ::memcpy(&_impl_.offset_, &from._impl_.offset_,
-    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.checksum_) -
-    reinterpret_cast<char*>(&_impl_.offset_)) + sizeof(_impl_.checksum_));
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.checksum_algorithm_) -
+    reinterpret_cast<char*>(&_impl_.offset_)) + sizeof(_impl_.checksum_algorithm_));
   // @@protoc_insertion_point(copy_constructor:benchmark.proto.FileBlockProto)
 }
 
@@ -683,7 +687,8 @@ inline void FileBlockProto::SharedCtor(
       decltype(_impl_.block_id_){}
     , decltype(_impl_.data_){}
     , decltype(_impl_.offset_){uint64_t{0u}}
-    , decltype(_impl_.checksum_){0u}
+    , decltype(_impl_.checksum_){uint64_t{0u}}
+    , decltype(_impl_.checksum_algorithm_){0u}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.block_id_.InitDefault();
@@ -724,8 +729,8 @@ void FileBlockProto::Clear() {
   _impl_.block_id_.ClearToEmpty();
   _impl_.data_.ClearToEmpty();
   ::memset(&_impl_.offset_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&_impl_.checksum_) -
-      reinterpret_cast<char*>(&_impl_.offset_)) + sizeof(_impl_.checksum_));
+      reinterpret_cast<char*>(&_impl_.checksum_algorithm_) -
+      reinterpret_cast<char*>(&_impl_.offset_)) + sizeof(_impl_.checksum_algorithm_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -762,10 +767,18 @@ const char* FileBlockProto::_InternalParse(const char* ptr, ::_pbi::ParseContext
         } else
           goto handle_unusual;
         continue;
-      // uint32 checksum = 4;
+      // uint64 checksum = 4;
       case 4:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
-          _impl_.checksum_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          _impl_.checksum_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 checksum_algorithm = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.checksum_algorithm_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
           CHK_(ptr);
         } else
           goto handle_unusual;
@@ -821,10 +834,16 @@ uint8_t* FileBlockProto::_InternalSerialize(
         3, this->_internal_data(), target);
   }
 
-  // uint32 checksum = 4;
+  // uint64 checksum = 4;
   if (this->_internal_checksum() != 0) {
     target = stream->EnsureSpace(target);
-    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(4, this->_internal_checksum(), target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(4, this->_internal_checksum(), target);
+  }
+
+  // uint32 checksum_algorithm = 5;
+  if (this->_internal_checksum_algorithm() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(5, this->_internal_checksum_algorithm(), target);
   }
 
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
@@ -862,9 +881,14 @@ size_t FileBlockProto::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_offset());
   }
 
-  // uint32 checksum = 4;
+  // uint64 checksum = 4;
   if (this->_internal_checksum() != 0) {
-    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_checksum());
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_checksum());
+  }
+
+  // uint32 checksum_algorithm = 5;
+  if (this->_internal_checksum_algorithm() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_checksum_algorithm());
   }
 
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
@@ -897,6 +921,9 @@ void FileBlockProto::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const :
   if (from._internal_checksum() != 0) {
     _this->_internal_set_checksum(from._internal_checksum());
   }
+  if (from._internal_checksum_algorithm() != 0) {
+    _this->_internal_set_checksum_algorithm(from._internal_checksum_algorithm());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -925,8 +952,8 @@ void FileBlockProto::InternalSwap(FileBlockProto* other) {
       &other->_impl_.data_, rhs_arena
   );
   ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(FileBlockProto, _impl_.checksum_)
-      + sizeof(FileBlockProto::_impl_.checksum_)
+      PROTOBUF_FIELD_OFFSET(FileBlockProto, _impl_.checksum_algorithm_)
+      + sizeof(FileBlockProto::_impl_.checksum_algorithm_)
       - PROTOBUF_FIELD_OFFSET(FileBlockProto, _impl_.offset_)>(
           reinterpret_cast<char*>(&_impl_.offset_),
           reinterpret_cast<char*>(&other->_impl_.offset_));
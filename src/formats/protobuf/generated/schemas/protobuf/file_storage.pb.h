@@ -459,6 +459,7 @@ class FileBlockProto final :
     kDataFieldNumber = 3,
     kOffsetFieldNumber = 2,
     kChecksumFieldNumber = 4,
+    kChecksumAlgorithmFieldNumber = 5,
   };
   // string block_id = 1;
   void clear_block_id();
@@ -497,13 +498,22 @@ class FileBlockProto final :
   void _internal_set_offset(uint64_t value);
   public:
 
-  // uint32 checksum = 4;
+  // uint64 checksum = 4;
   void clear_checksum();
-  uint32_t checksum() const;
-  void set_checksum(uint32_t value);
+  uint64_t checksum() const;
+  void set_checksum(uint64_t value);
   private:
-  uint32_t _internal_checksum() const;
-  void _internal_set_checksum(uint32_t value);
+  uint64_t _internal_checksum() const;
+  void _internal_set_checksum(uint64_t value);
+  public:
+
+  // uint32 checksum_algorithm = 5;
+  void clear_checksum_algorithm();
+  uint32_t checksum_algorithm() const;
+  void set_checksum_algorithm(uint32_t value);
+  private:
+  uint32_t _internal_checksum_algorithm() const;
+  void _internal_set_checksum_algorithm(uint32_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:benchmark.proto.FileBlockProto)
@@ -517,7 +527,8 @@ class FileBlockProto final :
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr block_id_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr data_;
     uint64_t offset_;
-    uint32_t checksum_;
+    uint64_t checksum_;
+    uint32_t checksum_algorithm_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -1013,26 +1024,46 @@ inline void FileBlockProto::set_allocated_data(std::string* data) {
   // @@protoc_insertion_point(field_set_allocated:benchmark.proto.FileBlockProto.data)
 }
 
-// uint32 checksum = 4;
+// uint64 checksum = 4;
 inline void FileBlockProto::clear_checksum() {
-  _impl_.checksum_ = 0u;
+  _impl_.checksum_ = uint64_t{0u};
 }
-inline uint32_t FileBlockProto::_internal_checksum() const {
+inline uint64_t FileBlockProto::_internal_checksum() const {
   return _impl_.checksum_;
 }
-inline uint32_t FileBlockProto::checksum() const {
+inline uint64_t FileBlockProto::checksum() const {
   // @@protoc_insertion_point(field_get:benchmark.proto.FileBlockProto.checksum)
   return _internal_checksum();
 }
-inline void FileBlockProto::_internal_set_checksum(uint32_t value) {
+inline void FileBlockProto::_internal_set_checksum(uint64_t value) {
   
   _impl_.checksum_ = value;
 }
-inline void FileBlockProto::set_checksum(uint32_t value) {
+inline void FileBlockProto::set_checksum(uint64_t value) {
   _internal_set_checksum(value);
   // @@protoc_insertion_point(field_set:benchmark.proto.FileBlockProto.checksum)
 }
 
+// uint32 checksum_algorithm = 5;
+inline void FileBlockProto::clear_checksum_algorithm() {
+  _impl_.checksum_algorithm_ = 0u;
+}
+inline uint32_t FileBlockProto::_internal_checksum_algorithm() const {
+  return _impl_.checksum_algorithm_;
+}
+inline uint32_t FileBlockProto::checksum_algorithm() const {
+  // @@protoc_insertion_point(field_get:benchmark.proto.FileBlockProto.checksum_algorithm)
+  return _internal_checksum_algorithm();
+}
+inline void FileBlockProto::_internal_set_checksum_algorithm(uint32_t value) {
+  
+  _impl_.checksum_algorithm_ = value;
+}
+inline void FileBlockProto::set_checksum_algorithm(uint32_t value) {
+  _internal_set_checksum_algorithm(value);
+  // @@protoc_insertion_point(field_set:benchmark.proto.FileBlockProto.checksum_algorithm)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
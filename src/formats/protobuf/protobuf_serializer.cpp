@@ -1,16 +1,37 @@
 #include "formats/protobuf/protobuf_serializer.h"
 #include <google/protobuf/stubs/common.h>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include "common/serializer_registry.h"
 
 namespace benchmark {
 
-ProtobufSerializer::ProtobufSerializer() {
-    GOOGLE_PROTOBUF_VERIFY_VERSION;
+namespace {
+    // The protobuf runtime is process-wide state: verify the linked library
+    // once, and shut it down only at process exit. Shutting it down from an
+    // instance destructor would break every other live serializer, and the
+    // library cannot be re-initialized after ShutdownProtobufLibrary().
+    std::once_flag protobuf_init_flag;
+
+    void shutdown_protobuf_library() {
+        google::protobuf::ShutdownProtobufLibrary();
+    }
+
+    void ensure_protobuf_initialized() {
+        std::call_once(protobuf_init_flag, []() {
+            GOOGLE_PROTOBUF_VERIFY_VERSION;
+            std::atexit(shutdown_protobuf_library);
+        });
+    }
 }
 
-ProtobufSerializer::~ProtobufSerializer() {
-    google::protobuf::ShutdownProtobufLibrary();
+ProtobufSerializer::ProtobufSerializer() {
+    ensure_protobuf_initialized();
 }
 
+ProtobufSerializer::~ProtobufSerializer() = default;
+
 std::vector<uint8_t> ProtobufSerializer::serialize_metadata(const FileMetadata& metadata) {
     // Convert metadata to Protocol Buffers
     proto::FileMetadataProto proto = metadata_to_proto(metadata);
@@ -48,17 +69,35 @@ std::vector<uint8_t> ProtobufSerializer::serialize_block(const FileBlock& block)
 }
 
 FileBlock ProtobufSerializer::deserialize_block(const std::vector<uint8_t>& data) {
-    // Convert vector<uint8_t> to string
-    std::string serialized(data.begin(), data.end());
-    
-    // Parse the Protocol Buffers message
+    // Parse the Protocol Buffers message in place; blocks are large enough
+    // that an intermediate std::string copy shows up in profiles
     proto::FileBlockProto proto;
-    proto.ParseFromString(serialized);
+    proto.ParseFromArray(data.data(), static_cast<int>(data.size()));
     
     // Convert Protocol Buffers to block
     return proto_to_block(proto);
 }
 
+FileBlock ProtobufSerializer::deserialize_block_verified(const std::vector<uint8_t>& data) {
+    // Parse straight from the caller's buffer
+    proto::FileBlockProto proto;
+    if (!proto.ParseFromArray(data.data(), static_cast<int>(data.size()))) {
+        throw std::runtime_error("Failed to parse Protocol Buffers block");
+    }
+    
+    FileBlock block;
+    block.block_id = proto.block_id();
+    block.offset = proto.offset();
+    block.checksum = proto.checksum();
+    block.checksum_algorithm = checksum_algorithm_from_value(proto.checksum_algorithm());
+    
+    // Checksum the bytes field as it is copied out
+    const std::string& payload = proto.data();
+    assign_verified_payload(block, reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+    
+    return block;
+}
+
 proto::FileMetadataProto ProtobufSerializer::metadata_to_proto(const FileMetadata& metadata) {
     proto::FileMetadataProto proto;
     
@@ -109,6 +148,7 @@ proto::FileBlockProto ProtobufSerializer::block_to_proto(const FileBlock& block)
     proto.set_offset(block.offset);
     proto.set_data(std::string(block.data.begin(), block.data.end()));
     proto.set_checksum(block.checksum);
+    proto.set_checksum_algorithm(static_cast<uint32_t>(block.checksum_algorithm));
     
     return proto;
 }
@@ -123,8 +163,18 @@ FileBlock ProtobufSerializer::proto_to_block(const proto::FileBlockProto& proto)
     block.data.assign(data.begin(), data.end());
     
     block.checksum = proto.checksum();
+    block.checksum_algorithm = checksum_algorithm_from_value(proto.checksum_algorithm());
     
     return block;
 }
 
+namespace {
+    // proto3 string fields reject invalid UTF-8 on parse
+    const SerializerRegistrar protobuf_registration(
+        "protobuf", "Protocol Buffers",
+        SerializerCapability::SchemaRequired |
+        SerializerCapability::Deterministic,
+        [] { return std::unique_ptr<SerializerInterface>(new ProtobufSerializer()); });
+}
+
 } // namespace benchmark
\ No newline at end of file
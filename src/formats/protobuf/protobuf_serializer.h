@@ -19,6 +19,7 @@ public:
     
     std::vector<uint8_t> serialize_block(const FileBlock& block) override;
     FileBlock deserialize_block(const std::vector<uint8_t>& data) override;
+    FileBlock deserialize_block_verified(const std::vector<uint8_t>& data) override;
     
 private:
     // Helper methods for conversion between FileMetadata and Protocol Buffers
@@ -0,0 +1,318 @@
+#include "formats/tagless/tagless_serializer.h"
+#include <array>
+#include <stdexcept>
+#include "common/binary_encoding.h"
+#include "common/serializer_registry.h"
+
+namespace benchmark {
+
+namespace {
+    // Avro single-object encoding marker
+    const uint8_t SCHEMA_MARKER_0 = 0xC3;
+    const uint8_t SCHEMA_MARKER_1 = 0x01;
+    const size_t SCHEMA_HEADER_SIZE = 2 + sizeof(uint64_t);
+
+    const uint64_t CRC64_AVRO_EMPTY = 0xc15d213aa4d7a795ULL;
+
+    std::array<uint64_t, 256> make_crc64_avro_table() {
+        std::array<uint64_t, 256> table{};
+        for (uint64_t i = 0; i < 256; ++i) {
+            uint64_t fp = i;
+            for (int j = 0; j < 8; ++j) {
+                fp = (fp >> 1) ^ (CRC64_AVRO_EMPTY & (0 - (fp & 1)));
+            }
+            table[i] = fp;
+        }
+        return table;
+    }
+
+    // Avro long and int: zigzag varints. Unsigned fields keep their bit
+    // pattern, so a uint64_t above INT64_MAX is written as a negative long.
+    size_t long_size(int64_t value) {
+        return varint_size(zigzag_encode(value));
+    }
+
+    uint8_t* write_long(uint8_t* p, int64_t value) {
+        return write_varint(p, zigzag_encode(value));
+    }
+
+    int32_t read_int(ByteReader& reader) {
+        int64_t value = reader.read_zigzag();
+        if (value < INT32_MIN || value > INT32_MAX) {
+            throw std::runtime_error("Avro int out of range");
+        }
+        return static_cast<int32_t>(value);
+    }
+
+    // String and bytes lengths are Avro longs too
+    uint64_t read_length(ByteReader& reader) {
+        int64_t length = reader.read_zigzag();
+        if (length < 0) {
+            throw std::runtime_error("Negative length in serialized data");
+        }
+        return static_cast<uint64_t>(length);
+    }
+
+    size_t string_size(const std::string& value) {
+        return long_size(static_cast<int64_t>(value.size())) + value.size();
+    }
+
+    uint8_t* write_string(uint8_t* p, const std::string& value) {
+        p = write_long(p, static_cast<int64_t>(value.size()));
+        std::memcpy(p, value.data(), value.size());
+        return p + value.size();
+    }
+
+    std::string read_string(ByteReader& reader) {
+        return reader.read_string(read_length(reader));
+    }
+
+    // Arrays are written as a single block of items followed by the empty
+    // block that ends every Avro array; an empty array is the end marker alone.
+    size_t string_array_size(const std::vector<std::string>& values) {
+        size_t size = 1;
+        if (!values.empty()) {
+            size += long_size(static_cast<int64_t>(values.size()));
+            for (const auto& value : values) {
+                size += string_size(value);
+            }
+        }
+        return size;
+    }
+
+    uint8_t* write_string_array(uint8_t* p, const std::vector<std::string>& values) {
+        if (!values.empty()) {
+            p = write_long(p, static_cast<int64_t>(values.size()));
+            for (const auto& value : values) {
+                p = write_string(p, value);
+            }
+        }
+        return write_long(p, 0);
+    }
+
+    // Accepts any block layout a conforming writer may produce, including
+    // negative counts that are followed by the block's size in bytes.
+    std::vector<std::string> read_string_array(ByteReader& reader) {
+        std::vector<std::string> values;
+        for (;;) {
+            int64_t count = reader.read_zigzag();
+            if (count == 0) {
+                break;
+            }
+            uint64_t items = static_cast<uint64_t>(count);
+            if (count < 0) {
+                items = 0 - items;
+                read_length(reader);
+            }
+            // Every item takes at least one byte, which bounds the reservation
+            if (items > reader.remaining()) {
+                throw std::runtime_error("Array count exceeds serialized data");
+            }
+            values.reserve(values.size() + items);
+            for (uint64_t i = 0; i < items; ++i) {
+                values.push_back(read_string(reader));
+            }
+        }
+        return values;
+    }
+
+    uint8_t* write_schema_header(uint8_t* p, uint64_t fingerprint) {
+        *p++ = SCHEMA_MARKER_0;
+        *p++ = SCHEMA_MARKER_1;
+        store_le<uint64_t>(p, fingerprint);
+        return p + sizeof(uint64_t);
+    }
+
+    void read_schema_header(ByteReader& reader, uint64_t expected_fingerprint) {
+        const uint8_t* marker = reader.read_bytes(2);
+        if (marker[0] != SCHEMA_MARKER_0 || marker[1] != SCHEMA_MARKER_1) {
+            throw std::runtime_error("Missing tagless schema header");
+        }
+        // Only one schema version exists per record today, so resolution is
+        // an exact match; older writer schemas would be looked up here.
+        if (reader.read_le<uint64_t>() != expected_fingerprint) {
+            throw std::runtime_error("Unknown writer schema fingerprint");
+        }
+    }
+}
+
+TaglessSerializer::TaglessSerializer(bool write_schema_header)
+    : write_schema_header_(write_schema_header) {
+}
+
+std::vector<uint8_t> TaglessSerializer::serialize_metadata(const FileMetadata& metadata) {
+    // Compute the exact encoded size so the buffer is allocated once
+    size_t total_size = (write_schema_header_ ? SCHEMA_HEADER_SIZE : 0) +
+                        string_size(metadata.name) +
+                        string_size(metadata.path) +
+                        long_size(static_cast<int64_t>(metadata.size)) +
+                        long_size(metadata.created_at) +
+                        long_size(metadata.last_modified) +
+                        string_array_size(metadata.tags) +
+                        long_size(static_cast<int32_t>(metadata.permissions)) +
+                        string_size(metadata.owner) +
+                        string_size(metadata.group);
+
+    std::vector<uint8_t> buffer(total_size);
+    uint8_t* p = buffer.data();
+
+    if (write_schema_header_) {
+        p = write_schema_header(p, metadata_schema_fingerprint());
+    }
+    p = write_string(p, metadata.name);
+    p = write_string(p, metadata.path);
+    p = write_long(p, static_cast<int64_t>(metadata.size));
+    p = write_long(p, metadata.created_at);
+    p = write_long(p, metadata.last_modified);
+    p = write_string_array(p, metadata.tags);
+    p = write_long(p, static_cast<int32_t>(metadata.permissions));
+    p = write_string(p, metadata.owner);
+    write_string(p, metadata.group);
+
+    return buffer;
+}
+
+FileMetadata TaglessSerializer::deserialize_metadata(const std::vector<uint8_t>& data) {
+    ByteReader reader(data);
+    if (write_schema_header_) {
+        read_schema_header(reader, metadata_schema_fingerprint());
+    }
+
+    FileMetadata metadata;
+    metadata.name = read_string(reader);
+    metadata.path = read_string(reader);
+    metadata.size = static_cast<uint64_t>(reader.read_zigzag());
+    metadata.created_at = static_cast<time_t>(reader.read_zigzag());
+    metadata.last_modified = static_cast<time_t>(reader.read_zigzag());
+    metadata.tags = read_string_array(reader);
+    metadata.permissions = static_cast<uint32_t>(read_int(reader));
+    metadata.owner = read_string(reader);
+    metadata.group = read_string(reader);
+
+    return metadata;
+}
+
+std::vector<uint8_t> TaglessSerializer::serialize_block(const FileBlock& block) {
+    size_t total_size = (write_schema_header_ ? SCHEMA_HEADER_SIZE : 0) +
+                        string_size(block.block_id) +
+                        long_size(static_cast<int64_t>(block.offset)) +
+                        long_size(static_cast<int64_t>(block.data.size())) + block.data.size() +
+                        long_size(static_cast<int64_t>(block.checksum)) +
+                        long_size(static_cast<int32_t>(block.checksum_algorithm));
+
+    std::vector<uint8_t> buffer(total_size);
+    uint8_t* p = buffer.data();
+
+    if (write_schema_header_) {
+        p = write_schema_header(p, block_schema_fingerprint());
+    }
+    p = write_string(p, block.block_id);
+    p = write_long(p, static_cast<int64_t>(block.offset));
+    p = write_long(p, static_cast<int64_t>(block.data.size()));
+    if (!block.data.empty()) {
+        std::memcpy(p, block.data.data(), block.data.size());
+    }
+    p += block.data.size();
+    p = write_long(p, static_cast<int64_t>(block.checksum));
+    write_long(p, static_cast<int32_t>(block.checksum_algorithm));
+
+    return buffer;
+}
+
+FileBlock TaglessSerializer::deserialize_block(const std::vector<uint8_t>& data) {
+    return read_block(data, false);
+}
+
+FileBlock TaglessSerializer::deserialize_block_verified(const std::vector<uint8_t>& data) {
+    return read_block(data, true);
+}
+
+FileBlock TaglessSerializer::read_block(const std::vector<uint8_t>& data, bool verify) {
+    ByteReader reader(data);
+    if (write_schema_header_) {
+        read_schema_header(reader, block_schema_fingerprint());
+    }
+
+    FileBlock block;
+    block.block_id = read_string(reader);
+    block.offset = static_cast<uint64_t>(reader.read_zigzag());
+
+    // The checksum follows the payload, so hold on to the payload until it is known
+    size_t data_size = read_length(reader);
+    const uint8_t* payload = reader.read_bytes(data_size);
+
+    block.checksum = static_cast<uint64_t>(reader.read_zigzag());
+    block.checksum_algorithm = checksum_algorithm_from_value(static_cast<uint64_t>(read_int(reader)));
+
+    if (verify) {
+        assign_verified_payload(block, payload, data_size);
+    } else {
+        block.data.assign(payload, payload + data_size);
+    }
+
+    return block;
+}
+
+const std::string& TaglessSerializer::metadata_schema() {
+    static const std::string schema =
+        "{\"name\":\"benchmark.FileMetadata\",\"type\":\"record\",\"fields\":["
+        "{\"name\":\"name\",\"type\":\"string\"},"
+        "{\"name\":\"path\",\"type\":\"string\"},"
+        "{\"name\":\"size\",\"type\":\"long\"},"
+        "{\"name\":\"created_at\",\"type\":\"long\"},"
+        "{\"name\":\"last_modified\",\"type\":\"long\"},"
+        "{\"name\":\"tags\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},"
+        "{\"name\":\"permissions\",\"type\":\"int\"},"
+        "{\"name\":\"owner\",\"type\":\"string\"},"
+        "{\"name\":\"group\",\"type\":\"string\"}]}";
+    return schema;
+}
+
+const std::string& TaglessSerializer::block_schema() {
+    static const std::string schema =
+        "{\"name\":\"benchmark.FileBlock\",\"type\":\"record\",\"fields\":["
+        "{\"name\":\"block_id\",\"type\":\"string\"},"
+        "{\"name\":\"offset\",\"type\":\"long\"},"
+        "{\"name\":\"data\",\"type\":\"bytes\"},"
+        "{\"name\":\"checksum\",\"type\":\"long\"},"
+        "{\"name\":\"checksum_algorithm\",\"type\":\"int\"}]}";
+    return schema;
+}
+
+uint64_t TaglessSerializer::metadata_schema_fingerprint() {
+    static const uint64_t fingerprint = schema_fingerprint(metadata_schema());
+    return fingerprint;
+}
+
+uint64_t TaglessSerializer::block_schema_fingerprint() {
+    static const uint64_t fingerprint = schema_fingerprint(block_schema());
+    return fingerprint;
+}
+
+uint64_t TaglessSerializer::schema_fingerprint(const std::string& schema) {
+    static const std::array<uint64_t, 256> table = make_crc64_avro_table();
+
+    uint64_t fp = CRC64_AVRO_EMPTY;
+    for (unsigned char c : schema) {
+        fp = (fp >> 8) ^ table[(fp ^ c) & 0xff];
+    }
+    return fp;
+}
+
+namespace {
+    const SerializerRegistrar tagless_registration(
+        "tagless", "Tagless",
+        SerializerCapability::BinarySafe |
+        SerializerCapability::SchemaRequired |
+        SerializerCapability::Deterministic,
+        [] { return std::unique_ptr<SerializerInterface>(new TaglessSerializer()); });
+
+    const SerializerRegistrar tagless_schema_registration(
+        "tagless-schema", "Tagless+Schema",
+        SerializerCapability::BinarySafe |
+        SerializerCapability::SchemaRequired |
+        SerializerCapability::Deterministic,
+        [] { return std::unique_ptr<SerializerInterface>(new TaglessSerializer(true)); });
+}
+
+} // namespace benchmark
\ No newline at end of file
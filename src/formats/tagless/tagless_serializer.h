@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common/serializer_interface.h"
+
+namespace benchmark {
+
+/**
+ * Schema-driven Avro binary encoding with no per-field tags or type markers.
+ * Fields are written in schema order as the schemas below declare them:
+ * longs, ints and lengths as zigzag varints (unsigned fields are written
+ * as their two's-complement bit pattern), strings and bytes as a length
+ * followed by the raw bytes, and arrays as a block of items ended by an
+ * empty block.
+ *
+ * With a schema header enabled, every message starts with the Avro
+ * single-object marker (0xC3 0x01) and the 8-byte little-endian CRC-64-AVRO
+ * fingerprint of the writer schema, and the reader rejects messages whose
+ * fingerprint it does not know.
+ */
+class TaglessSerializer : public SerializerInterface {
+public:
+    explicit TaglessSerializer(bool write_schema_header = false);
+
+    std::string format_name() const override {
+        return write_schema_header_ ? "Tagless+Schema" : "Tagless";
+    }
+
+    std::vector<uint8_t> serialize_metadata(const FileMetadata& metadata) override;
+    FileMetadata deserialize_metadata(const std::vector<uint8_t>& data) override;
+
+    std::vector<uint8_t> serialize_block(const FileBlock& block) override;
+    FileBlock deserialize_block(const std::vector<uint8_t>& data) override;
+    FileBlock deserialize_block_verified(const std::vector<uint8_t>& data) override;
+
+    // Canonical schema text and its CRC-64-AVRO fingerprint
+    static const std::string& metadata_schema();
+    static const std::string& block_schema();
+    static uint64_t metadata_schema_fingerprint();
+    static uint64_t block_schema_fingerprint();
+
+    // CRC-64-AVRO (Rabin) fingerprint of arbitrary schema text
+    static uint64_t schema_fingerprint(const std::string& schema);
+
+private:
+    bool write_schema_header_;
+
+    // Shared by both block decoders; verify checksums the payload while copying it
+    FileBlock read_block(const std::vector<uint8_t>& data, bool verify);
+};
+
+} // namespace benchmark
\ No newline at end of file
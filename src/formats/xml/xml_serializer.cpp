@@ -1,6 +1,8 @@
 #include "formats/xml/xml_serializer.h"
 #include <sstream>
 #include <stdexcept>
+#include "common/serializer_registry.h"
+#include "common/utilities.h"
 
 static const std::string base64_chars =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
@@ -81,6 +83,30 @@ FileBlock XmlSerializer::deserialize_block(const std::vector<uint8_t>& data) {
     return xml_to_block(doc);
 }
 
+FileBlock XmlSerializer::deserialize_block_verified(const std::vector<uint8_t>& data) {
+    std::string xml_str(data.begin(), data.end());
+    
+    pugi::xml_document doc;
+    pugi::xml_parse_result result = doc.load_string(xml_str.c_str());
+    
+    if (!result) {
+        throw std::runtime_error("XML parse error: " + std::string(result.description()));
+    }
+    
+    // The algorithm has to be known before the payload is decoded
+    pugi::xml_node root = doc.child("FileBlock");
+    ChecksumState state(checksum_algorithm_from_value(
+        root.child("checksum_algorithm").text().as_ullong(
+            static_cast<unsigned long long>(ChecksumAlgorithm::Adler32))));
+    
+    FileBlock block = xml_to_block(doc, &state);
+    if (state.finalize() != block.checksum) {
+        throw std::runtime_error("Checksum mismatch after deserialization");
+    }
+    
+    return block;
+}
+
 void XmlSerializer::metadata_to_xml(const FileMetadata& metadata, pugi::xml_node& root) {
     root.append_child("name").text().set(metadata.name.c_str());
     root.append_child("path").text().set(metadata.path.c_str());
@@ -128,17 +154,23 @@ void XmlSerializer::block_to_xml(const FileBlock& block, pugi::xml_node& root) {
     root.append_child("offset").text().set(block.offset);
     root.append_child("data").text().set(base64_encode(block.data).c_str());
     root.append_child("checksum").text().set(block.checksum);
+    root.append_child("checksum_algorithm").text().set(
+        static_cast<unsigned int>(block.checksum_algorithm));
 }
 
-FileBlock XmlSerializer::xml_to_block(const pugi::xml_document& doc) {
+FileBlock XmlSerializer::xml_to_block(const pugi::xml_document& doc, ChecksumState* state) {
     FileBlock block;
     
     pugi::xml_node root = doc.child("FileBlock");
     
     block.block_id = root.child("block_id").text().get();
     block.offset = root.child("offset").text().as_ullong();
-    block.data = base64_decode(root.child("data").text().get());
-    block.checksum = root.child("checksum").text().as_uint();
+    block.data = base64_decode(root.child("data").text().get(), state);
+    block.checksum = root.child("checksum").text().as_ullong();
+    // Missing element means a document written before algorithms were selectable
+    block.checksum_algorithm = checksum_algorithm_from_value(
+        root.child("checksum_algorithm").text().as_ullong(
+            static_cast<unsigned long long>(ChecksumAlgorithm::Adler32)));
     
     return block;
 }
@@ -174,7 +206,11 @@ std::string XmlSerializer::base64_encode(const std::vector<uint8_t>& data) {
     return result;
 }
 
-std::vector<uint8_t> XmlSerializer::base64_decode(std::string const& encoded_string) {
+std::vector<uint8_t> XmlSerializer::base64_decode(std::string const& encoded_string, ChecksumState* state) {
+    // Decoded bytes are handed to state every CHECK_STRIP bytes, while still in cache
+    const size_t CHECK_STRIP = 8 * 1024;
+    size_t checked = 0;
+
     int in_len = encoded_string.size();
     int i = 0;
     int in_ = 0;
@@ -194,6 +230,11 @@ std::vector<uint8_t> XmlSerializer::base64_decode(std::string const& encoded_str
             for (i = 0; (i < 3); i++)
                 ret.push_back(char_array_3[i]);
             i = 0;
+
+            if (state != nullptr && ret.size() - checked >= CHECK_STRIP) {
+                state->update(ret.data() + checked, ret.size() - checked);
+                checked = ret.size();
+            }
         }
     }
 
@@ -211,7 +252,19 @@ std::vector<uint8_t> XmlSerializer::base64_decode(std::string const& encoded_str
         for (int j = 0; (j < i - 1); j++) ret.push_back(char_array_3[j]);
     }
 
+    if (state != nullptr) {
+        state->update(ret.data() + checked, ret.size() - checked);
+    }
+
     return ret;
 }
 
+namespace {
+    // Control characters are not allowed in XML text
+    const SerializerRegistrar xml_registration(
+        "xml", "XML",
+        static_cast<SerializerCapabilities>(SerializerCapability::Deterministic),
+        [] { return std::unique_ptr<SerializerInterface>(new XmlSerializer()); });
+}
+
 } // namespace benchmark
\ No newline at end of file
@@ -16,6 +16,7 @@ public:
     
     std::vector<uint8_t> serialize_block(const FileBlock& block) override;
     FileBlock deserialize_block(const std::vector<uint8_t>& data) override;
+    FileBlock deserialize_block_verified(const std::vector<uint8_t>& data) override;
     
 private:
     // Helper methods for conversion between FileMetadata and XML
@@ -24,11 +25,11 @@ private:
     
     // Helper methods for conversion between FileBlock and XML
     void block_to_xml(const FileBlock& block, pugi::xml_node& root);
-    FileBlock xml_to_block(const pugi::xml_document& doc);
+    FileBlock xml_to_block(const pugi::xml_document& doc, ChecksumState* state = nullptr);
     
     // Helper methods for base64 encoding/decoding
     std::string base64_encode(const std::vector<uint8_t>& data);
-    std::vector<uint8_t> base64_decode(const std::string& encoded);
+    std::vector<uint8_t> base64_decode(const std::string& encoded, ChecksumState* state = nullptr);
 };
 
 } // namespace benchmark
\ No newline at end of file
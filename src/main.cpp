@@ -1,25 +1,753 @@
+#include <fnmatch.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/benchmark_runner.h"
+#include "common/corpus.h"
+#include "common/corpus_cache.h"
 #include "common/data_structures.h"
+#include "common/filesystem_crawler.h"
+#include "common/parameter_sweep.h"
 #include "common/serializer_interface.h"
+#include "common/serializer_registry.h"
+#include "common/test_data_generator.h"
+#include "common/utilities.h"
+#include "common/working_set.h"
+#include "common/workload_profile.h"
+
+using namespace benchmark;
+
+namespace {
+    // Fixed, so a seed always generates the same records
+    const time_t CLI_REFERENCE_TIME = 1700000000;
+
+    // Operation names as they appear in results
+    const std::vector<std::string>& operation_names() {
+        static const std::vector<std::string> operations = {
+            "metadata_serialization",
+            "metadata_deserialization",
+            "metadata_field_read",
+            "metadata_all_fields_read",
+            "metadata_batch_serialization",
+            "metadata_batch_deserialization",
+            "block_serialization",
+            "block_deserialization",
+            "block_decode_strict",
+            "block_decode_deferred",
+            "block_decode_trusted",
+        };
+        return operations;
+    }
+
+    CrawlOptions default_crawl_options() {
+        CrawlOptions crawl;
+        crawl.max_files = 100000;
+        crawl.block_size = 64 * 1024;
+        crawl.max_block_bytes = 64 * 1024 * 1024;
+        return crawl;
+    }
+
+    struct CliOptions {
+        std::vector<std::string> formats = {"*"};
+        SerializerCapabilities capabilities = 0;   // Formats must have all of these
+        std::vector<std::string> operations = {"*"};
+        std::vector<std::string> sizes = {"*"};
+        std::vector<size_t> block_sizes = {1024, 64 * 1024, 1024 * 1024};
+        std::vector<size_t> batch_sizes = {16, 256};
+        bool block_sizes_set = false;
+        bool batch_sizes_set = false;
+        size_t records = 1;             // Generated records each single-record operation rotates through
+
+        std::string mode = "standard";  // standard, scaling, sweep or working-set
+        size_t threads = 0;             // Most threads of a scaling run; 0 is one per allowed CPU
+        bool threads_set = false;
+
+        TimingOptions timing;
+        bool memcpy_baseline = false;
+
+        WorkloadProfile profile = default_workload_profile();
+        unsigned seed = 42;
+        ChecksumAlgorithm checksum = ChecksumAlgorithm::Adler32;
+
+        std::string crawl_root;
+        CrawlOptions crawl = default_crawl_options();
+        std::string corpus_file;
+        std::string corpus_cache_file;
+
+        std::string output = "table";   // table, csv or json
+        std::string output_file;        // Standard output when empty
+    };
+
+    void print_usage(const char* program) {
+        std::cout
+            << "Usage: " << program << " [options]\n"
+            << "\n"
+            << "Selection (comma-separated, case-insensitive globs):\n"
+            << "  --format GLOBS          Formats by key or name (default *)\n"
+            << "  --capability LIST       Only formats with all of these, e.g. zero-copy,binary-safe\n"
+            << "  --operation GLOBS       Operations (default *); results of per-size operations\n"
+            << "                          are named with the size, e.g. block_serialization/64KiB\n"
+            << "  --size GLOBS            Block sizes (e.g. 64KiB) and batch sizes (e.g. 256rec);\n"
+            << "                          operations without a size ignore it (default *)\n"
+            << "  --block-sizes LIST      Generated block sizes, e.g. 4K,1M (default 1K,64K,1M)\n"
+            << "  --batch-sizes LIST      Metadata batch sizes (default 16,256)\n"
+            << "  --records N             Distinct generated records per single-record operation (default 1)\n"
+            << "\n"
+            << "Timing:\n"
+            << "  --iterations N          Samples per benchmark (default 100)\n"
+            << "  --time SECONDS          Stop sampling a benchmark after SECONDS, even before --iterations\n"
+            << "                          samples (default 5); with --threads, the window per thread count\n"
+            << "  --target-rse X          Keep sampling until the relative standard error is below X\n"
+            << "  --min-sample-ns N       Batch calls until a sample takes N ns; percentiles are then\n"
+            << "                          of batch averages (default 0 times every call)\n"
+            << "  --counters              Count CPU events per operation where permitted\n"
+            << "  --flush-cache           Evict every cache level before each call\n"
+            << "  --memcpy                Add memcpy baselines at each wire size\n"
+            << "\n"
+            << "Modes:\n"
+            << "  --mode NAME             standard, scaling, sweep or working-set (default standard)\n"
+            << "  --threads N             Scale up to N threads (0 = one per usable CPU); implies\n"
+            << "                          --mode scaling. Scaling times the first record of each\n"
+            << "                          input; sweep and working-set generate their own inputs.\n"
+            << "                          Options a mode does not use are rejected.\n"
+            << "\n"
+            << "Inputs (generated unless a corpus is given):\n"
+            << "  --profile NAME          Workload profile of generated records\n"
+            << "  --seed N                Generator seed (default 42)\n"
+            << "  --checksum NAME         Generated block checksum: adler32, crc32c or xxhash64\n"
+            << "  --crawl DIR             Benchmark the files under DIR\n"
+            << "  --crawl-max-files N     Stop crawling after N files (default 100000, 0 = no limit)\n"
+            << "  --crawl-block-size SIZE Chunk crawled files into blocks (default 64K, 0 = metadata only)\n"
+            << "  --crawl-max-bytes SIZE  Total crawled block payload (default 64M, 0 = no limit)\n"
+            << "  --corpus FILE           Replay a corpus saved with save_corpus\n"
+            << "  --corpus-cache FILE     Replay a corpus cache, decoding its stored encodings\n"
+            << "\n"
+            << "Output:\n"
+            << "  --output FORMAT         table, csv or json (default table)\n"
+            << "  --output-file FILE      Write csv or json here instead of standard output\n"
+            << "  --list-formats          List formats and exit\n"
+            << "  --list-operations       List operations and exit\n"
+            << "  --list-profiles         List workload profiles and exit\n"
+            << "  --help                  Show this help" << std::endl;
+    }
+
+    std::vector<std::string> split_list(const std::string& text) {
+        std::vector<std::string> items;
+        size_t start = 0;
+        while (start <= text.size()) {
+            size_t comma = std::min(text.find(',', start), text.size());
+            if (comma > start) {
+                items.push_back(text.substr(start, comma - start));
+            }
+            start = comma + 1;
+        }
+        return items;
+    }
+
+    bool matches_any(const std::vector<std::string>& patterns, const std::string& value) {
+        for (const auto& pattern : patterns) {
+            if (fnmatch(pattern.c_str(), value.c_str(), FNM_CASEFOLD) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t parse_count(const std::string& text) {
+        if (text.empty() || !std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c); })) {
+            throw std::invalid_argument("Invalid number: " + text);
+        }
+        unsigned long long value = 0;
+        try {
+            value = std::stoull(text);
+        } catch (const std::out_of_range&) {
+            throw std::invalid_argument("Number too large: " + text);
+        }
+        if (value > SIZE_MAX) {
+            throw std::invalid_argument("Number too large: " + text);
+        }
+        return static_cast<size_t>(value);
+    }
+
+    // A byte count with an optional binary suffix: 512, 4K, 64KiB, 1M, 2G
+    size_t parse_size(const std::string& text) {
+        size_t digits = 0;
+        while (digits < text.size() && std::isdigit(static_cast<unsigned char>(text[digits]))) {
+            ++digits;
+        }
+        std::string suffix = text.substr(digits);
+        std::transform(suffix.begin(), suffix.end(), suffix.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        size_t shift = 0;
+        if (suffix == "k" || suffix == "kib") {
+            shift = 10;
+        } else if (suffix == "m" || suffix == "mib") {
+            shift = 20;
+        } else if (suffix == "g" || suffix == "gib") {
+            shift = 30;
+        } else if (!suffix.empty() && suffix != "b") {
+            throw std::invalid_argument("Invalid size: " + text);
+        }
+        size_t count = parse_count(text.substr(0, digits));
+        if (count > (SIZE_MAX >> shift)) {
+            throw std::invalid_argument("Size too large: " + text);
+        }
+        return count << shift;
+    }
+
+    double parse_number(const std::string& text) {
+        size_t end = 0;
+        double value = std::stod(text, &end);
+        if (end != text.size() || value < 0.0) {
+            throw std::invalid_argument("Invalid number: " + text);
+        }
+        return value;
+    }
+
+    // The label --size matches block sizes against: 512B, 4KiB, 1MiB
+    std::string size_label(size_t bytes) {
+        if (bytes != 0 && bytes % (size_t(1) << 30) == 0) {
+            return std::to_string(bytes >> 30) + "GiB";
+        }
+        if (bytes != 0 && bytes % (size_t(1) << 20) == 0) {
+            return std::to_string(bytes >> 20) + "MiB";
+        }
+        if (bytes != 0 && bytes % 1024 == 0) {
+            return std::to_string(bytes >> 10) + "KiB";
+        }
+        return std::to_string(bytes) + "B";
+    }
+
+    std::string batch_label(size_t records) {
+        return std::to_string(records) + "rec";
+    }
+
+    // Results of per-size operations name the input they ran on, as in
+    // metadata_batch_serialization/256rec, so rows of different sizes stay apart
+    template<typename Result>
+    Result with_input_label(Result result, const std::string& label) {
+        result.operation_name += "/" + label;
+        return result;
+    }
+
+    // Parses argv into options. Returns an exit code when the arguments only
+    // asked for a listing or help, or -1 to go on and benchmark. Throws
+    // std::invalid_argument on bad arguments.
+    int parse_arguments(int argc, char* argv[], CliOptions& options) {
+        std::set<std::string> given;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            given.insert(arg);
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(arg + " needs a value");
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--help") {
+                print_usage(argv[0]);
+                return 0;
+            } else if (arg == "--list-formats") {
+                for (const auto& registration : SerializerRegistry::instance().formats()) {
+                    std::cout << registration.key << "\t" << registration.format_name << "\t"
+                              << serializer_capability_names(registration.capabilities) << std::endl;
+                }
+                return 0;
+            } else if (arg == "--list-operations") {
+                for (const auto& operation : operation_names()) {
+                    std::cout << operation << std::endl;
+                }
+                return 0;
+            } else if (arg == "--list-profiles") {
+                for (const auto& name : workload_profile_names()) {
+                    std::cout << name << std::endl;
+                }
+                return 0;
+            } else if (arg == "--format") {
+                options.formats = split_list(value());
+            } else if (arg == "--capability") {
+                for (const auto& name : split_list(value())) {
+                    SerializerCapability capability;
+                    if (!parse_serializer_capability(name, capability)) {
+                        throw std::invalid_argument("Unknown capability: " + name);
+                    }
+                    options.capabilities = options.capabilities | capability;
+                }
+            } else if (arg == "--operation") {
+                options.operations = split_list(value());
+            } else if (arg == "--size") {
+                options.sizes = split_list(value());
+            } else if (arg == "--block-sizes" || arg == "--batch-sizes") {
+                std::vector<size_t> sizes;
+                for (const auto& item : split_list(value())) {
+                    sizes.push_back(arg == "--block-sizes" ? parse_size(item) : parse_count(item));
+                }
+                if (sizes.empty() || std::count(sizes.begin(), sizes.end(), size_t(0)) > 0) {
+                    throw std::invalid_argument(arg + " needs sizes above zero");
+                }
+                if (arg == "--block-sizes") {
+                    options.block_sizes = sizes;
+                    options.block_sizes_set = true;
+                } else {
+                    options.batch_sizes = sizes;
+                    options.batch_sizes_set = true;
+                }
+            } else if (arg == "--records") {
+                options.records = std::max<size_t>(1, parse_count(value()));
+            } else if (arg == "--iterations") {
+                options.timing.samples = std::max<size_t>(1, parse_count(value()));
+            } else if (arg == "--time") {
+                options.timing.max_seconds = parse_number(value());
+                options.timing.scaling_seconds = options.timing.max_seconds;
+            } else if (arg == "--target-rse") {
+                options.timing.target_rse = parse_number(value());
+            } else if (arg == "--min-sample-ns") {
+                options.timing.min_sample_ns = parse_count(value());
+            } else if (arg == "--counters") {
+                options.timing.hardware_counters = true;
+            } else if (arg == "--flush-cache") {
+                options.timing.flush_cache = true;
+            } else if (arg == "--memcpy") {
+                options.memcpy_baseline = true;
+            } else if (arg == "--mode") {
+                options.mode = value();
+            } else if (arg == "--threads") {
+                options.threads = parse_count(value());
+                options.threads_set = true;
+            } else if (arg == "--profile") {
+                std::string name = value();
+                if (!find_workload_profile(name, options.profile)) {
+                    throw std::invalid_argument("Unknown workload profile: " + name);
+                }
+            } else if (arg == "--seed") {
+                std::string text = value();
+                size_t seed = parse_count(text);
+                if (seed > std::numeric_limits<unsigned>::max()) {
+                    throw std::invalid_argument("Seed too large: " + text);
+                }
+                options.seed = static_cast<unsigned>(seed);
+            } else if (arg == "--checksum") {
+                std::string name = value();
+                if (!parse_checksum_algorithm(name, options.checksum)) {
+                    throw std::invalid_argument("Unknown checksum algorithm: " + name);
+                }
+            } else if (arg == "--crawl") {
+                options.crawl_root = value();
+            } else if (arg == "--crawl-max-files") {
+                options.crawl.max_files = parse_count(value());
+            } else if (arg == "--crawl-block-size") {
+                options.crawl.block_size = parse_size(value());
+            } else if (arg == "--crawl-max-bytes") {
+                options.crawl.max_block_bytes = parse_size(value());
+            } else if (arg == "--corpus") {
+                options.corpus_file = value();
+            } else if (arg == "--corpus-cache") {
+                options.corpus_cache_file = value();
+            } else if (arg == "--output") {
+                options.output = value();
+            } else if (arg == "--output-file") {
+                options.output_file = value();
+            } else {
+                throw std::invalid_argument("Unknown argument: " + arg);
+            }
+        }
+
+        if (options.threads_set && options.mode == "standard") {
+            options.mode = "scaling";
+        }
+        if (options.mode != "standard" && options.mode != "scaling" &&
+            options.mode != "sweep" && options.mode != "working-set") {
+            throw std::invalid_argument("Unknown mode: " + options.mode);
+        }
+        if (options.output != "table" && options.output != "csv" && options.output != "json") {
+            throw std::invalid_argument("Unknown output format: " + options.output);
+        }
+        if (options.output == "table" && !options.output_file.empty()) {
+            throw std::invalid_argument("--output-file needs --output csv or json");
+        }
+        int sources = !options.crawl_root.empty() + !options.corpus_file.empty() + !options.corpus_cache_file.empty();
+        if (sources > 1) {
+            throw std::invalid_argument("Use at most one of --crawl, --corpus and --corpus-cache");
+        }
+
+        // An option the selected mode or input has no use for is an error
+        // rather than silently ignored
+        auto reject = [&](const std::vector<std::string>& names, const std::string& reason) {
+            for (const auto& name : names) {
+                if (given.count(name)) {
+                    throw std::invalid_argument(name + " " + reason);
+                }
+            }
+        };
+        if (options.crawl_root.empty()) {
+            reject({"--crawl-max-files", "--crawl-block-size", "--crawl-max-bytes"}, "needs --crawl");
+        }
+        if (sources > 0) {
+            reject({"--profile", "--seed", "--checksum", "--block-sizes", "--records"},
+                   "applies to generated inputs only");
+        }
+        std::string in_mode = "does not apply to --mode " + options.mode;
+        if (options.mode == "sweep" || options.mode == "working-set") {
+            reject({"--operation", "--size", "--records", "--profile", "--checksum", "--memcpy",
+                    "--crawl", "--corpus", "--corpus-cache"}, in_mode);
+        }
+        if (options.mode == "working-set") {
+            reject({"--batch-sizes"}, in_mode);
+            if (options.block_sizes_set && options.block_sizes.size() > 1) {
+                throw std::invalid_argument("--mode working-set takes a single --block-sizes value");
+            }
+        }
+        if (options.mode == "scaling") {
+            reject({"--records", "--batch-sizes", "--memcpy"}, in_mode);
+        } else {
+            reject({"--threads"}, in_mode);
+        }
+        return -1;
+    }
+
+    /**
+     * The records every selected format is benchmarked on
+     */
+    struct Inputs {
+        std::vector<FileMetadata> metadata;      // Single-record operations rotate through these
+        std::vector<FileMetadata> batch_source;  // Batches are prefixes of this
+        std::vector<std::pair<std::string, std::vector<FileBlock>>> blocks;  // Pools by size label
+        std::unique_ptr<CorpusCache> cache;      // Stored encodings, indexed like metadata and the one block pool
+    };
+
+    Inputs load_inputs(const CliOptions& options) {
+        Inputs inputs;
+        Corpus corpus;
+        std::string label = "corpus";
+        if (!options.corpus_cache_file.empty()) {
+            inputs.cache.reset(new CorpusCache(options.corpus_cache_file));
+            corpus = inputs.cache->corpus();
+        } else if (!options.corpus_file.empty()) {
+            corpus = load_corpus(options.corpus_file);
+        } else if (!options.crawl_root.empty()) {
+            FilesystemCrawler crawler(options.crawl);
+            corpus = crawler.crawl(options.crawl_root);
+            const CrawlStats& stats = crawler.stats();
+            std::cerr << "Crawled " << stats.files << " files in " << stats.directories
+                      << " directories (" << stats.skipped << " skipped)" << std::endl;
+            label = size_label(options.crawl.block_size);
+        } else {
+            TestDataGenerator generator(options.seed, options.profile);
+            generator.set_reference_time(CLI_REFERENCE_TIME);
+            size_t count = std::max(options.records,
+                                    *std::max_element(options.batch_sizes.begin(), options.batch_sizes.end()));
+            inputs.batch_source = generator.generate_metadata_batch(count);
+            inputs.metadata.assign(inputs.batch_source.begin(),
+                                   inputs.batch_source.begin() + static_cast<std::ptrdiff_t>(options.records));
+            for (size_t size : options.block_sizes) {
+                std::vector<FileBlock> pool;
+                for (size_t i = 0; i < options.records; ++i) {
+                    pool.push_back(generator.generate_block(size, i * size, options.checksum));
+                }
+                inputs.blocks.emplace_back(size_label(size), std::move(pool));
+            }
+            return inputs;
+        }
+
+        // Corpus blocks may differ in size, so they form one pool
+        if (corpus.metadata.empty()) {
+            throw std::runtime_error("The corpus has no metadata records");
+        }
+        inputs.metadata = corpus.metadata;
+        inputs.batch_source = corpus.metadata;
+        if (!corpus.blocks.empty()) {
+            inputs.blocks.emplace_back(label, std::move(corpus.blocks));
+        }
+        return inputs;
+    }
+
+    std::vector<std::vector<uint8_t>> metadata_encodings(SerializerInterface& serializer, const Inputs& inputs) {
+        std::string format = serializer.format_name();
+        bool cached = inputs.cache && inputs.cache->has_format(format);
+        std::vector<std::vector<uint8_t>> encoded;
+        for (size_t i = 0; i < inputs.metadata.size(); ++i) {
+            encoded.push_back(cached ? inputs.cache->metadata_encoding(format, i).to_vector()
+                                     : serializer.serialize_metadata(inputs.metadata[i]));
+        }
+        return encoded;
+    }
+
+    std::vector<std::vector<uint8_t>> block_encodings(SerializerInterface& serializer, const Inputs& inputs,
+                                                      const std::vector<FileBlock>& pool) {
+        std::string format = serializer.format_name();
+        bool cached = inputs.cache && inputs.cache->has_format(format);
+        std::vector<std::vector<uint8_t>> encoded;
+        for (size_t i = 0; i < pool.size(); ++i) {
+            encoded.push_back(cached ? inputs.cache->block_encoding(format, i).to_vector()
+                                     : serializer.serialize_block(pool[i]));
+        }
+        return encoded;
+    }
+
+    std::vector<BenchmarkResult> run_standard(const CliOptions& options, const Inputs& inputs,
+                                              const std::vector<std::unique_ptr<SerializerInterface>>& serializers) {
+        BenchmarkRunner runner(options.timing);
+        std::vector<BenchmarkResult> results;
+        auto selected = [&](const std::string& operation) { return matches_any(options.operations, operation); };
+
+        for (const auto& entry : serializers) {
+            SerializerInterface& serializer = *entry;
+            std::cerr << "Benchmarking " << serializer.format_name() << std::endl;
+
+            if (selected("metadata_serialization")) {
+                results.push_back(runner.benchmark_metadata_serialization_rotating(serializer, inputs.metadata));
+            }
+            if (selected("metadata_deserialization") || selected("metadata_field_read") ||
+                selected("metadata_all_fields_read")) {
+                std::vector<std::vector<uint8_t>> encoded = metadata_encodings(serializer, inputs);
+                if (selected("metadata_deserialization")) {
+                    results.push_back(runner.benchmark_metadata_deserialization_rotating(serializer, encoded));
+                }
+                if (selected("metadata_field_read")) {
+                    results.push_back(runner.benchmark_metadata_field_read(serializer, encoded.front()));
+                }
+                if (selected("metadata_all_fields_read")) {
+                    results.push_back(runner.benchmark_metadata_all_fields_read(serializer, encoded.front()));
+                }
+            }
+
+            for (size_t batch_size : options.batch_sizes) {
+                if (!matches_any(options.sizes, batch_label(batch_size))) {
+                    continue;
+                }
+                std::vector<FileMetadata> batch(inputs.batch_source.begin(),
+                                                inputs.batch_source.begin() + static_cast<std::ptrdiff_t>(batch_size));
+                const std::string label = batch_label(batch_size);
+                if (selected("metadata_batch_serialization")) {
+                    results.push_back(with_input_label(
+                        runner.benchmark_metadata_batch_serialization(serializer, batch), label));
+                }
+                if (selected("metadata_batch_deserialization")) {
+                    results.push_back(with_input_label(runner.benchmark_metadata_batch_deserialization(
+                        serializer, serializer.serialize_metadata_batch(batch)), label));
+                }
+            }
+
+            for (const auto& pool : inputs.blocks) {
+                if (!matches_any(options.sizes, pool.first)) {
+                    continue;
+                }
+                if (selected("block_serialization")) {
+                    results.push_back(with_input_label(
+                        runner.benchmark_block_serialization_rotating(serializer, pool.second), pool.first));
+                }
+                std::vector<std::vector<uint8_t>> encoded;
+                if (selected("block_deserialization")) {
+                    encoded = block_encodings(serializer, inputs, pool.second);
+                    results.push_back(with_input_label(
+                        runner.benchmark_block_deserialization_rotating(serializer, encoded), pool.first));
+                }
+                for (VerificationMode mode : {VerificationMode::Strict, VerificationMode::Deferred,
+                                              VerificationMode::Trusted}) {
+                    if (!selected(std::string("block_decode_") + verification_mode_name(mode))) {
+                        continue;
+                    }
+                    if (encoded.empty()) {
+                        encoded = block_encodings(serializer, inputs, pool.second);
+                    }
+                    results.push_back(with_input_label(
+                        runner.benchmark_block_decode(serializer, encoded.front(), mode), pool.first));
+                }
+            }
+        }
+
+        if (options.memcpy_baseline) {
+            runner.add_memcpy_baselines(results);
+        }
+        return results;
+    }
+
+    // Scaling runs take the first record of each input, as every thread repeats one call
+    std::vector<ScalingResult> run_scaling(const CliOptions& options, const Inputs& inputs,
+                                           const std::vector<SerializerFactory>& factories) {
+        BenchmarkRunner runner(options.timing);
+        std::vector<ScalingResult> results;
+        auto selected = [&](const std::string& operation) { return matches_any(options.operations, operation); };
+
+        for (const auto& factory : factories) {
+            std::unique_ptr<SerializerInterface> serializer = factory();
+            std::cerr << "Scaling " << serializer->format_name() << std::endl;
+
+            const FileMetadata& metadata = inputs.metadata.front();
+            if (selected("metadata_serialization")) {
+                results.push_back(runner.benchmark_metadata_serialization_scaling(factory, metadata, options.threads));
+            }
+            if (selected("metadata_deserialization")) {
+                results.push_back(runner.benchmark_metadata_deserialization_scaling(
+                    factory, serializer->serialize_metadata(metadata), options.threads));
+            }
+            for (const auto& pool : inputs.blocks) {
+                if (!matches_any(options.sizes, pool.first)) {
+                    continue;
+                }
+                const FileBlock& block = pool.second.front();
+                if (selected("block_serialization")) {
+                    results.push_back(with_input_label(
+                        runner.benchmark_block_serialization_scaling(factory, block, options.threads), pool.first));
+                }
+                if (selected("block_deserialization")) {
+                    results.push_back(with_input_label(runner.benchmark_block_deserialization_scaling(
+                        factory, serializer->serialize_block(block), options.threads), pool.first));
+                }
+            }
+        }
+        return results;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    CliOptions options;
+    try {
+        int exit_code = parse_arguments(argc, argv, options);
+        if (exit_code >= 0) {
+            return exit_code;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << "Run " << argv[0] << " --help for usage." << std::endl;
+        return 1;
+    }
+
+    try {
+        std::vector<SerializerFactory> factories;
+        std::vector<std::unique_ptr<SerializerInterface>> serializers;
+        for (const SerializerRegistration* registration :
+             SerializerRegistry::instance().with_capabilities(options.capabilities)) {
+            if (matches_any(options.formats, registration->key) ||
+                matches_any(options.formats, registration->format_name)) {
+                factories.push_back(registration->create);
+                serializers.push_back(registration->create());
+            }
+        }
+        if (serializers.empty()) {
+            std::cerr << "Error: No format matches --format and --capability; see --list-formats." << std::endl;
+            return 1;
+        }
+        std::vector<SerializerInterface*> raw_serializers;
+        for (const auto& serializer : serializers) {
+            raw_serializers.push_back(serializer.get());
+        }
+
+        bool table = options.output == "table";
+        std::ofstream file;
+        if (!options.output_file.empty()) {
+            file.open(options.output_file);
+            if (!file) {
+                throw std::runtime_error("Could not open " + options.output_file + " for writing");
+            }
+        }
+        std::ostream& out = options.output_file.empty() ? std::cout : file;
+        if (table) {
+            std::cout << "Serialization Format Benchmark" << std::endl;
+            std::cout << "==============================" << std::endl;
+        }
+
+        if (options.mode == "sweep") {
+            SweepOptions sweep;
+            sweep.timing = options.timing;
+            sweep.seed = options.seed;
+            if (options.block_sizes_set) {
+                sweep.block_sizes = options.block_sizes;
+            }
+            if (options.batch_sizes_set) {
+                sweep.batch_sizes = options.batch_sizes;
+            }
+            sweep.on_point = [](const SweepPoint& point) {
+                std::cerr << point.series << " " << point.result.format_name << " "
+                          << point.result.operation_name << std::endl;
+            };
+            std::vector<SweepPoint> points = ParameterSweep(sweep).run(raw_serializers);
+            std::cout.flush();
+            if (table) {
+                print_sweep_summary(points);
+            } else if (options.output == "csv") {
+                export_sweep_csv(points, out);
+            } else {
+                export_sweep_json(points, out);
+            }
+            return 0;
+        }
+
+        if (options.mode == "working-set") {
+            WorkingSetOptions working_set;
+            working_set.timing = options.timing;
+            working_set.seed = options.seed;
+            if (options.block_sizes_set) {
+                working_set.block_size = options.block_sizes.front();
+            }
+            std::vector<WorkingSetResult> results = run_working_set_benchmark(raw_serializers, working_set);
+            std::cout.flush();
+            if (table) {
+                print_working_set_results(results);
+            } else if (options.output == "csv") {
+                export_working_set_csv(results, out);
+            } else {
+                export_working_set_json(results, out);
+            }
+            return 0;
+        }
+
+        Inputs inputs = load_inputs(options);
+        if (table) {
+            std::cout << "Workload profile: " << options.profile.name << std::endl;
+            std::cout << "Inputs: " << inputs.metadata.size() << " metadata records, "
+                      << inputs.blocks.size() << " block pools" << std::endl;
+            std::cout << std::endl;
+        }
+        // Corpora may hold fewer records than a batch asks for
+        auto too_large = [&](size_t batch_size) {
+            if (batch_size <= inputs.batch_source.size()) {
+                return false;
+            }
+            std::cerr << "Skipping batches of " << batch_size << ": only "
+                      << inputs.batch_source.size() << " records" << std::endl;
+            return true;
+        };
+        options.batch_sizes.erase(std::remove_if(options.batch_sizes.begin(), options.batch_sizes.end(), too_large),
+                                  options.batch_sizes.end());
+
+        if (options.mode == "scaling") {
+            std::vector<ScalingResult> results = run_scaling(options, inputs, factories);
+            std::cout.flush();
+            if (table) {
+                BenchmarkRunner::print_scaling_results(results);
+            } else if (options.output == "csv") {
+                BenchmarkRunner::export_scaling_csv(results, out);
+            } else {
+                BenchmarkRunner::export_scaling_json(results, out);
+            }
+            return 0;
+        }
+
+        std::vector<BenchmarkResult> results = run_standard(options, inputs, serializers);
+        std::cout.flush();
+        if (table) {
+            BenchmarkRunner::print_results(results);
+        } else if (options.output == "csv") {
+            BenchmarkRunner::export_results_csv(results, out);
+        } else {
+            BenchmarkRunner::export_results_json(results, out);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
 
-int main() {
-    std::cout << "Serialization Format Benchmark" << std::endl;
-    std::cout << "==============================" << std::endl;
-    
-    // Create a sample FileMetadata object
-    benchmark::FileMetadata metadata;
-    metadata.name = "example.txt";
-    metadata.path = "/home/user/example.txt";
-    metadata.size = 1024;
-    metadata.created_at = std::time(nullptr);
-    metadata.last_modified = std::time(nullptr);
-    metadata.tags = {"document", "text"};
-    metadata.permissions = 0644;
-    metadata.owner = "user";
-    metadata.group = "users";
-    
-    std::cout << "Created sample metadata for file: " << metadata.name << std::endl;
-    std::cout << "Size: " << metadata.size << " bytes" << std::endl;
-    
     return 0;
-}
\ No newline at end of file
+}
@@ -1,8 +1,17 @@
 #include <iostream>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "common/allocation_tracker.h"
 #include "common/benchmark_runner.h"
 #include "common/test_data_generator.h"
+#include "common/working_set.h"
 
 // Mock serializer for testing
 class MockSerializer : public benchmark::SerializerInterface {
@@ -31,13 +40,408 @@ public:
     benchmark::FileBlock deserialize_block(const std::vector<uint8_t>& data) override {
         benchmark::FileBlock result;
         result.data = data;
+        result.checksum = benchmark::calculate_checksum(data);
         return result;
     }
 };
 
+void test_latency_histogram() {
+    benchmark::LatencyHistogram histogram;
+    assert(histogram.count() == 0 && histogram.value_at_percentile(50) == 0);
+    
+    // 1..100000 ns: every percentile lands within the 1/64 bucket resolution
+    for (uint64_t v = 1; v <= 100000; ++v) {
+        histogram.record(v);
+    }
+    assert(histogram.count() == 100000);
+    assert(histogram.min() == 1 && histogram.max() == 100000);
+    for (double p : {1.0, 50.0, 90.0, 99.0, 99.9}) {
+        double expected = p / 100.0 * 100000;
+        double actual = static_cast<double>(histogram.value_at_percentile(p));
+        assert(std::fabs(actual - expected) <= expected / 64 + 1);
+    }
+    assert(histogram.value_at_percentile(100) == 100000);
+    assert(std::fabs(histogram.mean() - 50000.5) < 1e-6);
+    assert(std::fabs(histogram.stddev() - 28867.66) < 0.1);
+    
+    // Small values are exact
+    benchmark::LatencyHistogram small;
+    for (uint64_t v : {3, 3, 7, 100}) {
+        small.record(v);
+    }
+    assert(small.value_at_percentile(50) == 3 && small.value_at_percentile(75) == 7);
+    
+    // Merging equals recording everything in one histogram
+    benchmark::LatencyHistogram merged = small;
+    merged.merge(histogram);
+    benchmark::LatencyHistogram direct = histogram;
+    for (uint64_t v : {3, 3, 7, 100}) {
+        direct.record(v);
+    }
+    assert(merged.count() == direct.count());
+    assert(merged.nonempty_buckets() == direct.nonempty_buckets());
+    assert(merged.value_at_percentile(99.9) == direct.value_at_percentile(99.9));
+    
+    std::cout << "Latency histogram test passed!" << std::endl;
+}
+
+void test_latency_summary() {
+    // 95 fast samples and 5 slow ones: the trimmed mean ignores the tail,
+    // the percentiles and max report it
+    std::vector<double> samples;
+    benchmark::LatencyHistogram histogram;
+    for (size_t i = 0; i < 100; ++i) {
+        double ms = i < 95 ? 1.0 + 0.001 * i : 50.0;
+        samples.push_back(ms);
+        histogram.record(static_cast<uint64_t>(ms * 1e6));
+    }
+    
+    benchmark::LatencyStats stats = benchmark::summarize_latencies(samples, histogram);
+    assert(stats.samples == 100);
+    assert(std::fabs(stats.trimmed_mean_ms - benchmark::trimmed_mean(samples)) < 1e-12);
+    assert(stats.trimmed_mean_ms < 1.1);
+    assert(stats.p50_ms < 1.1 && stats.p99_ms > 45.0 && stats.max_ms == 50.0);
+    assert(stats.min_ms <= stats.p50_ms && stats.p50_ms <= stats.p90_ms && stats.p90_ms <= stats.p99_ms &&
+           stats.p99_ms <= stats.p999_ms && stats.p999_ms <= stats.max_ms);
+    assert(stats.mean_ms > stats.trimmed_mean_ms && stats.stddev_ms > 5.0);
+    assert(stats.ci_low_ms <= stats.trimmed_mean_ms && stats.trimmed_mean_ms <= stats.ci_high_ms);
+    assert(stats.ci_high_ms - stats.ci_low_ms < 0.5);
+    
+    // The bootstrap is seeded, so the interval is repeatable
+    benchmark::LatencyStats again = benchmark::summarize_latencies(samples, histogram);
+    assert(again.ci_low_ms == stats.ci_low_ms && again.ci_high_ms == stats.ci_high_ms);
+    
+    std::cout << "Latency summary test passed!" << std::endl;
+}
+
+void test_throughput_accounting() {
+    benchmark::TestDataGenerator generator(7);
+    auto block = generator.generate_block(64 * 1024);
+    auto batch = generator.generate_metadata_batch(50);
+    MockSerializer serializer;
+    benchmark::BenchmarkRunner runner(20);
+    
+    // Decoding accounts the same logical bytes that encoding does
+    auto serialized_block = serializer.serialize_block(block);
+    auto encode = runner.benchmark_block_serialization(serializer, block);
+    auto decode = runner.benchmark_block_deserialization(serializer, serialized_block);
+    size_t decoded_logical = sizeof(block.offset) + block.data.size() + sizeof(block.checksum);
+    assert(decode.data_size_bytes == decoded_logical);
+    assert(encode.data_size_bytes == decoded_logical + block.block_id.size());
+    assert(decode.serialized_size_bytes == serialized_block.size());
+    
+    // Rates are derived from the headline duration
+    for (const auto& result : {encode, decode}) {
+        assert(result.records == 1 && result.duration_ms > 0.0);
+        assert(std::fabs(result.ops_per_sec * result.duration_ms - 1000.0) < 1e-6);
+        assert(std::fabs(result.wire_mb_per_sec -
+                         result.ops_per_sec * result.serialized_size_bytes / 1e6) < 1e-6);
+        assert(std::fabs(result.logical_mb_per_sec -
+                         result.ops_per_sec * result.data_size_bytes / 1e6) < 1e-6);
+    }
+    
+    // Batches count every record
+    auto batch_result = runner.benchmark_metadata_batch_serialization(serializer, batch);
+    assert(batch_result.records == 50);
+    assert(std::fabs(batch_result.records_per_sec - 50 * batch_result.ops_per_sec) < 1e-6);
+    
+    // One memcpy row per distinct wire size, and a fraction on every other row
+    std::vector<benchmark::BenchmarkResult> results = {encode, decode, batch_result};
+    runner.add_memcpy_baselines(results);
+    assert(results.size() == 5);
+    for (size_t i = 0; i < 3; ++i) {
+        assert(results[i].memcpy_fraction > 0.0);
+    }
+    for (size_t i = 3; i < 5; ++i) {
+        assert(results[i].format_name == "memcpy" && results[i].memcpy_fraction == 0.0);
+        assert(results[i].data_size_bytes == results[i].serialized_size_bytes);
+    }
+    assert(results[3].serialized_size_bytes == serialized_block.size());
+    assert(results[4].serialized_size_bytes == batch_result.serialized_size_bytes);
+    
+    std::cout << "Throughput accounting test passed!" << std::endl;
+}
+
+void test_batched_timing() {
+    size_t calls = 0;
+    auto count_call = [&calls]() { ++calls; };
+    
+    // A trivial operation is batched up to the minimum sample duration
+    benchmark::TimingOptions options;
+    options.samples = 20;
+    options.min_sample_ns = 50000;
+    benchmark::BenchmarkRunner runner(options);
+    auto batched = runner.benchmark_custom_operation("Mock", "increment", 0, 0, count_call);
+    assert(batched.batch_size > 1);
+    assert(batched.latency.samples == 20 && batched.histogram.count() == 20);
+    assert(calls >= 20 * batched.batch_size);
+    assert(batched.duration_ms * batched.batch_size * 1e6 >= 0.5 * options.min_sample_ns);
+    
+    // Per-call timing is the default, so percentiles describe single calls
+    assert(benchmark::TimingOptions().min_sample_ns == 0);
+    
+    // Without a minimum every call is timed on its own
+    options.min_sample_ns = 0;
+    runner.set_timing_options(options);
+    calls = 0;
+    auto single = runner.benchmark_custom_operation("Mock", "increment", 0, 0, count_call);
+    // Warm-up, 20 samples, and one untimed call for the allocation counts
+    assert(single.batch_size == 1 && calls == 21 + (benchmark::allocation_hooks_installed() ? 1 : 0));
+    
+    // A target error keeps sampling, up to max_samples
+    options.min_sample_ns = 20000;
+    options.samples = 5;
+    options.target_rse = 1e-12;
+    options.max_samples = 50;
+    runner.set_timing_options(options);
+    auto capped = runner.benchmark_custom_operation("Mock", "increment", 0, 0, count_call);
+    assert(capped.latency.samples == 50);
+    
+    options.target_rse = 0.05;
+    options.max_samples = 100000;
+    runner.set_timing_options(options);
+    auto targeted = runner.benchmark_custom_operation("Mock", "increment", 0, 0, count_call);
+    assert(targeted.latency.samples >= 5);
+    assert(targeted.relative_standard_error <= 0.05 || targeted.latency.samples == options.max_samples);
+    
+    // max_seconds bounds the run even without a target error
+    options.target_rse = 0.0;
+    options.samples = 100000;
+    options.max_seconds = 0.05;
+    runner.set_timing_options(options);
+    auto sleepy = runner.benchmark_custom_operation("Mock", "sleep", 0, 0, []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    assert(sleepy.latency.samples >= 1 && sleepy.latency.samples < 1000);
+    
+    std::cout << "Batched timing test passed!" << std::endl;
+}
+
+void test_scaling_mode() {
+    benchmark::TimingOptions options;
+    options.scaling_seconds = 0.05;
+    benchmark::BenchmarkRunner runner(options);
+    
+    benchmark::TestDataGenerator generator(11);
+    auto block = generator.generate_block(4096);
+    benchmark::SerializerFactory factory = []() {
+        return std::unique_ptr<benchmark::SerializerInterface>(new MockSerializer());
+    };
+    
+    auto result = runner.benchmark_block_serialization_scaling(factory, block, 4);
+    assert(result.format_name == "MockFormat" && result.operation_name == "block_serialization");
+    assert(result.serialized_size_bytes == block.data.size());
+    assert(result.points.size() == 3);
+    for (size_t i = 0; i < result.points.size(); ++i) {
+        const auto& point = result.points[i];
+        assert(point.threads == (size_t(1) << i));
+        assert(point.per_thread.size() == point.threads);
+        assert(point.operations > 0 && point.ops_per_sec > 0.0);
+        assert(std::fabs(point.efficiency - point.speedup / point.threads) < 1e-12);
+        assert(std::fabs(point.wire_mb_per_sec - point.ops_per_sec * block.data.size() / 1e6) < 1e-6);
+        assert(point.latency.p50_ms <= point.latency.max_ms);
+        for (const auto& thread : point.per_thread) {
+            assert(thread.samples > 0);
+        }
+    }
+    assert(result.points.front().speedup == 1.0);
+    
+    // Every worker records a sample even when the window closes at once
+    benchmark::TimingOptions instant = options;
+    instant.scaling_seconds = 0.0;
+    auto brief = benchmark::BenchmarkRunner(instant).benchmark_block_serialization_scaling(factory, block, 4);
+    for (const auto& point : brief.points) {
+        assert(point.operations >= point.threads);
+        for (const auto& thread : point.per_thread) {
+            assert(thread.samples > 0);
+        }
+    }
+    
+    // A non-power-of-two maximum is measured too
+    auto serialized = factory()->serialize_block(block);
+    auto odd = runner.benchmark_block_deserialization_scaling(factory, serialized, 3);
+    assert(odd.points.size() == 3 && odd.points.back().threads == 3);
+    
+    // Failures on worker threads reach the caller
+    bool threw = false;
+    try {
+        runner.benchmark_scaling(factory, "failing", 0, 0,
+            [](benchmark::SerializerInterface&) -> std::function<void()> {
+                return []() { throw std::runtime_error("worker failure"); };
+            }, 2);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    benchmark::BenchmarkRunner::print_scaling_results({result, odd});
+    std::cout << "Scaling mode test passed!" << std::endl;
+}
+
+void test_allocation_tracking() {
+    // This test links allocation_hooks.cpp
+    assert(benchmark::allocation_hooks_installed());
+    
+    {
+        benchmark::AllocationScope outer;
+        std::vector<uint8_t>* kept = new std::vector<uint8_t>(100000);
+        {
+            benchmark::AllocationScope inner;
+            std::vector<uint8_t> temporary(500000);
+            benchmark::AllocationStats stats = inner.stats();
+            assert(stats.allocations == 1 && stats.deallocations == 0);
+            assert(stats.bytes_allocated >= 500000 && stats.peak_live_bytes >= 500000);
+        }
+        delete kept;
+        benchmark::AllocationStats stats = outer.stats();
+        assert(stats.allocations == 3 && stats.deallocations == 3);
+        assert(stats.bytes_allocated >= 600000);
+        // Both vectors were live together inside the inner scope
+        assert(stats.peak_live_bytes >= 600000 && stats.peak_live_bytes < stats.bytes_allocated + 1);
+    }
+    
+    // CountingAllocator containers are counted once, not again by the hooks
+    {
+        benchmark::AllocationScope scope;
+        std::vector<int, benchmark::CountingAllocator<int>> values(1000);
+        assert(scope.stats().allocations == 1);
+    }
+    
+    // Every benchmark result carries the heap activity of one call
+    MockSerializer serializer;
+    benchmark::TestDataGenerator generator(5);
+    auto metadata = generator.generate_metadata();
+    benchmark::BenchmarkRunner runner(5);
+    auto encode = runner.benchmark_metadata_serialization(serializer, metadata);
+    assert(encode.allocations_measured);
+    assert(encode.allocations_per_op == 1 && encode.bytes_allocated_per_op >= metadata.name.size());
+    assert(encode.peak_live_bytes == encode.bytes_allocated_per_op);
+    
+    auto copy = runner.benchmark_memcpy_baseline(4096);
+    assert(copy.allocations_measured && copy.allocations_per_op == 0);
+    
+    std::cout << "Allocation tracking test passed!" << std::endl;
+}
+
+void test_perf_counters() {
+    // Counters may be refused here (paranoid setting, container, VM without a
+    // PMU); either way nothing throws and unmeasured counters stay unset
+    benchmark::PerfCounterGroup group;
+    group.start();
+    volatile uint64_t sink = 0;
+    for (uint64_t i = 0; i < 1000000; ++i) {
+        sink = sink + i;
+    }
+    group.stop();
+    benchmark::PerfCounterValues values = group.read(1000000);
+    if (!group.available()) {
+        assert(!values.any());
+    }
+    if (values.has(benchmark::PerfCounter::Instructions)) {
+        assert(values.get(benchmark::PerfCounter::Instructions) >= 1.0);
+    }
+    assert(group.read(0).any() == false);
+    
+    benchmark::TimingOptions options;
+    options.samples = 10;
+    options.hardware_counters = true;
+    benchmark::BenchmarkRunner runner(options);
+    MockSerializer serializer;
+    benchmark::TestDataGenerator generator(3);
+    auto result = runner.benchmark_block_serialization(serializer, generator.generate_block(4096));
+    for (size_t i = 0; i < benchmark::PERF_COUNTER_COUNT; ++i) {
+        assert(result.counters.per_op[i] >= 0.0);
+        assert(result.counters.measured[i] || result.counters.per_op[i] == 0.0);
+    }
+    std::cout << "Perf counters " << (result.counters.any() ? "measured" : "unavailable") << std::endl;
+    benchmark::BenchmarkRunner::print_counter_results({result});
+    
+    std::cout << "Perf counter test passed!" << std::endl;
+}
+
+void test_working_sets() {
+    MockSerializer serializer;
+    benchmark::BenchmarkRunner runner(8);
+    
+    // Rotation reports per-call averages over the pool
+    std::vector<benchmark::FileMetadata> pool(3);
+    pool[0].name = "abcd";
+    pool[1].name = "abcdefgh";
+    pool[2].name = "abcdefghijkl";
+    auto rotating = runner.benchmark_metadata_serialization_rotating(serializer, pool);
+    assert(rotating.serialized_size_bytes == 8 && rotating.operation_name == "metadata_serialization");
+    std::vector<std::vector<uint8_t>> encoded;
+    for (const auto& metadata : pool) {
+        encoded.push_back(serializer.serialize_metadata(metadata));
+    }
+    auto decoded = runner.benchmark_metadata_deserialization_rotating(serializer, encoded);
+    assert(decoded.serialized_size_bytes == 8 && decoded.data_size_bytes > 8);
+    
+    bool threw = false;
+    try {
+        runner.benchmark_block_serialization_rotating(serializer, {});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Flushing times every call on its own
+    benchmark::TimingOptions flushed;
+    flushed.samples = 3;
+    flushed.flush_cache = true;
+    auto cold = benchmark::BenchmarkRunner(flushed).benchmark_metadata_serialization(serializer, pool[0]);
+    assert(cold.batch_size == 1 && cold.latency.samples == 3);
+    
+    benchmark::CacheSizes caches;
+    caches.l1d = 32 * 1024;
+    caches.l2 = 1024 * 1024;
+    caches.llc = 32 * 1024 * 1024;
+    assert((benchmark::default_working_sets(caches, size_t(256) << 20) ==
+            std::vector<size_t>{16 * 1024, 512 * 1024, 16 << 20, 128 << 20}));
+    assert((benchmark::default_working_sets(caches, 8 << 20) ==
+            std::vector<size_t>{16 * 1024, 512 * 1024, 8 << 20}));
+    benchmark::CacheSizes detected = benchmark::detect_cache_sizes();
+    assert(detected.l1d > 0 && detected.l2 >= detected.l1d && detected.llc >= detected.l2);
+    
+    benchmark::WorkingSetOptions options;
+    options.working_set_bytes = {4096, 64 * 1024};
+    options.block_size = 1024;
+    options.timing.samples = 5;
+    options.flushed_samples = 3;
+    auto results = benchmark::run_working_set_benchmark({&serializer}, options);
+    // Four operations, each hot, two working sets and flushed
+    assert(results.size() == 16);
+    for (size_t op = 0; op < 4; ++op) {
+        const auto& hot = results[op * 4];
+        const auto& small = results[op * 4 + 1];
+        const auto& large = results[op * 4 + 2];
+        const auto& flushed_result = results[op * 4 + 3];
+        assert(hot.mode == "hot" && hot.pool_size == 1 && hot.slowdown == 1.0);
+        assert(small.mode == "working_set" && small.working_set_bytes >= 4096);
+        assert(large.pool_size > small.pool_size);
+        // The mock encodes only the name, so the metadata pool runs out before
+        // 64 KiB of encodings; the reported working set is what was reached
+        assert(large.working_set_bytes >= 64 * 1024 || op == 1);
+        assert(flushed_result.mode == "flushed" && flushed_result.result.batch_size == 1);
+        assert(small.result.operation_name == hot.result.operation_name);
+    }
+    benchmark::print_working_set_results(results);
+    
+    std::cout << "Working set test passed!" << std::endl;
+}
+
 int main() {
     std::cout << "Running benchmark runner tests..." << std::endl;
     
+    test_latency_histogram();
+    test_latency_summary();
+    test_throughput_accounting();
+    test_batched_timing();
+    test_scaling_mode();
+    test_allocation_tracking();
+    test_perf_counters();
+    test_working_sets();
+    
     // Create test data
     benchmark::TestDataGenerator generator;
     auto metadata = generator.generate_metadata();
@@ -67,6 +471,7 @@ int main() {
     assert(metadata_deser_result.format_name == "MockFormat");
     assert(metadata_deser_result.operation_name == "metadata_deserialization");
     assert(metadata_deser_result.duration_ms >= 0.0);
+    assert(metadata_deser_result.data_size_bytes > metadata.name.size());  // The mock keeps only the name
     
     assert(block_ser_result.format_name == "MockFormat");
     assert(block_ser_result.operation_name == "block_serialization");
@@ -77,6 +482,13 @@ int main() {
     assert(block_deser_result.operation_name == "block_deserialization");
     assert(block_deser_result.duration_ms >= 0.0);
     
+    // Every timed iteration lands in the histogram and the summary
+    assert(block_ser_result.histogram.count() == 10);
+    assert(block_ser_result.latency.samples == 10);
+    assert(block_ser_result.latency.min_ms <= block_ser_result.latency.p50_ms);
+    assert(block_ser_result.latency.p50_ms <= block_ser_result.latency.max_ms);
+    assert(block_ser_result.latency.ci_low_ms <= block_ser_result.latency.ci_high_ms);
+    
     // Print results
     std::vector<benchmark::BenchmarkResult> results = {
         metadata_ser_result,
@@ -85,10 +497,38 @@ int main() {
         block_deser_result
     };
     
+    // Cost of each verification policy
+    for (auto mode : {benchmark::VerificationMode::Strict,
+                      benchmark::VerificationMode::Deferred,
+                      benchmark::VerificationMode::Trusted}) {
+        auto decode_result = runner.benchmark_block_decode(serializer, serialized_block, mode);
+        assert(decode_result.operation_name ==
+               std::string("block_decode_") + benchmark::verification_mode_name(mode));
+        assert(decode_result.duration_ms >= 0.0);
+        results.push_back(decode_result);
+    }
+    
+    runner.add_memcpy_baselines(results);
     benchmark::BenchmarkRunner::print_results(results);
     
     // Test CSV export
     benchmark::BenchmarkRunner::export_results_csv(results, "test_results.csv");
+    {
+        std::ifstream csv("test_results.csv");
+        std::string header;
+        std::getline(csv, header);
+        assert(header.find("P99Ms") != std::string::npos && header.find("CiHighMs") != std::string::npos);
+        assert(header.find("WireMBps") != std::string::npos);
+        assert(header.find("BatchSize,PercentileBasis") != std::string::npos);
+    }
+    benchmark::BenchmarkRunner::export_results_json(results, "test_results.json");
+    {
+        std::ifstream json("test_results.json");
+        std::string contents((std::istreambuf_iterator<char>(json)), std::istreambuf_iterator<char>());
+        assert(contents.front() == '[' && contents.find("\"operation\": \"block_decode_strict\"") != std::string::npos);
+        assert(contents.find("\"format\": \"memcpy\"") != std::string::npos);
+    }
+    benchmark::BenchmarkRunner::export_histograms_csv(results, "test_histograms.csv");
     
     std::cout << "All tests passed!" << std::endl;
     std::cout << "Results exported to test_results.csv" << std::endl;
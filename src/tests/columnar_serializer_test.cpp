@@ -0,0 +1,152 @@
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include "formats/columnar/columnar_serializer.h"
+#include "formats/packed/packed_serializer.h"
+#include "formats/tagless/tagless_serializer.h"
+#include "common/benchmark_runner.h"
+#include "common/test_data_generator.h"
+
+using namespace benchmark;
+
+void test_metadata_serialization_deserialization() {
+    ColumnarSerializer serializer;
+    TestDataGenerator generator;
+
+    // Generate a sample metadata
+    FileMetadata original = generator.generate_metadata();
+
+    // Serialize
+    std::vector<uint8_t> serialized = serializer.serialize_metadata(original);
+
+    // Print info about the serialized data
+    std::cout << "Serialized metadata to " << serialized.size() << " bytes (Columnar)" << std::endl;
+
+    // Deserialize
+    FileMetadata deserialized = serializer.deserialize_metadata(serialized);
+
+    // Verify that the deserialized object equals the original
+    assert(deserialized.name == original.name);
+    assert(deserialized.path == original.path);
+    assert(deserialized.size == original.size);
+    assert(deserialized.created_at == original.created_at);
+    assert(deserialized.last_modified == original.last_modified);
+    assert(deserialized.tags == original.tags);
+    assert(deserialized.permissions == original.permissions);
+    assert(deserialized.owner == original.owner);
+    assert(deserialized.group == original.group);
+
+    std::cout << "Metadata serialization/deserialization test passed!" << std::endl;
+}
+
+void test_block_serialization_deserialization() {
+    ColumnarSerializer serializer;
+    TestDataGenerator generator;
+
+    // Generate sample blocks of different sizes
+    std::vector<size_t> sizes = {0, 64, 1024, 4096};
+
+    for (size_t size : sizes) {
+        FileBlock original = generator.generate_block(size);
+        std::vector<uint8_t> serialized = serializer.serialize_block(original);
+        FileBlock deserialized = serializer.deserialize_block(serialized);
+        assert(deserialized == original);
+    }
+
+    std::cout << "Block serialization/deserialization test passed!" << std::endl;
+}
+
+void test_batch_round_trip() {
+    ColumnarSerializer serializer;
+    TestDataGenerator generator(42);
+
+    // Unsorted input keeps its record order through the permutation column
+    std::vector<FileMetadata> batch = generator.generate_metadata_batch(1000);
+    assert(serializer.deserialize_metadata_batch(serializer.serialize_metadata_batch(batch)) == batch);
+
+    // Sorted input needs no permutation and shares path prefixes
+    std::vector<FileMetadata> sorted = batch;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const FileMetadata& a, const FileMetadata& b) { return a.path < b.path; });
+    std::vector<uint8_t> sorted_data = serializer.serialize_metadata_batch(sorted);
+    assert(serializer.deserialize_metadata_batch(sorted_data) == sorted);
+    assert(sorted_data.size() < serializer.serialize_metadata_batch(batch).size());
+
+    // Names that are not the basename, duplicate paths, empty strings, negative times
+    std::vector<FileMetadata> odd(4);
+    odd[0].name = "renamed.txt";
+    odd[0].path = "/a/b/original.txt";
+    odd[1].name = "x";
+    odd[1].path = "/a/b/original.txt";
+    odd[1].created_at = -5;
+    odd[2].name = "";
+    odd[2].path = "";
+    odd[2].owner = "";
+    odd[3].name = "a/b";
+    odd[3].path = "/c/a/b";
+    odd[3].tags = {"", "root", "root"};
+    assert(serializer.deserialize_metadata_batch(serializer.serialize_metadata_batch(odd)) == odd);
+
+    // Empty batch
+    std::vector<FileMetadata> empty;
+    assert(serializer.deserialize_metadata_batch(serializer.serialize_metadata_batch(empty)).empty());
+
+    // Truncated batch
+    std::vector<uint8_t> truncated = serializer.serialize_metadata_batch(batch);
+    truncated.resize(truncated.size() / 2);
+    bool threw = false;
+    try {
+        serializer.deserialize_metadata_batch(truncated);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Batch round trip test passed!" << std::endl;
+}
+
+void benchmark_against_row_formats(const std::vector<size_t>& batch_sizes) {
+    std::vector<std::unique_ptr<SerializerInterface>> serializers;
+    serializers.emplace_back(new ColumnarSerializer());
+    serializers.emplace_back(new TaglessSerializer());
+    serializers.emplace_back(new PackedSerializer());
+
+    BenchmarkRunner runner(5);
+    std::vector<BenchmarkResult> results;
+
+    for (size_t batch_size : batch_sizes) {
+        TestDataGenerator generator(42);
+        std::vector<FileMetadata> batch = generator.generate_metadata_batch(batch_size);
+
+        for (auto& serializer : serializers) {
+            std::vector<uint8_t> serialized = serializer->serialize_metadata_batch(batch);
+            assert(serializer->deserialize_metadata_batch(serialized) == batch);
+
+            results.push_back(runner.benchmark_metadata_batch_serialization(*serializer, batch));
+            results.push_back(runner.benchmark_metadata_batch_deserialization(*serializer, serialized));
+        }
+    }
+
+    BenchmarkRunner::print_results(results);
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "Running Columnar serializer tests..." << std::endl;
+
+    test_metadata_serialization_deserialization();
+    test_block_serialization_deserialization();
+    test_batch_round_trip();
+
+    // Pass a record count to extend the comparison (e.g. 1000000)
+    std::vector<size_t> batch_sizes = {1000, 10000, 100000};
+    if (argc > 1) {
+        batch_sizes.push_back(std::strtoull(argv[1], nullptr, 10));
+    }
+    benchmark_against_row_formats(batch_sizes);
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include <iostream>
+#include <iomanip>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "common/corpus_cache.h"
+#include "common/test_data_generator.h"
+#include "formats/flat/flat_serializer.h"
+#include "formats/packed/packed_serializer.h"
+#include "formats/tagless/tagless_serializer.h"
+
+using namespace benchmark;
+
+namespace {
+    Corpus make_corpus(size_t records, size_t blocks, size_t block_size) {
+        WorkloadProfile profile;
+        find_workload_profile("production", profile);
+        TestDataGenerator generator(17, profile);
+        generator.set_reference_time(1700000000);
+
+        Corpus corpus;
+        corpus.metadata = generator.generate_metadata_batch(records);
+        corpus.blocks = generator.generate_block_batch(std::vector<size_t>(blocks, block_size));
+        return corpus;
+    }
+
+    std::string temp_path(const char* name) {
+        return std::string("/tmp/corpus_cache_test_") + name;
+    }
+}
+
+void test_cache_round_trip() {
+    Corpus corpus = make_corpus(200, 20, 10000);
+    FlatSerializer flat;
+    PackedSerializer packed;
+    TaglessSerializer tagless;
+    std::vector<SerializerInterface*> serializers = {&flat, &packed, &tagless};
+
+    std::string path = temp_path("round_trip.cache");
+    CorpusCache::write(path, corpus, serializers);
+
+    CorpusCache cache(path);
+    assert(cache.metadata_count() == 200 && cache.block_count() == 20);
+    assert(cache.corpus() == corpus);
+    assert(cache.verify());
+    assert((cache.formats() == std::vector<std::string>{"Flat", "PackedPOD", "Tagless"}));
+    assert(!cache.has_format("JSON"));
+
+    // Every stored encoding is what the serializer produces now, aligned, and decodes back
+    for (SerializerInterface* serializer : serializers) {
+        std::string format = serializer->format_name();
+        for (size_t i = 0; i < corpus.metadata.size(); ++i) {
+            ByteView view = cache.metadata_encoding(format, i);
+            assert(reinterpret_cast<uintptr_t>(view.data) % 8 == 0);
+            assert(view.to_vector() == serializer->serialize_metadata(corpus.metadata[i]));
+            assert(serializer->deserialize_metadata(view.to_vector()) == corpus.metadata[i]);
+        }
+        for (size_t i = 0; i < corpus.blocks.size(); ++i) {
+            ByteView view = cache.block_encoding(format, i);
+            assert(view.to_vector() == serializer->serialize_block(corpus.blocks[i]));
+            assert(serializer->deserialize_block(view.to_vector()) == corpus.blocks[i]);
+        }
+    }
+
+    // Flat readers work directly on the mapping
+    ByteView flat_view = cache.metadata_encoding("Flat", 5);
+    FlatMetadataReader reader(flat_view.data, flat_view.size);
+    assert(reader.path() == corpus.metadata[5].path);
+
+    bool threw = false;
+    try {
+        cache.metadata_encoding("JSON", 0);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        cache.block_encoding("Flat", 20);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // The same corpus written again has the same fingerprint
+    std::string second = temp_path("second.cache");
+    CorpusCache::write(second, make_corpus(200, 20, 10000), {&packed});
+    assert(CorpusCache(second).fingerprint() == cache.fingerprint());
+
+    std::remove(path.c_str());
+    std::remove(second.c_str());
+    std::cout << "Corpus cache round trip test passed!" << std::endl;
+}
+
+void test_cache_corruption() {
+    Corpus corpus = make_corpus(50, 4, 4096);
+    PackedSerializer packed;
+    std::string path = temp_path("corrupt.cache");
+    CorpusCache::write(path, corpus, {&packed});
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // A flipped payload byte opens fine but fails verification
+    bytes[bytes.size() - 100] ^= 0x01;
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    assert(!CorpusCache(path).verify());
+
+    // Truncation and a bad magic are rejected at open
+    for (size_t keep : {size_t(10), size_t(200), bytes.size() / 2}) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(keep));
+        out.close();
+        bool threw = false;
+        try {
+            CorpusCache cache(path);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    bytes[0] = 'X';
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    bool threw = false;
+    try {
+        CorpusCache cache(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::remove(path.c_str());
+    std::cout << "Corpus cache corruption test passed!" << std::endl;
+}
+
+void benchmark_startup() {
+    const size_t RECORDS = 100000;
+    const size_t BLOCKS = 256;
+    const size_t BLOCK_SIZE = 256 * 1024;
+    FlatSerializer flat;
+    PackedSerializer packed;
+    TaglessSerializer tagless;
+    std::vector<SerializerInterface*> serializers = {&flat, &packed, &tagless};
+    std::string path = temp_path("startup.cache");
+
+    auto seconds_since = [](std::chrono::high_resolution_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    };
+
+    // Regenerating inputs: generate the corpus and serialize it with every format
+    auto start = std::chrono::high_resolution_clock::now();
+    Corpus corpus = make_corpus(RECORDS, BLOCKS, BLOCK_SIZE);
+    size_t encoded_bytes = 0;
+    for (SerializerInterface* serializer : serializers) {
+        for (const auto& metadata : corpus.metadata) {
+            encoded_bytes += serializer->serialize_metadata(metadata).size();
+        }
+        for (const auto& block : corpus.blocks) {
+            encoded_bytes += serializer->serialize_block(block).size();
+        }
+    }
+    double regenerate = seconds_since(start);
+
+    CorpusCache::write(path, corpus, serializers);
+
+    // Opening the cache, then touching the first encoding of each format
+    start = std::chrono::high_resolution_clock::now();
+    {
+        CorpusCache cache(path);
+        for (SerializerInterface* serializer : serializers) {
+            volatile uint8_t first_byte = cache.metadata_encoding(serializer->format_name(), 0).data[0];
+            (void)first_byte;
+        }
+        double open = seconds_since(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        bool ok = cache.verify();
+        double verify = seconds_since(start);
+        assert(ok);
+
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(36) << "Startup path" << "ms" << std::endl;
+        std::cout << std::string(44, '-') << std::endl;
+        std::cout << std::setw(36) << "generate + serialize 3 formats" << regenerate * 1e3 << std::endl;
+        std::cout << std::setw(36) << "map cache + first access" << open * 1e3 << std::endl;
+        std::cout << std::setw(36) << "verify (rehash whole file)" << verify * 1e3 << std::endl;
+        std::cout << "Cache file: " << cache.file_size() / (1024 * 1024) << " MiB, encodings "
+                  << encoded_bytes / (1024 * 1024) << " MiB" << std::endl;
+    }
+
+    std::remove(path.c_str());
+}
+
+int main() {
+    std::cout << "Running corpus cache tests..." << std::endl;
+
+    test_cache_round_trip();
+    test_cache_corruption();
+    benchmark_startup();
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
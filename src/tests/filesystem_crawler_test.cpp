@@ -0,0 +1,250 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "common/filesystem_crawler.h"
+#include "common/corpus.h"
+#include "common/test_data_generator.h"
+
+using namespace benchmark;
+
+namespace {
+    std::string make_temp_dir() {
+        char pattern[] = "/tmp/crawler_test_XXXXXX";
+        char* dir = mkdtemp(pattern);
+        assert(dir != nullptr);
+        return dir;
+    }
+
+    void write_file(const std::string& path, size_t size, uint8_t seed) {
+        std::ofstream file(path, std::ios::binary);
+        for (size_t i = 0; i < size; ++i) {
+            file.put(static_cast<char>(seed + i * 31));
+        }
+    }
+
+    std::vector<uint8_t> read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    void remove_tree(const std::string& root) {
+        std::string command = "rm -rf '" + root + "'";
+        int status = std::system(command.c_str());
+        (void)status;
+    }
+
+    // root/a.txt, root/b/c.LOG, root/b/d/e (empty), root/b/d/f/g.bin, a symlink and a fifo
+    std::vector<std::string> build_tree(const std::string& root) {
+        mkdir((root + "/b").c_str(), 0755);
+        mkdir((root + "/b/d").c_str(), 0700);
+        mkdir((root + "/b/d/f").c_str(), 0755);
+        write_file(root + "/a.txt", 1000, 1);
+        write_file(root + "/b/c.LOG", 70000, 2);
+        write_file(root + "/b/d/e", 0, 3);
+        write_file(root + "/b/d/f/g.bin", 12345, 4);
+        chmod((root + "/b/d/f/g.bin").c_str(), 0640);
+        int link_status = symlink("../a.txt", (root + "/b/link.txt").c_str());
+        assert(link_status == 0);
+        mkfifo((root + "/b/pipe").c_str(), 0600);
+        return {root + "/a.txt", root + "/b/c.LOG", root + "/b/d/e", root + "/b/d/f/g.bin"};
+    }
+}
+
+void test_crawl_metadata() {
+    std::string root = make_temp_dir();
+    std::vector<std::string> files = build_tree(root);
+
+    FilesystemCrawler crawler;
+    Corpus corpus = crawler.crawl(root + "/");
+    assert(corpus.metadata.size() == files.size());
+    assert(corpus.blocks.empty());
+    assert(crawler.stats().files == files.size());
+    assert(crawler.stats().directories == 4);
+
+    // Sorted by path; symlinks and fifos are not files
+    for (size_t i = 0; i < files.size(); ++i) {
+        const FileMetadata& metadata = corpus.metadata[i];
+        assert(metadata.path == files[i]);
+        struct stat st;
+        assert(stat(files[i].c_str(), &st) == 0);
+        assert(metadata.size == static_cast<uint64_t>(st.st_size));
+        assert(metadata.last_modified == st.st_mtime);
+        assert(metadata.permissions == (st.st_mode & 07777));
+        assert(!metadata.owner.empty() && !metadata.group.empty());
+    }
+    assert(corpus.metadata[0].name == "a.txt");
+    assert(corpus.metadata[1].tags == std::vector<std::string>{"log"});
+    assert(corpus.metadata[2].tags.empty());
+    assert(corpus.metadata[3].permissions == 0640);
+
+    // Same records for any thread count
+    for (unsigned threads : {1u, 2u, 7u}) {
+        CrawlOptions options;
+        options.threads = threads;
+        assert(FilesystemCrawler(options).crawl(root) == corpus);
+    }
+
+    // A symlinked root is followed; records keep the path as given
+    std::string link = root + "-link";
+    int link_status = symlink(root.c_str(), link.c_str());
+    assert(link_status == 0);
+    Corpus linked = crawler.crawl(link);
+    assert(linked.metadata.size() == files.size());
+    assert(linked.metadata[0].path == link + "/a.txt");
+    unlink(link.c_str());
+
+    CrawlOptions limited;
+    limited.max_files = 2;
+    assert(FilesystemCrawler(limited).crawl(root).metadata.size() == 2);
+
+    bool threw = false;
+    try {
+        crawler.crawl(root + "/missing");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    remove_tree(root);
+    std::cout << "Crawl metadata test passed!" << std::endl;
+}
+
+void test_crawl_blocks() {
+    std::string root = make_temp_dir();
+    std::vector<std::string> files = build_tree(root);
+
+    CrawlOptions options;
+    options.block_size = 4096;
+    options.checksum_algorithm = ChecksumAlgorithm::Crc32c;
+    FilesystemCrawler crawler(options);
+    Corpus corpus = crawler.crawl(root);
+
+    // Blocks follow file order, and concatenate back to each file
+    size_t block = 0;
+    uint64_t total = 0;
+    for (const auto& path : files) {
+        std::vector<uint8_t> expected = read_file(path);
+        std::vector<uint8_t> joined;
+        std::string prefix;
+        while (joined.size() < expected.size()) {
+            const FileBlock& b = corpus.blocks[block++];
+            assert(b.offset == joined.size());
+            assert(b.data.size() <= options.block_size);
+            assert(b.checksum_algorithm == ChecksumAlgorithm::Crc32c && b.validate_checksum());
+            std::string id_prefix = b.block_id.substr(0, b.block_id.find('-'));
+            assert(prefix.empty() || prefix == id_prefix);
+            prefix = id_prefix;
+            joined.insert(joined.end(), b.data.begin(), b.data.end());
+        }
+        assert(joined == expected);
+        total += expected.size();
+    }
+    assert(block == corpus.blocks.size());
+    assert(crawler.stats().bytes_read == total);
+    assert(crawler.stats().skipped == 0);
+
+    // Files are reopened below the root fd, whatever the spelling of the root
+    // or the number of readers
+    for (unsigned threads : {1u, 7u}) {
+        CrawlOptions reread = options;
+        reread.threads = threads;
+        assert(FilesystemCrawler(reread).crawl(root + "/").blocks == corpus.blocks);
+    }
+
+    // The byte cap is applied in path order
+    options.max_block_bytes = 1500;
+    Corpus capped = FilesystemCrawler(options).crawl(root);
+    assert(capped.blocks.size() == 2);
+    assert(capped.blocks[0].data.size() == 1000 && capped.blocks[1].data.size() == 500);
+
+    remove_tree(root);
+    std::cout << "Crawl blocks test passed!" << std::endl;
+}
+
+void test_corpus_round_trip() {
+    TestDataGenerator generator(21);
+    Corpus corpus;
+    corpus.metadata = generator.generate_metadata_batch(100);
+    corpus.blocks = generator.generate_block_batch({0, 1, 4096, 70000});
+    corpus.blocks[2].checksum_algorithm = ChecksumAlgorithm::XxHash64;
+
+    std::string dir = make_temp_dir();
+    std::string path = dir + "/corpus.bin";
+    save_corpus(corpus, path);
+    assert(load_corpus(path) == corpus);
+
+    std::vector<uint8_t> encoded = encode_corpus(corpus);
+    for (size_t cut : {size_t(0), size_t(3), encoded.size() / 2, encoded.size() - 1}) {
+        bool threw = false;
+        try {
+            decode_corpus(std::vector<uint8_t>(encoded.begin(), encoded.begin() + cut));
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // An algorithm byte no enumerator has is a decode error. The two
+    // encodings differ only in that byte, which locates it.
+    Corpus single;
+    single.blocks = {corpus.blocks[2]};
+    std::vector<uint8_t> xxhash = encode_corpus(single);
+    single.blocks[0].checksum_algorithm = ChecksumAlgorithm::Adler32;
+    std::vector<uint8_t> adler = encode_corpus(single);
+    auto differs = std::mismatch(adler.begin(), adler.end(), xxhash.begin()).first;
+    assert(differs != adler.end());
+    *differs = 0x7F;
+    bool threw = false;
+    try {
+        decode_corpus(adler);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    remove_tree(dir);
+    std::cout << "Corpus round trip test passed!" << std::endl;
+}
+
+void benchmark_crawl() {
+    const char* root = "/usr";
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << std::left << std::fixed << std::setprecision(0)
+              << std::setw(10) << "Threads" << std::setw(12) << "Files"
+              << std::setw(12) << "Dirs" << "Files/s" << std::endl;
+    std::cout << std::string(46, '-') << std::endl;
+    for (unsigned threads : {1u, 2u, 4u, cores}) {
+        CrawlOptions options;
+        options.threads = threads;
+        FilesystemCrawler crawler(options);
+        auto start = std::chrono::high_resolution_clock::now();
+        crawler.crawl(root);
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << std::setw(10) << threads << std::setw(12) << crawler.stats().files
+                  << std::setw(12) << crawler.stats().directories
+                  << crawler.stats().files / seconds << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "Running filesystem crawler tests..." << std::endl;
+
+    test_crawl_metadata();
+    test_crawl_blocks();
+    test_corpus_round_trip();
+    benchmark_crawl();
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <stdexcept>
+#include "formats/flat/flat_serializer.h"
+#include "common/benchmark_runner.h"
+#include "common/test_data_generator.h"
+
+using namespace benchmark;
+
+void test_metadata_serialization_deserialization() {
+    FlatSerializer serializer;
+    TestDataGenerator generator;
+
+    // Generate a sample metadata
+    FileMetadata original = generator.generate_metadata();
+
+    // Serialize
+    std::vector<uint8_t> serialized = serializer.serialize_metadata(original);
+
+    // Print info about the serialized data
+    std::cout << "Serialized metadata to " << serialized.size() << " bytes (Flat)" << std::endl;
+
+    // Deserialize
+    FileMetadata deserialized = serializer.deserialize_metadata(serialized);
+
+    // Verify that the deserialized object equals the original
+    assert(deserialized.name == original.name);
+    assert(deserialized.path == original.path);
+    assert(deserialized.size == original.size);
+    assert(deserialized.created_at == original.created_at);
+    assert(deserialized.last_modified == original.last_modified);
+    assert(deserialized.tags == original.tags);
+    assert(deserialized.permissions == original.permissions);
+    assert(deserialized.owner == original.owner);
+    assert(deserialized.group == original.group);
+
+    std::cout << "Metadata serialization/deserialization test passed!" << std::endl;
+}
+
+void test_block_serialization_deserialization() {
+    FlatSerializer serializer;
+    TestDataGenerator generator;
+
+    // Generate sample blocks of different sizes
+    std::vector<size_t> sizes = {0, 64, 1024, 4096};
+
+    for (size_t size : sizes) {
+        // Generate a sample block
+        FileBlock original = generator.generate_block(size);
+
+        // Serialize
+        std::vector<uint8_t> serialized = serializer.serialize_block(original);
+
+        // Print info about the serialized data
+        std::cout << "Serialized block of size " << size << " bytes to "
+                  << serialized.size() << " bytes (Flat)" << std::endl;
+
+        // Deserialize
+        FileBlock deserialized = serializer.deserialize_block(serialized);
+
+        // Verify that the deserialized object equals the original
+        assert(deserialized.block_id == original.block_id);
+        assert(deserialized.offset == original.offset);
+        assert(deserialized.data == original.data);
+        assert(deserialized.checksum == original.checksum);
+    }
+
+    // The header carries a 64-bit checksum and the algorithm that produced it
+    FileBlock hashed = generator.generate_block(256, 0, ChecksumAlgorithm::XxHash64);
+    std::vector<uint8_t> hashed_bytes = serializer.serialize_block(hashed);
+    assert(FlatBlockReader(hashed_bytes).checksum_algorithm() == ChecksumAlgorithm::XxHash64);
+    assert(serializer.deserialize_block(hashed_bytes) == hashed);
+
+    std::cout << "Block serialization/deserialization test passed!" << std::endl;
+}
+
+void test_in_place_readers() {
+    FlatSerializer serializer;
+    TestDataGenerator generator;
+
+    FileMetadata metadata = generator.generate_metadata(5);
+    std::vector<uint8_t> serialized = serializer.serialize_metadata(metadata);
+
+    // Fields are read straight out of the buffer
+    FlatMetadataReader reader(serialized);
+    assert(reader.size() == metadata.size);
+    assert(reader.permissions() == metadata.permissions);
+    assert(reader.created_at() == metadata.created_at);
+    assert(reader.last_modified() == metadata.last_modified);
+    assert(reader.path() == metadata.path);
+    assert(reader.name() == metadata.name);
+    assert(reader.owner() == metadata.owner);
+    assert(reader.group() == metadata.group);
+    assert(reader.tag_count() == metadata.tags.size());
+    for (size_t i = 0; i < metadata.tags.size(); ++i) {
+        assert(reader.tag(i) == metadata.tags[i]);
+    }
+    assert(reader.path().data() >= reinterpret_cast<const char*>(serialized.data()));
+
+    FileBlock block = generator.generate_block(4096);
+    std::vector<uint8_t> serialized_block = serializer.serialize_block(block);
+    FlatBlockReader block_reader(serialized_block);
+    assert(block_reader.offset() == block.offset);
+    assert(block_reader.checksum() == block.checksum);
+    assert(block_reader.block_id() == block.block_id);
+    assert(block_reader.data_size() == block.data.size());
+    assert(std::equal(block.data.begin(), block.data.end(), block_reader.data()));
+
+    std::cout << "In-place reader test passed!" << std::endl;
+}
+
+void test_bounds_checking() {
+    FlatSerializer serializer;
+    TestDataGenerator generator;
+
+    std::vector<uint8_t> serialized = serializer.serialize_metadata(generator.generate_metadata());
+
+    // Truncated buffers are rejected up front
+    bool threw = false;
+    try {
+        FlatMetadataReader reader(serialized.data(), serialized.size() - 1);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Corrupt offsets are caught by the accessor
+    std::vector<uint8_t> corrupt = serialized;
+    corrupt[44] = 0xFF; // length of the name field
+    FlatMetadataReader reader(corrupt);
+    threw = false;
+    try {
+        reader.name();
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(reader.size() == FlatMetadataReader(serialized).size());
+
+    // Wrong message type
+    threw = false;
+    try {
+        FlatBlockReader block_reader(serialized);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Bounds checking test passed!" << std::endl;
+}
+
+void benchmark_field_access() {
+    FlatSerializer serializer;
+    TestDataGenerator generator(42);
+    BenchmarkRunner runner(1000);
+
+    FileMetadata metadata = generator.generate_metadata();
+    std::vector<uint8_t> serialized = serializer.serialize_metadata(metadata);
+
+    std::vector<BenchmarkResult> results;
+
+    // Generic path: full decode, then read
+    results.push_back(runner.benchmark_metadata_field_read(serializer, serialized));
+    results.push_back(runner.benchmark_metadata_all_fields_read(serializer, serialized));
+
+    // Zero-copy path: read in place
+    volatile uint64_t sink = 0;
+    results.push_back(runner.benchmark_custom_operation(
+        serializer.format_name(), "zero_copy_field_read", sizeof(uint64_t), serialized.size(),
+        [&]() { sink = FlatMetadataReader(serialized).size(); }));
+    results.push_back(runner.benchmark_custom_operation(
+        serializer.format_name(), "zero_copy_all_fields", logical_size(metadata), serialized.size(),
+        [&]() {
+            FlatMetadataReader reader(serialized);
+            uint64_t total = reader.size() + reader.permissions() +
+                             static_cast<uint64_t>(reader.created_at()) +
+                             static_cast<uint64_t>(reader.last_modified()) +
+                             reader.name().size() + reader.path().size() +
+                             reader.owner().size() + reader.group().size();
+            for (size_t i = 0; i < reader.tag_count(); ++i) {
+                total += reader.tag(i).size();
+            }
+            sink = total;
+        }));
+
+    BenchmarkRunner::print_results(results);
+}
+
+int main() {
+    std::cout << "Running Flat serializer tests..." << std::endl;
+
+    test_metadata_serialization_deserialization();
+    test_block_serialization_deserialization();
+    test_in_place_readers();
+    test_bounds_checking();
+    benchmark_field_access();
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <cassert>
+#include <stdexcept>
 #include "formats/json/json_serializer.h"
 #include "common/test_data_generator.h"
 
@@ -65,14 +66,73 @@ void test_block_serialization_deserialization() {
         assert(deserialized.validate_checksum());
     }
     
+    // Every checksum algorithm survives the round trip and still verifies
+    for (ChecksumAlgorithm algorithm : {ChecksumAlgorithm::Crc32c, ChecksumAlgorithm::XxHash64}) {
+        FileBlock original = generator.generate_block(1024, 0, algorithm);
+        FileBlock deserialized = serializer.deserialize_block(serializer.serialize_block(original));
+        assert(deserialized == original);
+        assert(deserialized.validate_checksum());
+    }
+    
     std::cout << "Block serialization/deserialization test passed!" << std::endl;
 }
 
+void test_block_checksum_verification() {
+    JsonSerializer serializer;
+    TestDataGenerator generator(3);
+    
+    // Every base64 tail length, verified while decoding
+    for (size_t size = 0; size <= 20; ++size) {
+        FileBlock original = generator.generate_block(size);
+        assert(serializer.deserialize_block_verified(serializer.serialize_block(original)) == original);
+    }
+    
+    FileBlock block = generator.generate_block(10000);
+    block.checksum ^= 1;
+    std::vector<uint8_t> corrupt = serializer.serialize_block(block);
+    
+    // Strict: the decode pass throws
+    bool threw = false;
+    try {
+        serializer.decode_block(corrupt, VerificationMode::Strict);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Deferred: decoding succeeds, the first access throws
+    DecodedBlock deferred = serializer.decode_block(corrupt, VerificationMode::Deferred);
+    assert(deferred.pending());
+    assert(deferred.unverified().offset == block.offset);
+    threw = false;
+    try {
+        deferred.block();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw && !deferred.verified());
+    
+    // Trusted: never checked
+    DecodedBlock trusted = serializer.decode_block(corrupt, VerificationMode::Trusted);
+    assert(!trusted.pending() && !trusted.verified());
+    assert(trusted.block().checksum == block.checksum);
+    
+    // A good block passes every mode
+    FileBlock good = generator.generate_block(10000, 0, ChecksumAlgorithm::Crc32c);
+    std::vector<uint8_t> serialized = serializer.serialize_block(good);
+    assert(serializer.decode_block(serialized).verified());
+    DecodedBlock lazy = serializer.decode_block(serialized, VerificationMode::Deferred);
+    assert(lazy.block() == good && lazy.verified());
+    
+    std::cout << "Block checksum verification test passed!" << std::endl;
+}
+
 int main() {
     std::cout << "Running JSON serializer tests..." << std::endl;
     
     test_metadata_serialization_deserialization();
     test_block_serialization_deserialization();
+    test_block_checksum_verification();
     
     std::cout << "All tests passed!" << std::endl;
     return 0;
@@ -1,5 +1,7 @@
 #include <iostream>
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
 #include "formats/msgpack/msgpack_serializer.h"
 #include "common/test_data_generator.h"
 
@@ -66,11 +68,79 @@ void test_block_serialization_deserialization() {
     std::cout << "Block serialization/deserialization test passed!" << std::endl;
 }
 
+namespace {
+    // Packs a block as a positional array of the given length (4 or 5)
+    std::vector<uint8_t> pack_block_array(const FileBlock& block, uint32_t length, uint64_t algorithm) {
+        msgpack::sbuffer buffer;
+        msgpack::packer<msgpack::sbuffer> packer(buffer);
+        packer.pack_array(length);
+        packer.pack(block.block_id);
+        packer.pack(block.offset);
+        packer.pack(block.data);
+        packer.pack(block.checksum);
+        if (length == 5) {
+            packer.pack(algorithm);
+        }
+        return std::vector<uint8_t>(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    template<typename Decode>
+    bool throws_runtime_error(Decode&& decode) {
+        try {
+            decode();
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+}
+
+void test_verified_block_decode() {
+    MessagePackSerializer serializer;
+    TestDataGenerator generator(7);
+
+    for (ChecksumAlgorithm algorithm : {ChecksumAlgorithm::Adler32, ChecksumAlgorithm::Crc32c,
+                                        ChecksumAlgorithm::XxHash64}) {
+        FileBlock block = generator.generate_block(100000, 0, algorithm);
+        std::vector<uint8_t> serialized = serializer.serialize_block(block);
+        assert(serializer.deserialize_block_verified(serialized) == block);
+
+        // Flip one payload byte: the plain decoder accepts it, the verified one does not
+        auto payload = std::search(serialized.begin(), serialized.end(), block.data.begin(), block.data.end());
+        assert(payload != serialized.end());
+        payload[block.data.size() / 2] ^= 0x40;
+        assert(!serializer.deserialize_block(serialized).validate_checksum());
+        assert(throws_runtime_error([&] { serializer.deserialize_block_verified(serialized); }));
+    }
+
+    std::cout << "Verified block decode test passed!" << std::endl;
+}
+
+void test_block_array_versions() {
+    MessagePackSerializer serializer;
+    TestDataGenerator generator(8);
+
+    // 4-element arrays predate the algorithm field and are read as Adler-32
+    FileBlock block = generator.generate_block(1024, 4096, ChecksumAlgorithm::Adler32);
+    std::vector<uint8_t> legacy = pack_block_array(block, 4, 0);
+    assert(serializer.deserialize_block(legacy) == block);
+    assert(serializer.deserialize_block_verified(legacy) == block);
+
+    // An algorithm this build does not know is an error, not a silent cast
+    std::vector<uint8_t> unknown = pack_block_array(block, 5, 3);
+    assert(throws_runtime_error([&] { serializer.deserialize_block(unknown); }));
+    assert(throws_runtime_error([&] { serializer.deserialize_block_verified(unknown); }));
+
+    std::cout << "Block array version test passed!" << std::endl;
+}
+
 int main() {
     std::cout << "Running MessagePack serializer tests..." << std::endl;
     
     test_metadata_serialization_deserialization();
     test_block_serialization_deserialization();
+    test_verified_block_decode();
+    test_block_array_versions();
     
     std::cout << "All tests passed!" << std::endl;
     return 0;
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "common/parameter_sweep.h"
+#include "formats/flat/flat_serializer.h"
+#include "formats/packed/packed_serializer.h"
+#include "formats/tagless/tagless_serializer.h"
+
+using namespace benchmark;
+
+namespace {
+    SweepPoint synthetic_point(const std::string& format, size_t block_size, double duration_ms) {
+        SweepPoint point;
+        point.series = "block";
+        point.block_size = block_size;
+        point.result.format_name = format;
+        point.result.operation_name = "block_serialization";
+        point.result.data_size_bytes = block_size;
+        point.result.duration_ms = duration_ms;
+        return point;
+    }
+}
+
+void test_log_spaced_sizes() {
+    std::vector<size_t> sizes = log_spaced_sizes(64, size_t(64) << 20);
+    assert(sizes.size() == 11 && sizes.front() == 64 && sizes.back() == (size_t(64) << 20));
+    for (size_t i = 1; i < sizes.size(); ++i) {
+        assert(sizes[i] == sizes[i - 1] * 4);
+    }
+    assert((log_spaced_sizes(100, 1000, 4) == std::vector<size_t>{100, 400, 1000}));
+    assert((log_spaced_sizes(10, 10, 2) == std::vector<size_t>{10}));
+    assert(log_spaced_sizes(0, 10, 2).empty());
+    std::cout << "Log-spaced sizes test passed!" << std::endl;
+}
+
+void test_fit_and_crossovers() {
+    // "Linear" costs 1 ns per byte; "Overhead" costs 2 us plus 0.1 ns per
+    // byte, so it loses on small blocks and wins on large ones
+    std::vector<SweepPoint> points;
+    for (size_t size : log_spaced_sizes(64, 1 << 20)) {
+        points.push_back(synthetic_point("Linear", size, 1e-6 * size));
+        points.push_back(synthetic_point("Overhead", size, 2e-3 + 1e-7 * size));
+    }
+
+    std::vector<ScalingExponent> fits = fit_scaling_exponents(points);
+    assert(fits.size() == 2);
+    assert(fits[0].format_name == "Linear" && fits[0].points == 8);
+    assert(std::fabs(fits[0].exponent - 1.0) < 1e-9 && std::fabs(fits[0].r_squared - 1.0) < 1e-9);
+    assert(fits[1].exponent > 0.0 && fits[1].exponent < 1.0);
+
+    // 2000 ns + 0.1 n = n at n ~ 2222: between 1024 and 4096
+    std::vector<Crossover> crossovers = find_crossovers(points);
+    assert(crossovers.size() == 1);
+    assert(crossovers[0].faster_below == "Linear" && crossovers[0].faster_above == "Overhead");
+    assert(crossovers[0].parameter_below == 1024 && crossovers[0].parameter_above == 4096);
+    std::cout << "Scaling fit and crossover test passed!" << std::endl;
+}
+
+void test_sweep_run() {
+    FlatSerializer flat;
+    PackedSerializer packed;
+    TaglessSerializer tagless;
+    std::vector<SerializerInterface*> serializers = {&flat, &packed, &tagless};
+
+    SweepOptions options;
+    options.block_sizes = {256, 64 * 1024, 4 << 20};
+    options.tag_counts = {0, 8};
+    options.name_lengths = {4, 200};
+    options.batch_sizes = {1, 64};
+    options.timing.samples = 10;
+    options.point_seconds = 0.05;
+    size_t reported = 0;
+    options.on_point = [&reported](const SweepPoint&) { ++reported; };
+
+    std::vector<SweepPoint> points = ParameterSweep(options).run(serializers);
+    // Serialization and deserialization per format per parameter combination
+    size_t expected = 2 * serializers.size() * (3 + 2 * 2 + 2);
+    assert(points.size() == expected && reported == expected);
+
+    for (const auto& point : points) {
+        assert(point.result.duration_ms > 0.0 && point.result.data_size_bytes > 0);
+        assert(point.result.latency.samples >= 3 && point.result.latency.samples <= 10);
+        if (point.series == "metadata") {
+            assert(point.block_size == 0 && point.batch_size == 0);
+        } else if (point.series == "metadata_batch") {
+            assert(point.result.records == point.batch_size);
+        }
+    }
+
+    // The name also ends the path, so 196 more name bytes are 392 logical bytes
+    for (const auto& short_name : points) {
+        if (short_name.series != "metadata" || short_name.name_length != 4) {
+            continue;
+        }
+        for (const auto& long_name : points) {
+            if (long_name.series == "metadata" && long_name.name_length == 200 &&
+                long_name.tag_count == short_name.tag_count &&
+                long_name.result.format_name == short_name.result.format_name &&
+                long_name.result.operation_name == short_name.result.operation_name) {
+                assert(long_name.result.data_size_bytes == short_name.result.data_size_bytes + 2 * 196);
+                assert(long_name.result.serialized_size_bytes > short_name.result.serialized_size_bytes);
+            }
+        }
+    }
+
+    // Blocks are dominated by the payload copy: roughly linear in size
+    for (const auto& fit : fit_scaling_exponents(points)) {
+        if (fit.series == "block") {
+            assert(fit.points == 3 && fit.exponent > 0.5 && fit.exponent < 1.5);
+        }
+    }
+
+    std::string csv_path = "/tmp/parameter_sweep_test.csv";
+    std::string json_path = "/tmp/parameter_sweep_test.json";
+    export_sweep_csv(points, csv_path);
+    export_sweep_json(points, json_path);
+    {
+        std::ifstream csv(csv_path);
+        std::string line;
+        size_t lines = 0;
+        while (std::getline(csv, line)) {
+            ++lines;
+        }
+        assert(lines == expected + 1);
+
+        std::ifstream json(json_path);
+        std::string text((std::istreambuf_iterator<char>(json)), std::istreambuf_iterator<char>());
+        assert(text.front() == '[' && text.find("\"tag_count\": null") != std::string::npos);
+    }
+    std::remove(csv_path.c_str());
+    std::remove(json_path.c_str());
+
+    print_sweep_summary(points);
+    std::cout << "Sweep run test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running parameter sweep tests..." << std::endl;
+
+    test_log_spaced_sizes();
+    test_fit_and_crossovers();
+    test_sweep_run();
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
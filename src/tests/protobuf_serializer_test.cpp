@@ -1,6 +1,12 @@
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 #include "formats/protobuf/protobuf_serializer.h"
+#include "common/benchmark_runner.h"
 #include "common/test_data_generator.h"
 
 using namespace benchmark;
@@ -66,11 +72,118 @@ void test_block_serialization_deserialization() {
     std::cout << "Block serialization/deserialization test passed!" << std::endl;
 }
 
+void test_concurrent_instances() {
+    // Each worker repeatedly creates, uses and destroys its own serializer.
+    // Destroying one instance must not affect the others still in flight.
+    const size_t thread_count = std::max(4u, std::thread::hardware_concurrency());
+    const size_t instances_per_thread = 50;
+    const size_t round_trips_per_instance = 20;
+    
+    std::atomic<size_t> failures{0};
+    std::vector<std::thread> workers;
+    
+    for (size_t t = 0; t < thread_count; ++t) {
+        workers.emplace_back([&, t]() {
+            TestDataGenerator generator(static_cast<unsigned int>(t + 1));
+            FileMetadata metadata = generator.generate_metadata();
+            FileBlock block = generator.generate_block(1024);
+            
+            for (size_t i = 0; i < instances_per_thread; ++i) {
+                ProtobufSerializer serializer;
+                for (size_t j = 0; j < round_trips_per_instance; ++j) {
+                    if (serializer.deserialize_metadata(serializer.serialize_metadata(metadata)) != metadata ||
+                        serializer.deserialize_block(serializer.serialize_block(block)) != block) {
+                        ++failures;
+                    }
+                }
+            }
+        });
+    }
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    assert(failures == 0);
+    
+    // A serializer created after all the others were destroyed must still work
+    ProtobufSerializer serializer;
+    TestDataGenerator generator;
+    FileMetadata metadata = generator.generate_metadata();
+    assert(serializer.deserialize_metadata(serializer.serialize_metadata(metadata)) == metadata);
+    
+    std::cout << "Concurrent instance stress test passed (" << thread_count << " threads)!" << std::endl;
+}
+
+void benchmark_concurrent_throughput() {
+    // Metadata round trips per second with one serializer per thread
+    const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t ops_per_thread = 20000;
+    
+    TestDataGenerator generator(42);
+    FileMetadata metadata = generator.generate_metadata();
+    
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::vector<std::thread> workers;
+        auto start = std::chrono::steady_clock::now();
+        
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&]() {
+                ProtobufSerializer serializer;
+                for (size_t i = 0; i < ops_per_thread; ++i) {
+                    serializer.deserialize_metadata(serializer.serialize_metadata(metadata));
+                }
+            });
+        }
+        
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Threads: " << threads
+                  << "  metadata round trips/s: " << static_cast<uint64_t>(threads * ops_per_thread / seconds)
+                  << std::endl;
+    }
+}
+
+void benchmark_fused_verification() {
+    ProtobufSerializer serializer;
+    TestDataGenerator generator(42);
+    BenchmarkRunner runner(50);
+    
+    std::vector<BenchmarkResult> results;
+    
+    for (size_t size : {64u * 1024, 1024u * 1024, 16u * 1024 * 1024}) {
+        FileBlock block = generator.generate_block(size, 0, ChecksumAlgorithm::Crc32c);
+        std::vector<uint8_t> serialized = serializer.serialize_block(block);
+        assert(serializer.deserialize_block_verified(serialized) == block);
+        
+        // Copy the bytes field, then read it again to verify
+        results.push_back(runner.benchmark_custom_operation(
+            serializer.format_name(), "decode_then_verify", size, serialized.size(),
+            [&]() {
+                FileBlock decoded = serializer.deserialize_block(serialized);
+                assert(decoded.validate_checksum());
+            }));
+        // Strict verifies while copying; deferred pays on first access; trusted never does
+        for (VerificationMode mode : {VerificationMode::Strict, VerificationMode::Deferred,
+                                      VerificationMode::Trusted}) {
+            results.push_back(runner.benchmark_block_decode(serializer, serialized, mode));
+        }
+    }
+    
+    BenchmarkRunner::print_results(results);
+}
+
 int main() {
     std::cout << "Running Protocol Buffers serializer tests..." << std::endl;
     
     test_metadata_serialization_deserialization();
     test_block_serialization_deserialization();
+    test_concurrent_instances();
+    benchmark_concurrent_throughput();
+    benchmark_fused_verification();
     
     std::cout << "All tests passed!" << std::endl;
     return 0;
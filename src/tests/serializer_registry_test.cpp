@@ -0,0 +1,140 @@
+#include <iostream>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/serializer_registry.h"
+#include "common/test_data_generator.h"
+#include "formats/flat/flat_serializer.h"
+
+using namespace benchmark;
+
+void test_linked_formats_register_themselves() {
+    const SerializerRegistry& registry = SerializerRegistry::instance();
+
+    // Exactly the formats this test links, sorted by key
+    std::vector<std::string> keys;
+    for (const auto& registration : registry.formats()) {
+        keys.push_back(registration.key);
+    }
+    assert((keys == std::vector<std::string>{"columnar", "flat", "packed", "tagless", "tagless-schema"}));
+
+    // Registered names match what the serializers report
+    for (const auto& registration : registry.formats()) {
+        assert(registration.create()->format_name() == registration.format_name);
+    }
+
+    std::cout << "Registration test passed!" << std::endl;
+}
+
+void test_lookup() {
+    const SerializerRegistry& registry = SerializerRegistry::instance();
+
+    assert(registry.find("flat") == registry.find("Flat"));
+    assert(registry.find("PACKEDPOD") && registry.find("PACKEDPOD")->key == "packed");
+    assert(registry.find("JSON") == nullptr);
+
+    std::unique_ptr<SerializerInterface> serializer = registry.create("Tagless+Schema");
+    assert(serializer->format_name() == "Tagless+Schema");
+
+    bool threw = false;
+    try {
+        registry.create("xml");
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Lookup test passed!" << std::endl;
+}
+
+void test_capabilities() {
+    const SerializerRegistry& registry = SerializerRegistry::instance();
+
+    auto zero_copy = registry.with_capabilities(static_cast<SerializerCapabilities>(SerializerCapability::ZeroCopyRead));
+    assert(zero_copy.size() == 1 && zero_copy[0]->key == "flat");
+    auto batch = registry.with_capabilities(SerializerCapability::Batch | SerializerCapability::BinarySafe);
+    assert(batch.size() == 1 && batch[0]->key == "columnar");
+    assert(registry.with_capabilities(0).size() == registry.formats().size());
+
+    // Names round-trip and list in bit order
+    for (size_t i = 0; i < SERIALIZER_CAPABILITY_COUNT; ++i) {
+        SerializerCapability capability = static_cast<SerializerCapability>(1u << i);
+        SerializerCapability parsed;
+        assert(parse_serializer_capability(serializer_capability_name(capability), parsed) && parsed == capability);
+    }
+    SerializerCapability parsed;
+    assert(!parse_serializer_capability("fast", parsed));
+    assert(serializer_capability_names(registry.find("flat")->capabilities) ==
+           "binary-safe,zero-copy,streaming,schema-required,deterministic");
+
+    // The flags hold for every registered format
+    TestDataGenerator generator(7);
+    FileMetadata metadata = generator.generate_metadata();
+    FileMetadata binary = metadata;
+    binary.name = std::string("a\0b\xff\x01", 5);
+    binary.owner = std::string("\xc3\x28", 2);  // Invalid UTF-8
+    for (const auto& registration : registry.formats()) {
+        std::unique_ptr<SerializerInterface> serializer = registration.create();
+        std::vector<uint8_t> encoded = serializer->serialize_metadata(metadata);
+        if (registration.has(SerializerCapability::Deterministic)) {
+            assert(serializer->serialize_metadata(metadata) == encoded);
+            assert(registration.create()->serialize_metadata(metadata) == encoded);
+        }
+        if (registration.has(SerializerCapability::BinarySafe)) {
+            assert(serializer->deserialize_metadata(serializer->serialize_metadata(binary)) == binary);
+        }
+        if (registration.has(SerializerCapability::ZeroCopyRead)) {
+            assert(FlatMetadataReader(encoded).name() == metadata.name);
+        }
+    }
+
+    std::cout << "Capability test passed!" << std::endl;
+}
+
+void test_duplicate_registration() {
+    SerializerRegistry registry;
+    SerializerRegistration registration;
+    registration.key = "flat";
+    registration.format_name = "Flat";
+    registration.create = [] { return std::unique_ptr<SerializerInterface>(new FlatSerializer()); };
+    registry.add(registration);
+
+    // The key or the format name alone is enough to collide
+    for (const auto& key_and_name : std::vector<std::pair<std::string, std::string>>{{"FLAT", "Other"}, {"other", "flat"}}) {
+        SerializerRegistration duplicate = registration;
+        duplicate.key = key_and_name.first;
+        duplicate.format_name = key_and_name.second;
+        bool threw = false;
+        try {
+            registry.add(duplicate);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    SerializerRegistration empty;
+    empty.key = "empty";
+    empty.format_name = "Empty";
+    bool threw = false;
+    try {
+        registry.add(empty);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && registry.formats().size() == 1);
+
+    std::cout << "Duplicate registration test passed!" << std::endl;
+}
+
+int main() {
+    test_linked_formats_register_themselves();
+    test_lookup();
+    test_capabilities();
+    test_duplicate_registration();
+
+    std::cout << "All serializer registry tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include <iostream>
+#include <cassert>
+#include <stdexcept>
+#include "formats/tagless/tagless_serializer.h"
+#include "common/test_data_generator.h"
+
+using namespace benchmark;
+
+void test_metadata_serialization_deserialization(bool schema_header) {
+    TaglessSerializer serializer(schema_header);
+    TestDataGenerator generator;
+
+    // Generate a sample metadata
+    FileMetadata original = generator.generate_metadata();
+
+    // Serialize
+    std::vector<uint8_t> serialized = serializer.serialize_metadata(original);
+
+    // Print info about the serialized data
+    std::cout << "Serialized metadata to " << serialized.size() << " bytes ("
+              << serializer.format_name() << ")" << std::endl;
+
+    // Deserialize
+    FileMetadata deserialized = serializer.deserialize_metadata(serialized);
+
+    // Verify that the deserialized object equals the original
+    assert(deserialized.name == original.name);
+    assert(deserialized.path == original.path);
+    assert(deserialized.size == original.size);
+    assert(deserialized.created_at == original.created_at);
+    assert(deserialized.last_modified == original.last_modified);
+    assert(deserialized.tags == original.tags);
+    assert(deserialized.permissions == original.permissions);
+    assert(deserialized.owner == original.owner);
+    assert(deserialized.group == original.group);
+
+    std::cout << "Metadata serialization/deserialization test passed!" << std::endl;
+}
+
+void test_block_serialization_deserialization(bool schema_header) {
+    TaglessSerializer serializer(schema_header);
+    TestDataGenerator generator;
+
+    // Generate sample blocks of different sizes
+    std::vector<size_t> sizes = {0, 64, 1024, 4096};
+
+    for (size_t size : sizes) {
+        // Generate a sample block
+        FileBlock original = generator.generate_block(size);
+
+        // Serialize
+        std::vector<uint8_t> serialized = serializer.serialize_block(original);
+
+        // Print info about the serialized data
+        std::cout << "Serialized block of size " << size << " bytes to "
+                  << serialized.size() << " bytes (" << serializer.format_name() << ")" << std::endl;
+
+        // Deserialize
+        FileBlock deserialized = serializer.deserialize_block(serialized);
+
+        // Verify that the deserialized object equals the original
+        assert(deserialized.block_id == original.block_id);
+        assert(deserialized.offset == original.offset);
+        assert(deserialized.data == original.data);
+        assert(deserialized.checksum == original.checksum);
+    }
+
+    std::cout << "Block serialization/deserialization test passed!" << std::endl;
+}
+
+void test_edge_values() {
+    TaglessSerializer serializer;
+
+    // Negative timestamps and full-width sizes survive the zigzag/varint round trip
+    FileMetadata metadata;
+    metadata.size = UINT64_MAX;
+    metadata.created_at = -1;
+    metadata.last_modified = static_cast<time_t>(INT64_MIN);
+    metadata.permissions = UINT32_MAX;
+    metadata.tags = {"", "x"};
+
+    assert(serializer.deserialize_metadata(serializer.serialize_metadata(metadata)) == metadata);
+
+    // No tags, no type markers: an empty record is one byte per field,
+    // plus one extra for the default 0644 permissions
+    FileMetadata empty;
+    empty.owner.clear();
+    empty.group.clear();
+    assert(serializer.serialize_metadata(empty).size() == 10);
+
+    std::cout << "Edge value test passed!" << std::endl;
+}
+
+void test_schema_resolution() {
+    TaglessSerializer with_header(true);
+    TaglessSerializer without_header(false);
+    TestDataGenerator generator;
+
+    FileMetadata metadata = generator.generate_metadata();
+    std::vector<uint8_t> plain = without_header.serialize_metadata(metadata);
+    std::vector<uint8_t> framed = with_header.serialize_metadata(metadata);
+
+    // The header adds exactly the marker and the fingerprint
+    assert(framed.size() == plain.size() + 10);
+    assert(TaglessSerializer::metadata_schema_fingerprint() != TaglessSerializer::block_schema_fingerprint());
+
+    // A reader rejects messages written with a schema it does not know
+    std::vector<uint8_t> block = with_header.serialize_block(generator.generate_block(64));
+    bool threw = false;
+    try {
+        with_header.deserialize_metadata(block);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Truncated input is detected rather than read past the end
+    plain.pop_back();
+    threw = false;
+    try {
+        without_header.deserialize_metadata(plain);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Schema resolution test passed!" << std::endl;
+}
+
+void test_avro_encoding() {
+    TaglessSerializer serializer;
+
+    // Longs and ints are zigzag varints, lengths included, and arrays end
+    // with an empty block, byte for byte what an Avro writer produces
+    FileBlock block;
+    block.block_id = "a";
+    block.offset = 1;
+    block.data = {0x7f};
+    block.checksum = 2;
+    block.checksum_algorithm = ChecksumAlgorithm::Crc32c;
+    std::vector<uint8_t> expected_block = {0x02, 'a', 0x02, 0x02, 0x7f, 0x04, 0x02};
+    assert(serializer.serialize_block(block) == expected_block);
+
+    FileMetadata metadata;
+    metadata.name = "n";
+    metadata.size = 3;
+    metadata.created_at = -1;
+    metadata.tags = {"x"};
+    metadata.permissions = 1;
+    metadata.owner.clear();
+    metadata.group.clear();
+    std::vector<uint8_t> expected_metadata = {
+        0x02, 'n', 0x00, 0x06, 0x01, 0x00, 0x02, 0x02, 'x', 0x00, 0x02, 0x00, 0x00};
+    assert(serializer.serialize_metadata(metadata) == expected_metadata);
+
+    // Arrays split into several blocks, with or without the byte-size
+    // prefix a negative count announces, decode to the same tags
+    std::vector<uint8_t> blocked = {
+        0x02, 'n', 0x00, 0x06, 0x01, 0x00,
+        0x02, 0x02, 'x',
+        0x01, 0x04, 0x02, 'y',
+        0x00, 0x02, 0x00, 0x00};
+    assert((serializer.deserialize_metadata(blocked).tags == std::vector<std::string>{"x", "y"}));
+
+    // Permissions are an Avro int, so longs outside its range are rejected
+    std::vector<uint8_t> wide = expected_metadata;
+    wide[10] = 0x80;
+    wide.insert(wide.begin() + 11, {0x80, 0x80, 0x80, 0x10});
+    bool threw = false;
+    try {
+        serializer.deserialize_metadata(wide);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Avro encoding test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running Tagless serializer tests..." << std::endl;
+
+    test_metadata_serialization_deserialization(false);
+    test_metadata_serialization_deserialization(true);
+    test_block_serialization_deserialization(false);
+    test_block_serialization_deserialization(true);
+    test_edge_values();
+    test_schema_resolution();
+    test_avro_encoding();
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
\ No newline at end of file
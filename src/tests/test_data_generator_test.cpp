@@ -1,7 +1,16 @@
 #include <iostream>
+#include <iomanip>
 #include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <cstring>
+#include <random>
 #include <set>
+#include <thread>
 #include "common/test_data_generator.h"
+#include "common/fast_random.h"
 #include "common/utilities.h"
 
 using namespace benchmark;
@@ -87,12 +96,336 @@ void test_batch_generation() {
     std::cout << "Batch generation test passed!" << std::endl;
 }
 
+void test_seed_determinism() {
+    TestDataGenerator first(7), second(7), other(8);
+    
+    for (size_t size : {0u, 1u, 31u, 32u, 33u, 4096u, 100000u}) {
+        FileBlock a = first.generate_block(size);
+        FileBlock b = second.generate_block(size);
+        assert(a == b);
+        if (size >= 8) {
+            assert(other.generate_block(size).data != a.data);
+        }
+    }
+    
+    assert(first.generate_metadata() == second.generate_metadata());
+    
+    std::cout << "Seed determinism test passed!" << std::endl;
+}
+
+void test_bulk_generator_streams() {
+    // SplitMix64 reference output for state 0
+    uint64_t sm = 0;
+    assert(splitmix64(sm) == 0xE220A8397B1DCDAFULL);
+    
+    // fill() is the operator() sequence, little-endian
+    Xoshiro256StarStar scalar(123), filler(123);
+    std::vector<uint8_t> bytes(8 * 16 + 5);
+    filler.fill(bytes.data(), bytes.size());
+    for (size_t i = 0; i < 16; ++i) {
+        uint64_t expected = scalar();
+        for (size_t b = 0; b < 8; ++b) {
+            assert(bytes[i * 8 + b] == static_cast<uint8_t>(expected >> (8 * b)));
+        }
+    }
+    
+    // Lane k of the bulk generator is the seed's stream jumped k times
+    BulkRandomGenerator bulk(123);
+    std::vector<uint8_t> block(32 * 64);
+    bulk.fill(block.data(), block.size());
+    Xoshiro256StarStar lane_stream(123);
+    for (size_t lane = 0; lane < 4; ++lane) {
+        Xoshiro256StarStar expected = lane_stream;
+        for (size_t step = 0; step < 64; ++step) {
+            uint64_t word = 0;
+            for (size_t b = 0; b < 8; ++b) {
+                word |= static_cast<uint64_t>(block[step * 32 + lane * 8 + b]) << (8 * b);
+            }
+            assert(word == expected());
+        }
+        lane_stream.jump();
+    }
+    
+    std::cout << "Bulk generator stream test passed!" << std::endl;
+}
+
+template<typename Fill>
+double fill_gbps(Fill&& fill) {
+    std::vector<uint8_t> buffer(16 * 1024 * 1024);
+    fill(buffer.data(), buffer.size()); // warm up and fault in
+    
+    const int repetitions = 4;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i) {
+        fill(buffer.data(), buffer.size());
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(buffer.size()) * repetitions / seconds / 1e9;
+}
+
+void benchmark_payload_generation() {
+    std::mt19937 mt(1);
+    std::uniform_int_distribution<uint8_t> byte_dist(0, 255);
+    Xoshiro256StarStar xoshiro(1);
+    BulkRandomGenerator bulk(1);
+    TestDataGenerator generator(1);
+    
+    std::cout << std::left << std::fixed << std::setprecision(2)
+              << std::setw(36) << "Payload generator" << "GB/s" << std::endl;
+    std::cout << std::string(44, '-') << std::endl;
+    std::cout << std::setw(36) << "mt19937 + distribution per byte"
+              << fill_gbps([&](uint8_t* p, size_t n) {
+                     std::generate(p, p + n, [&]() { return byte_dist(mt); });
+                 }) << std::endl;
+    std::cout << std::setw(36) << "xoshiro256** (8 bytes/step)"
+              << fill_gbps([&](uint8_t* p, size_t n) { xoshiro.fill(p, n); }) << std::endl;
+    std::cout << std::setw(36) << "4-lane xoshiro256** (32 bytes/step)"
+              << fill_gbps([&](uint8_t* p, size_t n) { bulk.fill(p, n); }) << std::endl;
+    std::cout << std::setw(36) << "generate_block (incl. checksum)"
+              << fill_gbps([&](uint8_t* p, size_t n) {
+                     FileBlock block = generator.generate_block(n);
+                     std::memcpy(p, block.data.data(), 1);
+                 }) << std::endl;
+}
+
+void test_parallel_determinism() {
+    std::vector<size_t> sizes;
+    for (size_t i = 0; i < 600; ++i) {
+        sizes.push_back(1 + (i * 7919) % 20000);
+    }
+    
+    TestDataGenerator reference(11);
+    auto metadata = reference.generate_metadata_batch_parallel(5000, 1);
+    auto blocks = reference.generate_block_batch_parallel(sizes, ChecksumAlgorithm::Crc32c, 1);
+    assert(metadata.size() == 5000);
+    assert(blocks.size() == sizes.size());
+    
+    // Same seed and reference time give the same batches for any thread count
+    for (unsigned threads : {2u, 3u, 8u, 0u}) {
+        TestDataGenerator generator(11);
+        generator.set_reference_time(reference.reference_time());
+        assert(generator.generate_metadata_batch_parallel(5000, threads) == metadata);
+        assert(generator.generate_block_batch_parallel(sizes, ChecksumAlgorithm::Crc32c, threads) == blocks);
+    }
+    
+    uint64_t offset = 0;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        assert(blocks[i].data.size() == sizes[i]);
+        assert(blocks[i].offset == offset);
+        assert(blocks[i].checksum_algorithm == ChecksumAlgorithm::Crc32c);
+        assert(blocks[i].validate_checksum());
+        offset += sizes[i];
+    }
+    
+    // Chunks draw from distinct substreams, and each call starts a new batch
+    assert(metadata[0] != metadata[1024]);
+    assert(blocks[0].data != blocks[300].data);
+    auto next = reference.generate_metadata_batch_parallel(5000, 1);
+    assert(next != metadata);
+    
+    for (const auto& record : metadata) {
+        assert(record.created_at <= reference.reference_time());
+        assert(record.created_at >= reference.reference_time() - 365 * 24 * 60 * 60);
+    }
+    
+    std::cout << "Parallel determinism test passed!" << std::endl;
+}
+
+// Shannon entropy of the byte histogram, in bits per byte
+double byte_entropy(const std::vector<uint8_t>& data) {
+    size_t counts[256] = {};
+    for (uint8_t byte : data) {
+        ++counts[byte];
+    }
+    double entropy = 0.0;
+    for (size_t count : counts) {
+        if (count > 0) {
+            double p = static_cast<double>(count) / data.size();
+            entropy -= p * std::log2(p);
+        }
+    }
+    return entropy;
+}
+
+bool valid_utf8(const std::string& text) {
+    for (size_t i = 0; i < text.size();) {
+        unsigned char c = text[i];
+        size_t extra;
+        if (c < 0x80) {
+            extra = 0;
+        } else if ((c >> 5) == 0x6) {
+            extra = 1;
+        } else if ((c >> 4) == 0xE) {
+            extra = 2;
+        } else if ((c >> 3) == 0x1E) {
+            extra = 3;
+        } else {
+            return false;
+        }
+        if (i + extra >= text.size()) {
+            return false;
+        }
+        for (size_t j = 1; j <= extra; ++j) {
+            if ((static_cast<unsigned char>(text[i + j]) >> 6) != 0x2) {
+                return false;
+            }
+        }
+        i += extra + 1;
+    }
+    return true;
+}
+
+void test_workload_profiles() {
+    WorkloadProfile profile;
+    assert(!find_workload_profile("nonexistent", profile));
+    for (const auto& name : workload_profile_names()) {
+        assert(find_workload_profile(name, profile));
+        assert(profile.name == name);
+    }
+    assert(default_workload_profile().synthetic);
+    
+    // The default profile keeps the original shape
+    TestDataGenerator uniform(5);
+    FileMetadata legacy = uniform.generate_metadata();
+    assert(legacy.name.size() == 12 && legacy.path.compare(0, 6, "/data/") == 0);
+    assert(legacy.tags.size() == 3);
+    
+    assert(find_workload_profile("production", profile));
+    TestDataGenerator generator(5, profile);
+    std::map<std::string, size_t> owner_counts;
+    size_t utf8_names = 0;
+    uint64_t largest = 0;
+    for (size_t i = 0; i < 5000; ++i) {
+        FileMetadata metadata = generator.generate_metadata();
+        size_t depth = std::count(metadata.path.begin(), metadata.path.end(), '/') - 1;
+        assert(depth >= profile.min_depth && depth <= profile.max_depth);
+        assert(metadata.path.size() > metadata.name.size());
+        assert(metadata.path.compare(metadata.path.size() - metadata.name.size(),
+                                     metadata.name.size(), metadata.name) == 0);
+        assert(valid_utf8(metadata.name));
+        assert(metadata.tags.size() >= profile.min_tags && metadata.tags.size() <= profile.max_tags);
+        assert(metadata.size >= profile.min_size && metadata.size <= profile.max_size);
+        assert(metadata.last_modified >= metadata.created_at);
+        assert(metadata.last_modified <= generator.reference_time());
+        utf8_names += std::any_of(metadata.name.begin(), metadata.name.end(),
+                                  [](char c) { return static_cast<unsigned char>(c) >= 0x80; });
+        largest = std::max(largest, metadata.size);
+        ++owner_counts[metadata.owner];
+    }
+    // Skewed popularity: the top owner is far above the uniform share of 1/10
+    size_t top_owner = 0;
+    for (const auto& entry : owner_counts) {
+        top_owner = std::max(top_owner, entry.second);
+    }
+    assert(top_owner > 5000 / 4);
+    assert(utf8_names > 250 && utf8_names < 1000);
+    assert(largest > 16 * 1024 * 1024);  // The heavy tail reaches far past the median
+    
+    // Entropy classes are distinguishable and deterministic
+    const size_t SIZE = 256 * 1024;
+    TestDataGenerator first(9, profile), second(9, profile);
+    for (size_t c = 0; c < PAYLOAD_CLASS_COUNT; ++c) {
+        PayloadClass payload_class = static_cast<PayloadClass>(c);
+        FileBlock block = first.generate_block(SIZE, 0, ChecksumAlgorithm::Adler32, payload_class);
+        assert(block == second.generate_block(SIZE, 0, ChecksumAlgorithm::Adler32, payload_class));
+        assert(block.data.size() == SIZE && block.validate_checksum());
+        
+        double entropy = byte_entropy(block.data);
+        switch (payload_class) {
+            case PayloadClass::Zeros:
+                assert(entropy == 0.0);
+                break;
+            case PayloadClass::Text:
+            case PayloadClass::Logs:
+                assert(entropy > 3.0 && entropy < 6.0);
+                assert(std::all_of(block.data.begin(), block.data.end(),
+                                   [](uint8_t b) { return b == '\n' || (b >= 0x20 && b < 0x7F); }));
+                break;
+            case PayloadClass::Random:
+            case PayloadClass::Compressed:
+                assert(entropy > 7.99);
+                break;
+        }
+    }
+    
+    // Parallel batches keep the profile
+    auto batch = generator.generate_metadata_batch_parallel(2000, 2);
+    for (const auto& metadata : batch) {
+        size_t depth = std::count(metadata.path.begin(), metadata.path.end(), '/') - 1;
+        assert(depth >= profile.min_depth && depth <= profile.max_depth);
+        assert(valid_utf8(metadata.name));
+    }
+    
+    std::cout << "Workload profile test passed!" << std::endl;
+}
+
+void benchmark_payload_classes() {
+    const size_t SIZE = 16 * 1024 * 1024;
+    TestDataGenerator generator(1);
+    
+    std::cout << std::left << std::fixed << std::setprecision(2)
+              << std::setw(14) << "Payload class" << std::setw(16) << "Bits per byte" << "GB/s" << std::endl;
+    std::cout << std::string(36, '-') << std::endl;
+    for (size_t c = 0; c < PAYLOAD_CLASS_COUNT; ++c) {
+        PayloadClass payload_class = static_cast<PayloadClass>(c);
+        auto start = std::chrono::high_resolution_clock::now();
+        FileBlock block = generator.generate_block(SIZE, 0, ChecksumAlgorithm::Crc32c, payload_class);
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << std::setw(14) << payload_class_name(payload_class)
+                  << std::setw(16) << byte_entropy(block.data) << SIZE / seconds / 1e9 << std::endl;
+    }
+}
+
+void benchmark_parallel_generation() {
+    const size_t RECORDS = 200000;
+    std::vector<size_t> sizes(512, 256 * 1024);
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    
+    auto time_it = [](auto&& fn) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    };
+    
+    std::cout << std::left << std::fixed << std::setprecision(2)
+              << std::setw(28) << "Batch generation" << std::setw(10) << "Threads"
+              << std::setw(14) << "Records/s" << "GB/s" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+    
+    TestDataGenerator generator(3);
+    double serial = time_it([&]() { generator.generate_metadata_batch(RECORDS); });
+    std::cout << std::setw(28) << "metadata (serial)" << std::setw(10) << 1
+              << std::setw(14) << RECORDS / serial << "-" << std::endl;
+    double parallel = time_it([&]() { generator.generate_metadata_batch_parallel(RECORDS); });
+    std::cout << std::setw(28) << "metadata (parallel)" << std::setw(10) << cores
+              << std::setw(14) << RECORDS / parallel << "-" << std::endl;
+    
+    double bytes = static_cast<double>(sizes.size() * sizes[0]);
+    serial = time_it([&]() { generator.generate_block_batch(sizes); });
+    std::cout << std::setw(28) << "blocks (serial)" << std::setw(10) << 1
+              << std::setw(14) << sizes.size() / serial << bytes / serial / 1e9 << std::endl;
+    parallel = time_it([&]() { generator.generate_block_batch_parallel(sizes); });
+    std::cout << std::setw(28) << "blocks (parallel)" << std::setw(10) << cores
+              << std::setw(14) << sizes.size() / parallel << bytes / parallel / 1e9 << std::endl;
+}
+
 int main() {
     std::cout << "Running test data generator tests..." << std::endl;
     
     test_metadata_generation();
     test_block_generation();
     test_batch_generation();
+    test_seed_determinism();
+    test_bulk_generator_streams();
+    test_parallel_determinism();
+    test_workload_profiles();
+    benchmark_payload_generation();
+    benchmark_payload_classes();
+    benchmark_parallel_generation();
     
     std::cout << "All tests passed!" << std::endl;
     return 0;
@@ -0,0 +1,472 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/binary_encoding.h"
+#include "common/data_structures.h"
+#include "common/utilities.h"
+
+using namespace benchmark;
+
+// Original byte-at-a-time Adler-32, kept as the reference
+uint32_t reference_adler32(const uint8_t* data, size_t size) {
+    const uint32_t MOD_ADLER = 65521;
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < size; ++i) {
+        a = (a + data[i]) % MOD_ADLER;
+        b = (b + a) % MOD_ADLER;
+    }
+    return (b << 16) | a;
+}
+
+void test_adler32_matches_reference() {
+    std::mt19937 rng(42);
+    std::vector<uint8_t> buffer(3 * 1024 * 1024 + 67);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    // Every small size, at several alignments
+    for (size_t size = 0; size <= 600; ++size) {
+        for (size_t offset = 0; offset < 4; ++offset) {
+            uint32_t expected = reference_adler32(buffer.data() + offset, size);
+            assert(adler32_update(1, buffer.data() + offset, size) == expected);
+            assert(adler32_update_scalar(1, buffer.data() + offset, size) == expected);
+        }
+    }
+
+    // Sizes around the NMAX reduction boundary and large buffers
+    for (size_t size : {5551u, 5552u, 5553u, 5552u * 3 + 31, 65536u, 1048576u + 13, 3145728u + 67}) {
+        uint32_t expected = reference_adler32(buffer.data(), size);
+        assert(adler32_update(1, buffer.data(), size) == expected);
+        assert(adler32_update_scalar(1, buffer.data(), size) == expected);
+    }
+
+    // Worst case for the deferred modulo: every byte is 0xFF
+    std::vector<uint8_t> ones(1024 * 1024 + 5, 0xFF);
+    assert(adler32_update(1, ones.data(), ones.size()) == reference_adler32(ones.data(), ones.size()));
+
+    // Continuing from a previous value equals one pass over the whole buffer
+    uint32_t split = adler32_update(1, buffer.data(), 12345);
+    split = adler32_update(split, buffer.data() + 12345, 100000);
+    assert(split == reference_adler32(buffer.data(), 12345 + 100000));
+
+    // The vector wrapper is unchanged
+    std::vector<uint8_t> prefix(buffer.begin(), buffer.begin() + 4096);
+    assert(calculate_checksum(prefix) == reference_adler32(prefix.data(), prefix.size()));
+
+    std::cout << "Adler-32 reference test passed (" << adler32_implementation() << ")!" << std::endl;
+}
+
+void test_crc32c_known_values() {
+    const std::string check = "123456789";
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(check.data());
+
+    // Standard CRC-32C check value
+    assert(crc32c_update(0, bytes, check.size()) == 0xE3069283);
+    assert(crc32c_update_portable(0, bytes, check.size()) == 0xE3069283);
+    assert(crc32c_update(0, nullptr, 0) == 0);
+
+    // Hardware and table implementations agree at every size and alignment
+    std::mt19937 rng(11);
+    std::vector<uint8_t> buffer(1024 * 1024 + 37);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    for (size_t size = 0; size <= 300; ++size) {
+        for (size_t offset = 0; offset < 8; ++offset) {
+            assert(crc32c_update(0, buffer.data() + offset, size) ==
+                   crc32c_update_portable(0, buffer.data() + offset, size));
+        }
+    }
+    assert(crc32c_update(0, buffer.data(), buffer.size()) ==
+           crc32c_update_portable(0, buffer.data(), buffer.size()));
+
+    // Continuing from a previous value equals one pass over the whole buffer
+    uint32_t split = crc32c_update(0, buffer.data(), 1001);
+    split = crc32c_update(split, buffer.data() + 1001, 50000);
+    assert(split == crc32c_update(0, buffer.data(), 51001));
+
+    std::cout << "CRC-32C test passed (" << crc32c_implementation() << ")!" << std::endl;
+}
+
+void test_every_implementation() {
+    std::mt19937 rng(5);
+    std::vector<uint8_t> buffer(256 * 1024 + 45);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    std::vector<uint8_t> ones(256 * 1024 + 5, 0xFF);
+
+    // Each one, not only the one dispatched to, matches the reference
+    std::vector<ChecksumImplementation> adler32 = adler32_implementations();
+    assert(std::string(adler32.front().name) == "scalar");
+    assert(std::string(adler32.back().name) == adler32_implementation());
+    for (const auto& implementation : adler32) {
+        for (size_t size = 0; size <= 300; ++size) {
+            for (size_t offset = 0; offset < 4; ++offset) {
+                assert(implementation.update(1, buffer.data() + offset, size) ==
+                       reference_adler32(buffer.data() + offset, size));
+            }
+        }
+        for (size_t size : {5551u, 5552u, 5553u, 65536u + 7, 256u * 1024 + 45}) {
+            assert(implementation.update(1, buffer.data(), size) == reference_adler32(buffer.data(), size));
+        }
+        assert(implementation.update(1, ones.data(), ones.size()) == reference_adler32(ones.data(), ones.size()));
+        uint32_t split = implementation.update(1, buffer.data(), 777);
+        assert(implementation.update(split, buffer.data() + 777, 9000) == reference_adler32(buffer.data(), 9777));
+        std::cout << "  adler32 " << implementation.name << " matches" << std::endl;
+    }
+
+    std::vector<ChecksumImplementation> crc32c = crc32c_implementations();
+    assert(std::string(crc32c.front().name) == "portable");
+    assert(std::string(crc32c.back().name) == crc32c_implementation());
+    const std::string check = "123456789";
+    for (const auto& implementation : crc32c) {
+        assert(implementation.update(0, reinterpret_cast<const uint8_t*>(check.data()), check.size()) == 0xE3069283);
+        for (size_t size = 0; size <= 300; ++size) {
+            for (size_t offset = 0; offset < 8; ++offset) {
+                assert(implementation.update(0, buffer.data() + offset, size) ==
+                       crc32c_update_portable(0, buffer.data() + offset, size));
+            }
+        }
+        assert(implementation.update(0, buffer.data(), buffer.size()) ==
+               crc32c_update_portable(0, buffer.data(), buffer.size()));
+        std::cout << "  crc32c " << implementation.name << " matches" << std::endl;
+    }
+
+    std::cout << "Every implementation test passed!" << std::endl;
+}
+
+void test_xxhash64_known_values() {
+    auto hash = [](const std::string& text, uint64_t seed = 0) {
+        return xxhash64(reinterpret_cast<const uint8_t*>(text.data()), text.size(), seed);
+    };
+
+    assert(hash("") == 0xEF46DB3751D8E999ULL);
+    assert(hash("a") == 0xD24EC4F1A98C6E5BULL);
+    assert(hash("abc") == 0x44BC2CF5AD770999ULL);
+    // Long enough to go through the four-lane loop
+    assert(hash("Nobody inspects the spammish repetition") == 0xFBCEA83C8A378BF1ULL);
+    assert(hash("abc", 1) != hash("abc"));
+
+    std::cout << "xxHash64 test passed!" << std::endl;
+}
+
+void test_algorithm_selection() {
+    std::vector<uint8_t> data = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    assert(calculate_checksum(data, ChecksumAlgorithm::Adler32) == calculate_checksum(data));
+    assert(calculate_checksum(data, ChecksumAlgorithm::Crc32c) == 0xE3069283);
+    assert(calculate_checksum(data, ChecksumAlgorithm::XxHash64) ==
+           xxhash64(data.data(), data.size()));
+
+    for (ChecksumAlgorithm algorithm : {ChecksumAlgorithm::Adler32,
+                                        ChecksumAlgorithm::Crc32c,
+                                        ChecksumAlgorithm::XxHash64}) {
+        ChecksumAlgorithm parsed = ChecksumAlgorithm::Adler32;
+        assert(parse_checksum_algorithm(checksum_algorithm_name(algorithm), parsed));
+        assert(parsed == algorithm);
+    }
+    ChecksumAlgorithm unused;
+    assert(!parse_checksum_algorithm("md5", unused));
+
+    // Decoded values outside the enum are rejected, not cast
+    assert(checksum_algorithm_from_value(2) == ChecksumAlgorithm::XxHash64);
+    for (uint64_t value : {uint64_t(3), uint64_t(0xFF), uint64_t(0x100)}) {
+        assert(!is_checksum_algorithm(value));
+        bool threw = false;
+        try {
+            checksum_algorithm_from_value(value);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    FileBlock block;
+    block.data = data;
+    block.checksum_algorithm = static_cast<ChecksumAlgorithm>(7);
+    assert(!block.validate_checksum());
+
+    std::cout << "Checksum algorithm selection test passed!" << std::endl;
+}
+
+const ChecksumAlgorithm ALL_ALGORITHMS[] = {
+    ChecksumAlgorithm::Adler32, ChecksumAlgorithm::Crc32c, ChecksumAlgorithm::XxHash64};
+
+void test_streaming_checksum() {
+    std::mt19937 rng(5);
+    std::vector<uint8_t> buffer(2 * 1024 * 1024 + 19);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    for (ChecksumAlgorithm algorithm : ALL_ALGORITHMS) {
+        uint64_t expected = calculate_checksum(buffer, algorithm);
+
+        // Random piece sizes, including empty and sub-stripe updates
+        for (int trial = 0; trial < 20; ++trial) {
+            ChecksumState state(algorithm);
+            std::uniform_int_distribution<size_t> piece(0, trial < 10 ? 70 : 100000);
+            size_t pos = 0;
+            while (pos < buffer.size()) {
+                size_t n = std::min(piece(rng), buffer.size() - pos);
+                state.update(buffer.data() + pos, n);
+                pos += n;
+            }
+            assert(state.length() == buffer.size());
+            assert(state.finalize() == expected);
+        }
+
+        // Every prefix of a short buffer, fed one byte at a time
+        ChecksumState bytewise(algorithm);
+        for (size_t size = 0; size <= 100; ++size) {
+            assert(bytewise.finalize() == calculate_checksum(buffer.data(), size, algorithm));
+            bytewise.update(buffer.data() + size, 1);
+        }
+
+        ChecksumState reused(algorithm);
+        reused.update(buffer);
+        reused.reset();
+        assert(reused.finalize() == calculate_checksum(buffer.data(), 0, algorithm));
+    }
+
+    std::cout << "Streaming checksum test passed!" << std::endl;
+}
+
+void test_checksum_combine() {
+    std::mt19937 rng(6);
+    std::vector<uint8_t> buffer(300000);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    std::vector<uint8_t> ones(100000, 0xFF);
+
+    for (size_t split : {0u, 1u, 31u, 5552u, 65536u, 299999u, 300000u}) {
+        const uint8_t* a = buffer.data();
+        const uint8_t* b = buffer.data() + split;
+        size_t length_b = buffer.size() - split;
+
+        assert(adler32_combine(adler32_update(1, a, split), adler32_update(1, b, length_b), length_b) ==
+               adler32_update(1, buffer.data(), buffer.size()));
+        assert(crc32c_combine(crc32c_update(0, a, split), crc32c_update(0, b, length_b), length_b) ==
+               crc32c_update(0, buffer.data(), buffer.size()));
+    }
+
+    // Saturated sums exercise the modular corrections
+    uint32_t adler_ones = adler32_update(1, ones.data(), ones.size());
+    std::vector<uint8_t> twice(ones);
+    twice.insert(twice.end(), ones.begin(), ones.end());
+    assert(adler32_combine(adler_ones, adler_ones, ones.size()) ==
+           adler32_update(1, twice.data(), twice.size()));
+
+    // Chained states
+    ChecksumState total(ChecksumAlgorithm::Crc32c);
+    for (size_t pos = 0; pos < buffer.size(); pos += 70001) {
+        ChecksumState piece(ChecksumAlgorithm::Crc32c);
+        piece.update(buffer.data() + pos, std::min<size_t>(70001, buffer.size() - pos));
+        total.combine(piece);
+    }
+    assert(total.finalize() == calculate_checksum(buffer, ChecksumAlgorithm::Crc32c));
+
+    bool threw = false;
+    try {
+        ChecksumState hashed(ChecksumAlgorithm::XxHash64);
+        hashed.combine(ChecksumState(ChecksumAlgorithm::XxHash64));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        total.combine(ChecksumState(ChecksumAlgorithm::Adler32));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Checksum combine test passed!" << std::endl;
+}
+
+void test_checksum_parallel() {
+    std::mt19937 rng(8);
+    std::vector<uint8_t> buffer(5 * 1024 * 1024 + 3);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    for (ChecksumAlgorithm algorithm : ALL_ALGORITHMS) {
+        uint64_t expected = calculate_checksum(buffer, algorithm);
+        for (unsigned threads : {0u, 1u, 2u, 3u, 7u, 16u}) {
+            assert(checksum_parallel(buffer, algorithm, threads) == expected);
+        }
+    }
+    assert(checksum_parallel(nullptr, 0, ChecksumAlgorithm::Crc32c, 4) == 0);
+
+    std::cout << "Parallel checksum test passed!" << std::endl;
+}
+
+void test_varint_bounds() {
+    auto decodes = [](const std::vector<uint8_t>& bytes, uint64_t& value) {
+        try {
+            ByteReader reader(bytes);
+            value = reader.read_varint();
+            return reader.at_end();
+        } catch (const std::runtime_error&) {
+            return false;
+        }
+    };
+
+    for (uint64_t expected : {uint64_t(0), uint64_t(127), uint64_t(128), uint64_t(1) << 63, UINT64_MAX}) {
+        std::vector<uint8_t> encoded;
+        append_varint(encoded, expected);
+        uint64_t value = 0;
+        assert(decodes(encoded, value) && value == expected);
+    }
+
+    // Ten bytes whose last carries more than bit 63 would lose the excess
+    std::vector<uint8_t> overflow(9, 0xFF);
+    overflow.push_back(0x02);
+    uint64_t value = 0;
+    assert(!decodes(overflow, value));
+
+    // No varint runs past ten bytes, even with zero payload bits
+    std::vector<uint8_t> too_long(10, 0x80);
+    too_long.push_back(0x00);
+    assert(!decodes(too_long, value));
+
+    std::cout << "Varint bounds test passed!" << std::endl;
+}
+
+template<typename Func>
+double measure_gbps(const std::vector<uint8_t>& data, Func&& checksum) {
+    // Repeat until ~64 MiB have been processed so small sizes are measurable
+    size_t repetitions = std::max<size_t>(1, (64u << 20) / std::max<size_t>(1, data.size()));
+    volatile uint64_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repetitions; ++i) {
+        sink = checksum(data.data(), data.size());
+    }
+    auto end = std::chrono::steady_clock::now();
+    (void)sink;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(data.size()) * repetitions / seconds / 1e9;
+}
+
+void benchmark_adler32_throughput() {
+    std::mt19937 rng(7);
+
+    std::cout << std::left
+              << std::setw(12) << "Size (B)"
+              << std::setw(16) << "Reference GB/s"
+              << std::setw(16) << "Scalar GB/s"
+              << std::setw(16) << "Dispatch GB/s"
+              << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    for (size_t size : {64u, 1024u, 4096u, 65536u, 1048576u, 16777216u}) {
+        std::vector<uint8_t> data(size);
+        for (auto& byte : data) {
+            byte = static_cast<uint8_t>(rng());
+        }
+
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(12) << size
+                  << std::setw(16) << measure_gbps(data, reference_adler32)
+                  << std::setw(16) << measure_gbps(data, [](const uint8_t* p, size_t n) {
+                         return adler32_update_scalar(1, p, n); })
+                  << std::setw(16) << measure_gbps(data, [](const uint8_t* p, size_t n) {
+                         return adler32_update(1, p, n); })
+                  << std::endl;
+    }
+}
+
+void benchmark_checksum_algorithms() {
+    std::mt19937 rng(9);
+
+    std::cout << std::left
+              << std::setw(12) << "Size (B)"
+              << std::setw(16) << "Adler-32 GB/s"
+              << std::setw(16) << "CRC-32C GB/s"
+              << std::setw(16) << "Table CRC GB/s"
+              << std::setw(16) << "xxHash64 GB/s"
+              << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+
+    for (size_t size : {64u, 1024u, 4096u, 65536u, 1048576u, 16777216u}) {
+        std::vector<uint8_t> data(size);
+        for (auto& byte : data) {
+            byte = static_cast<uint8_t>(rng());
+        }
+
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(12) << size
+                  << std::setw(16) << measure_gbps(data, [](const uint8_t* p, size_t n) {
+                         return calculate_checksum(p, n, ChecksumAlgorithm::Adler32); })
+                  << std::setw(16) << measure_gbps(data, [](const uint8_t* p, size_t n) {
+                         return calculate_checksum(p, n, ChecksumAlgorithm::Crc32c); })
+                  << std::setw(16) << measure_gbps(data, [](const uint8_t* p, size_t n) {
+                         return crc32c_update_portable(0, p, n); })
+                  << std::setw(16) << measure_gbps(data, [](const uint8_t* p, size_t n) {
+                         return calculate_checksum(p, n, ChecksumAlgorithm::XxHash64); })
+                  << std::endl;
+    }
+}
+
+void benchmark_parallel_scaling() {
+    std::mt19937 rng(10);
+    std::vector<uint8_t> data(64 * 1024 * 1024);
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Parallel checksum of " << (data.size() >> 20) << " MiB ("
+              << max_threads << " hardware threads)" << std::endl;
+    std::cout << std::left
+              << std::setw(12) << "Threads"
+              << std::setw(16) << "Adler-32 GB/s"
+              << std::setw(16) << "CRC-32C GB/s"
+              << std::endl;
+    std::cout << std::string(44, '-') << std::endl;
+
+    for (unsigned threads = 1; threads <= max_threads * 2; threads *= 2) {
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(12) << threads
+                  << std::setw(16) << measure_gbps(data, [threads](const uint8_t* p, size_t n) {
+                         return checksum_parallel(p, n, ChecksumAlgorithm::Adler32, threads); })
+                  << std::setw(16) << measure_gbps(data, [threads](const uint8_t* p, size_t n) {
+                         return checksum_parallel(p, n, ChecksumAlgorithm::Crc32c, threads); })
+                  << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "Running utilities tests..." << std::endl;
+
+    test_adler32_matches_reference();
+    test_crc32c_known_values();
+    test_every_implementation();
+    test_xxhash64_known_values();
+    test_algorithm_selection();
+    test_streaming_checksum();
+    test_checksum_combine();
+    test_checksum_parallel();
+    test_varint_bounds();
+    benchmark_adler32_throughput();
+    benchmark_checksum_algorithms();
+    benchmark_parallel_scaling();
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <iostream>
 #include <cassert>
+#include <stdexcept>
+#include <string>
 #include "formats/xml/xml_serializer.h"
 #include "common/test_data_generator.h"
 
@@ -66,11 +68,92 @@ void test_block_serialization_deserialization() {
     std::cout << "Block serialization/deserialization test passed!" << std::endl;
 }
 
+namespace {
+    std::string as_string(const std::vector<uint8_t>& data) {
+        return std::string(data.begin(), data.end());
+    }
+
+    std::vector<uint8_t> as_bytes(const std::string& xml) {
+        return std::vector<uint8_t>(xml.begin(), xml.end());
+    }
+
+    template<typename Decode>
+    bool throws_runtime_error(Decode&& decode) {
+        try {
+            decode();
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+}
+
+void test_verified_block_decode() {
+    XmlSerializer serializer;
+    TestDataGenerator generator(7);
+
+    // Payloads spanning several 8 KiB checksum strips, with and without a partial last strip
+    for (size_t size : {size_t(100000), size_t(3 * 8 * 1024 + 1)}) {
+        for (ChecksumAlgorithm algorithm : {ChecksumAlgorithm::Adler32, ChecksumAlgorithm::Crc32c,
+                                            ChecksumAlgorithm::XxHash64}) {
+            FileBlock block = generator.generate_block(size, 0, algorithm);
+            assert(serializer.deserialize_block_verified(serializer.serialize_block(block)) == block);
+        }
+    }
+
+    // A stored checksum that does not match: the plain decoder accepts it, the verified one does not
+    FileBlock block = generator.generate_block(20000, 0, ChecksumAlgorithm::Crc32c);
+    FileBlock wrong = block;
+    wrong.checksum ^= 1;
+    std::vector<uint8_t> serialized = serializer.serialize_block(wrong);
+    assert(serializer.deserialize_block(serialized) == wrong);
+    assert(throws_runtime_error([&] { serializer.deserialize_block_verified(serialized); }));
+
+    // A corrupted payload character past the first strip
+    std::string xml = as_string(serializer.serialize_block(block));
+    size_t payload = xml.find("<data>") + 6 + 12000;
+    xml[payload] = xml[payload] == 'A' ? 'B' : 'A';
+    assert(throws_runtime_error([&] { serializer.deserialize_block_verified(as_bytes(xml)); }));
+
+    std::cout << "Verified block decode test passed!" << std::endl;
+}
+
+void test_missing_checksum_algorithm() {
+    XmlSerializer serializer;
+    TestDataGenerator generator(8);
+
+    // Documents written before algorithms were selectable have no element and are Adler-32
+    auto without_algorithm = [&](const FileBlock& block) {
+        std::string xml = as_string(serializer.serialize_block(block));
+        size_t start = xml.find("<checksum_algorithm>");
+        const std::string end_tag = "</checksum_algorithm>";
+        size_t end = xml.find(end_tag, start);
+        assert(start != std::string::npos && end != std::string::npos);
+        xml.erase(start, end + end_tag.size() - start);
+        return as_bytes(xml);
+    };
+
+    FileBlock adler = generator.generate_block(10000, 0, ChecksumAlgorithm::Adler32);
+    std::vector<uint8_t> legacy = without_algorithm(adler);
+    assert(serializer.deserialize_block(legacy) == adler);
+    assert(serializer.deserialize_block_verified(legacy) == adler);
+
+    // A CRC-32C checksum read back as Adler-32 no longer verifies
+    FileBlock crc = generator.generate_block(10000, 0, ChecksumAlgorithm::Crc32c);
+    legacy = without_algorithm(crc);
+    assert(serializer.deserialize_block(legacy).checksum_algorithm == ChecksumAlgorithm::Adler32);
+    assert(throws_runtime_error([&] { serializer.deserialize_block_verified(legacy); }));
+
+    std::cout << "Missing checksum algorithm test passed!" << std::endl;
+}
+
 int main() {
     std::cout << "Running XML serializer tests..." << std::endl;
     
     test_metadata_serialization_deserialization();
     test_block_serialization_deserialization();
+    test_verified_block_decode();
+    test_missing_checksum_algorithm();
     
     std::cout << "All tests passed!" << std::endl;
     return 0;